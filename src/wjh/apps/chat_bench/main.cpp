@@ -0,0 +1,735 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+//
+// Microbenchmarks for the client hot paths.
+//
+//   chat_bench [--filter TEXT] [--min-time S] [--json] [--perf]
+//
+// Each benchmark is run in batches of at least 10ms until --min-time
+// (default 0.5s) has passed, and the median batch is reported.  With
+// --json, each result is one JSON object per line, so runs from two
+// commits can be diffed or compared with jq.
+//
+// Tool benchmarks (and client/turn) run a whole turn through
+// OpenRouterClient with canned responses in place of the network;
+// client/turn/text/0 is the cost of that harness on its own.
+//
+// Heap allocations and bytes allocated are counted for one extra run
+// of each benchmark, after timing.  With --perf, one more batch is run
+// under Linux perf counters (CPU time, cycles, instructions, cache and
+// branch misses), reported per op for the whole op and for each turn
+// phase the client went through.
+// ----------------------------------------------------------------------
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/json_convert.hpp"
+#include "wjh/chat/client/HttpClient.hpp"
+#include "wjh/chat/client/OpenRouterClient.hpp"
+#include "wjh/chat/client/PerfCounters.hpp"
+#include "wjh/chat/client/RequestPrefix.hpp"
+#include "wjh/chat/client/Transport.hpp"
+#include "wjh/chat/conversation/Conversation.hpp"
+#include "wjh/chat/conversation/Message.hpp"
+#include "wjh/chat/tools/ApprovalPolicy.hpp"
+
+#include "testing/AllocationTracker.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace wjh::chat;
+using clock_type = std::chrono::steady_clock;
+using nlohmann::json;
+
+struct BenchOptions
+{
+    std::string filter{};
+    std::chrono::duration<double> min_time{0.5};
+    bool json = false;
+    bool perf = false;
+};
+
+constexpr std::string_view usage =
+    "usage: chat_bench [--filter TEXT] [--min-time S] [--json] [--perf]\n";
+
+/**
+ * One timed operation.  The result of op is kept so the work cannot be
+ * optimized away; items is how many units (messages, calls) one op
+ * handles.
+ */
+struct Benchmark
+{
+    std::string name;
+    std::function<std::size_t()> op;
+    std::size_t items = 1;
+};
+
+struct Measurement
+{
+    std::uint64_t iterations = 0;
+    std::uint64_t batch = 0; ///< Ops per timed batch.
+    double ns_per_op = 0; ///< Median batch.
+    double min_ns_per_op = 0; ///< Fastest batch.
+    testing::AllocationCounts allocations{}; ///< One op.
+};
+
+std::size_t volatile sink = 0;
+
+Measurement
+measure(Benchmark const & bench, std::chrono::duration<double> min_time)
+{
+    using namespace std::chrono_literals;
+
+    auto batch = [&bench](std::uint64_t n) {
+        auto const start = clock_type::now();
+        for (std::uint64_t i = 0; i < n; ++i) {
+            sink = sink + bench.op();
+        }
+        return clock_type::now() - start;
+    };
+
+    // Grow the batch until it is long enough to time.
+    std::uint64_t n = 1;
+    for (auto elapsed = batch(n); elapsed < 10ms; elapsed = batch(n)) {
+        n *= 2;
+    }
+
+    std::vector<double> per_op;
+    auto total = clock_type::duration{};
+    while (total < min_time or per_op.size() < 5) {
+        auto const elapsed = batch(n);
+        total += elapsed;
+        per_op.push_back(
+            std::chrono::duration<double, std::nano>(elapsed).count()
+            / static_cast<double>(n));
+    }
+    std::ranges::sort(per_op);
+
+    testing::AllocationScope scope;
+    sink = sink + bench.op();
+    return Measurement{
+        .iterations = n * per_op.size(),
+        .batch = n,
+        .ns_per_op = per_op[per_op.size() / 2],
+        .min_ns_per_op = per_op.front(),
+        .allocations = scope.counts()};
+}
+
+/**
+ * Runs one batch of ops under perf counters.  The "op" phase covers
+ * each whole op; the client adds its own phases (build, http, parse,
+ * tool/<name>) when the op runs a turn.
+ */
+std::vector<client::PerfPhase>
+count_phases(Benchmark const & bench, std::uint64_t n)
+{
+    client::PerfCounters::reset();
+    for (std::uint64_t i = 0; i < n; ++i) {
+        auto const scope = client::PerfScope("op");
+        sink = sink + bench.op();
+    }
+    return client::PerfCounters::snapshot();
+}
+
+// Mean of an event per op, or null when it cannot be counted here.
+json
+per_op(client::PerfPhase const & phase, client::PerfEvent event, double ops)
+{
+    if (not client::PerfCounters::counted(event)) {
+        return nullptr;
+    }
+    return static_cast<double>(phase.counts[event]) / ops;
+}
+
+json
+perf_json(std::vector<client::PerfPhase> const & phases, double ops)
+{
+    using client::PerfEvent;
+
+    auto result = json::object();
+    for (auto const & phase : phases) {
+        auto entry = json{
+            {"calls_per_op", static_cast<double>(phase.calls) / ops}};
+        for (std::size_t i = 0; i < client::perf_event_count; ++i) {
+            auto const event = static_cast<PerfEvent>(i);
+            entry[std::format("{}_per_op", client::to_string(event))] =
+                per_op(phase, event, ops);
+        }
+        result[phase.name] = std::move(entry);
+    }
+    return result;
+}
+
+void
+print_perf(std::vector<client::PerfPhase> const & phases, double ops)
+{
+    using client::PerfEvent;
+
+    auto const cell = [ops](client::PerfPhase const & phase, PerfEvent event) {
+        auto const value = per_op(phase, event, ops);
+        return value.is_null()
+            ? std::string{"-"}
+            : std::format("{:.0f}", value.get<double>());
+    };
+    for (auto const & phase : phases) {
+        std::cout << std::format(
+            "  {:<30} {:>12.2f} {:>14} {:>14} {:>12} {:>10} {:>12}\n",
+            phase.name,
+            static_cast<double>(phase.calls) / ops,
+            cell(phase, PerfEvent::task_clock),
+            cell(phase, PerfEvent::cycles),
+            cell(phase, PerfEvent::instructions),
+            cell(phase, PerfEvent::cache_misses),
+            cell(phase, PerfEvent::branch_misses));
+    }
+}
+
+// Answers each POST with the next body from a script.
+class CannedTransport
+: public client::ITransport
+{
+public:
+    explicit CannedTransport(std::function<std::string(std::size_t)> next)
+    : next_(std::move(next))
+    { }
+
+private:
+    Result<client::HttpResponse> do_post(
+        client::HttpPath const &,
+        client::HttpBody const &,
+        client::HttpHeaders const &) override
+    {
+        client::HttpResponse response;
+        response.status = client::HttpStatusCode{200};
+        response.body = client::HttpBody{next_(count_++)};
+        return response;
+    }
+
+    std::function<std::string(std::size_t)> next_;
+    std::size_t count_ = 0;
+};
+
+std::string
+text_response(std::string_view text)
+{
+    return json{
+        {"id", "gen-1"},
+        {"model", "anthropic/claude-sonnet-4"},
+        {"choices",
+         {{{"index", 0},
+           {"finish_reason", "stop"},
+           {"message", {{"role", "assistant"}, {"content", text}}}}}},
+        {"usage",
+         {{"prompt_tokens", 12000},
+          {"completion_tokens", 400},
+          {"total_tokens", 12400},
+          {"prompt_tokens_details", {{"cached_tokens", 11000}}}}}}
+        .dump();
+}
+
+std::string
+tool_call_response(std::string_view name, json const & arguments)
+{
+    return json{
+        {"id", "gen-2"},
+        {"model", "anthropic/claude-sonnet-4"},
+        {"choices",
+         {{{"index", 0},
+           {"finish_reason", "tool_calls"},
+           {"message",
+            {{"role", "assistant"},
+             {"content", nullptr},
+             {"tool_calls",
+              {{{"id", "call_1"},
+                {"type", "function"},
+                {"function",
+                 {{"name", name}, {"arguments", arguments.dump()}}}}}}}}}}},
+        {"usage",
+         {{"prompt_tokens", 12000},
+          {"completion_tokens", 60},
+          {"total_tokens", 12060}}}}
+        .dump();
+}
+
+// About 2KB of prose, the size of a typical reply.
+std::string
+reply_text()
+{
+    std::string text;
+    for (int i = 0; text.size() < 2048; ++i) {
+        text += std::format(
+            "Step {}: the parser reads the header, then each record, "
+            "and reports the first error with its line number.\n",
+            i);
+    }
+    return text;
+}
+
+// One turn of a coding session: a question, a read_file call, its
+// result (about 4KB), and an answer.
+std::vector<conversation::Message>
+history(std::size_t messages)
+{
+    std::string listing;
+    for (int line = 1; listing.size() < 4096; ++line) {
+        listing += std::format(
+            "{:>6}\t    auto const value = compute(input[{}]);\n",
+            line,
+            line);
+    }
+
+    std::vector<conversation::Message> out;
+    for (std::size_t turn = 0; out.size() < messages; ++turn) {
+        auto const id = conversation::ToolCallId{std::format("call_{}", turn)};
+        out.push_back(conversation::Message::user(
+            UserInput{std::format("Why does test {} fail?", turn)}));
+        out.push_back(conversation::Message::tool_calls(
+            {conversation::ToolCall{
+                .id = id,
+                .name = "read_file",
+                .arguments = json{
+                    {"file_path", std::format("src/module_{}.cpp", turn)},
+                    {"offset", 1},
+                    {"limit", 200}}.dump()}},
+            conversation::MessageText{""}));
+        out.push_back(conversation::Message::tool_result(
+            id,
+            conversation::MessageText{listing}));
+        out.push_back(conversation::Message::assistant(
+            AssistantResponse{reply_text()}));
+    }
+    while (out.size() > messages) {
+        out.pop_back();
+    }
+    return out;
+}
+
+conversation::Conversation
+make_conversation(std::size_t messages)
+{
+    conversation::Conversation conversation;
+    conversation.set_system_prompt(
+        SystemPrompt{"You are a careful C++ engineer."});
+    for (auto & message : history(messages)) {
+        conversation.add_message(std::move(message));
+    }
+    conversation.add_message(UserInput{"And now?"});
+    return conversation;
+}
+
+std::unique_ptr<client::OpenRouterClient>
+make_client(
+    std::function<std::string(std::size_t)> script,
+    tools::ApprovalPolicy policy = {})
+{
+    return std::make_unique<client::OpenRouterClient>(
+        client::OpenRouterClientConfig{
+            .api_key = ApiKey("bench"),
+            .model = ModelId("anthropic/claude-sonnet-4"),
+            .max_tokens = MaxTokens(4096u),
+            .system_prompt = std::nullopt,
+            .temperature = std::nullopt,
+            .tool_policy = std::move(policy),
+            .diff_rereads = false},
+        std::make_unique<CannedTransport>(std::move(script)));
+}
+
+std::size_t
+run_turn(
+    client::OpenRouterClient & client,
+    conversation::Conversation const & conversation)
+{
+    auto const result = client.send_message(conversation);
+    if (not result) {
+        std::cout << "Error: " << result.error() << "\n";
+        std::exit(1);
+    }
+    return json_value(result->response).size();
+}
+
+/**
+ * Scratch files for the tool benchmarks, removed on exit.
+ */
+class Scratch
+{
+public:
+    Scratch()
+    : dir_(std::filesystem::temp_directory_path()
+           / std::format("chat_bench-{}", ::getpid()))
+    {
+        std::filesystem::create_directories(dir_);
+    }
+
+    ~Scratch()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir_, ec);
+    }
+
+    Scratch(Scratch const &) = delete;
+    Scratch & operator = (Scratch const &) = delete;
+
+    std::filesystem::path const & dir() const { return dir_; }
+
+private:
+    std::filesystem::path dir_;
+};
+
+void
+add_request_benchmarks(std::vector<Benchmark> & benches)
+{
+    for (std::size_t const size : {10u, 100u, 1000u}) {
+        auto const messages =
+            std::make_shared<std::vector<conversation::Message>>(
+                history(size));
+        benches.push_back(Benchmark{
+            .name = std::format("request/to_json/{}", size),
+            .op = [messages] {
+                auto out = json::array();
+                for (auto const & message : *messages) {
+                    out.push_back(conversation::to_json(message));
+                }
+                return out.size();
+            },
+            .items = size});
+
+        auto const body = std::make_shared<json>(json::array());
+        for (auto const & message : *messages) {
+            body->push_back(conversation::to_json(message));
+        }
+        auto const prefix = std::make_shared<client::RequestPrefix>(
+            json{{"model", "anthropic/claude-sonnet-4"}, {"max_tokens", 4096}},
+            json::array());
+        benches.push_back(Benchmark{
+            .name = std::format("request/build/{}", size),
+            .op = [prefix, body] {
+                return prefix
+                    ->build(SystemPrompt{"You are a careful C++ engineer."},
+                            false,
+                            *body)
+                    .size();
+            },
+            .items = size});
+        benches.push_back(Benchmark{
+            .name = std::format("request/dump/{}", size),
+            .op = [body] { return body->dump().size(); },
+            .items = size});
+    }
+}
+
+void
+add_response_benchmarks(std::vector<Benchmark> & benches)
+{
+    auto const text = std::make_shared<std::string>(
+        text_response(reply_text()));
+    benches.push_back(Benchmark{
+        .name = "response/parse/text",
+        .op = [text] {
+            auto const parsed = json::parse(*text);
+            return conversation::parse_message(
+                       parsed["choices"][0]["message"])
+                .calls()
+                .size();
+        }});
+
+    auto const calls = std::make_shared<std::string>(tool_call_response(
+        "edit_file",
+        json{
+            {"file_path", "src/wjh/chat/client/OpenRouterClient.cpp"},
+            {"old_string", reply_text()},
+            {"new_string", reply_text() + "// done\n"}}));
+    benches.push_back(Benchmark{
+        .name = "response/parse/tool_call",
+        .op = [calls] {
+            auto const parsed = json::parse(*calls);
+            auto const message =
+                conversation::parse_message(parsed["choices"][0]["message"]);
+            return json::parse(message.calls().front().arguments).size();
+        }});
+
+    // The whole client path for one text reply: history to JSON,
+    // request body, response parse.
+    for (std::size_t const size : {0u, 100u}) {
+        auto const chat = std::make_shared<conversation::Conversation>(
+            make_conversation(size));
+        auto const client = std::shared_ptr(
+            make_client([text](std::size_t) { return *text; }));
+        benches.push_back(Benchmark{
+            .name = std::format("client/turn/text/{}", size),
+            .op = [client, chat] { return run_turn(*client, *chat); }});
+    }
+}
+
+void
+add_conversation_benchmarks(std::vector<Benchmark> & benches)
+{
+    for (std::size_t const size : {100u, 1000u}) {
+        auto const messages =
+            std::make_shared<std::vector<conversation::Message>>(
+                history(size));
+        benches.push_back(Benchmark{
+            .name = std::format("conversation/add_message/{}", size),
+            .op = [messages] {
+                conversation::Conversation conversation;
+                for (auto const & message : *messages) {
+                    conversation.add_message(message);
+                }
+                return conversation.size();
+            },
+            .items = size});
+    }
+}
+
+void
+add_tool_benchmarks(
+    std::vector<Benchmark> & benches,
+    std::filesystem::path const & dir)
+{
+    // 100k numbered lines, paged 200 at a time from the top and from
+    // near the end.
+    constexpr int lines = 100'000;
+    auto const listing = dir / "listing.txt";
+    {
+        std::ofstream out(listing);
+        for (int i = 1; i <= lines; ++i) {
+            out << std::format("line {} of the generated listing\n", i);
+        }
+    }
+    for (auto const & [where, offset] :
+         {std::pair{"start", 1}, std::pair{"end", lines - 200}})
+    {
+        auto const call = tool_call_response(
+            "read_file",
+            json{
+                {"file_path", listing.string()},
+                {"offset", offset},
+                {"limit", 200}});
+        auto const done = text_response("Read it.");
+        auto const client = std::shared_ptr(
+            make_client([call, done](std::size_t n) {
+                return n % 2 == 0 ? call : done;
+            }));
+        auto const chat = std::make_shared<conversation::Conversation>(
+            make_conversation(0));
+        benches.push_back(Benchmark{
+            .name = std::format("tools/read_file/page/{}", where),
+            .op = [client, chat] { return run_turn(*client, *chat); }});
+    }
+
+    // An 8MB file edited in place; each turn swaps the marker back.
+    auto const large = dir / "large.txt";
+    {
+        std::ofstream out(large);
+        std::string const line(79, 'x');
+        for (int i = 0; i < 100'000; ++i) {
+            out << line << "\n";
+            if (i == 50'000) {
+                out << "MARKER_A\n";
+            }
+        }
+    }
+    auto policy = tools::ApprovalPolicy::parse("allow edit_file");
+    if (not policy) {
+        std::cout << "Error: " << policy.error() << "\n";
+        std::exit(1);
+    }
+    auto const edit = [path = large.string()](bool forward) {
+        return tool_call_response(
+            "edit_file",
+            json{
+                {"file_path", path},
+                {"old_string", forward ? "MARKER_A" : "MARKER_B"},
+                {"new_string", forward ? "MARKER_B" : "MARKER_A"}});
+    };
+    auto const forward = edit(true);
+    auto const back = edit(false);
+    auto const done = text_response("Edited.");
+    auto const client = std::shared_ptr(make_client(
+        [forward, back, done](std::size_t n) {
+            if (n % 2 == 1) {
+                return done;
+            }
+            return n % 4 == 0 ? forward : back;
+        },
+        std::move(*policy)));
+    auto const chat = std::make_shared<conversation::Conversation>(
+        make_conversation(0));
+    benches.push_back(Benchmark{
+        .name = "tools/edit_file/8MB",
+        .op = [client, chat] { return run_turn(*client, *chat); }});
+}
+
+void
+add_http_benchmarks(std::vector<Benchmark> & benches)
+{
+    auto const key = std::make_shared<std::string>(
+        "sk-or-v1-" + std::string(64, '7'));
+    benches.push_back(Benchmark{
+        .name = "http/headers",
+        .op = [key] {
+            client::HttpHeaders const headers{
+                {client::HeaderName{"Authorization"},
+                 client::HeaderValue{"Bearer " + *key}},
+                {client::HeaderName{"Content-Type"},
+                 client::HeaderValue{"application/json"}}};
+            return static_cast<std::size_t>(
+                std::distance(headers.begin(), headers.end()));
+        }});
+}
+
+Result<BenchOptions>
+parse_options(int argc, char * argv[])
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const flag = argv[i];
+        if (flag == "--json") {
+            options.json = true;
+            continue;
+        }
+        if (flag == "--perf") {
+            options.perf = true;
+            continue;
+        }
+        if (i + 1 == argc) {
+            return make_error("{} needs a value", flag);
+        }
+        std::string_view const value = argv[++i];
+        if (flag == "--filter") {
+            options.filter = value;
+        } else if (flag == "--min-time") {
+            double seconds = 0;
+            auto [ptr, ec] = std::from_chars(
+                value.data(), value.data() + value.size(), seconds);
+            if (ec != std::errc{} or ptr != value.data() + value.size()
+                or not (seconds > 0))
+            {
+                return make_error("Invalid --min-time: {}", value);
+            }
+            options.min_time = std::chrono::duration<double>(seconds);
+        } else {
+            return make_error("Unknown option {}", flag);
+        }
+    }
+    return options;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char * argv[])
+{
+    auto const options = parse_options(argc, argv);
+    if (not options) {
+        std::cerr << "Error: " << options.error() << "\n\n" << usage;
+        return 1;
+    }
+
+    if (options->perf) {
+        if (auto events = client::PerfCounters::start(); not events) {
+            std::cerr << "Error: " << events.error() << "\n";
+            return 1;
+        }
+    }
+
+    // The client echoes tool output to stderr.
+    std::ostringstream discard;
+    auto * const stderr_buf = std::cerr.rdbuf(discard.rdbuf());
+
+    Scratch const scratch;
+    std::vector<Benchmark> benches;
+    add_request_benchmarks(benches);
+    add_response_benchmarks(benches);
+    add_conversation_benchmarks(benches);
+    add_tool_benchmarks(benches, scratch.dir());
+    add_http_benchmarks(benches);
+
+    if (not options->json) {
+        std::cout << std::format(
+            "{:<32} {:>12} {:>14} {:>14} {:>12} {:>10} {:>12}\n",
+            "benchmark",
+            "iterations",
+            "ns/op",
+            "min ns/op",
+            "ns/item",
+            "allocs/op",
+            "bytes/op");
+        if (options->perf) {
+            std::cout << std::format(
+                "  {:<30} {:>12} {:>14} {:>14} {:>12} {:>10} {:>12}\n",
+                "phase",
+                "calls/op",
+                "cpu ns/op",
+                "cycles/op",
+                "instr/op",
+                "cmiss/op",
+                "brmiss/op");
+        }
+    }
+    for (auto const & bench : benches) {
+        if (bench.name.find(options->filter) == std::string::npos) {
+            continue;
+        }
+        auto const m = measure(bench, options->min_time);
+        auto const phases = options->perf
+            ? count_phases(bench, m.batch)
+            : std::vector<client::PerfPhase>{};
+        auto const ops = static_cast<double>(m.batch);
+        discard.str({});
+        auto const per_item = m.ns_per_op / static_cast<double>(bench.items);
+        if (options->json) {
+            auto result = json{
+                {"name", bench.name},
+                {"iterations", m.iterations},
+                {"items", bench.items},
+                {"ns_per_op", m.ns_per_op},
+                {"min_ns_per_op", m.min_ns_per_op},
+                {"ns_per_item", per_item},
+                {"allocs_per_op", m.allocations.allocations},
+                {"bytes_per_op", m.allocations.bytes}};
+            if (options->perf) {
+                result["perf"] = perf_json(phases, ops);
+            }
+            std::cout << result.dump() << std::endl;
+        } else {
+            std::cout << std::format(
+                "{:<32} {:>12} {:>14.0f} {:>14.0f} {:>12.1f} {:>10} {:>12}\n",
+                bench.name,
+                m.iterations,
+                m.ns_per_op,
+                m.min_ns_per_op,
+                per_item,
+                m.allocations.allocations,
+                m.allocations.bytes);
+            print_perf(phases, ops);
+            std::cout << std::flush;
+        }
+    }
+
+    std::cerr.rdbuf(stderr_buf);
+    return 0;
+}
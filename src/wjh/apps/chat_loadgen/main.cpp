@@ -0,0 +1,528 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+//
+// Drives many simulated chat sessions through OpenRouterClient and
+// reports throughput and latency percentiles.
+//
+//   chat_loadgen [--url URL] [--model ID] [--api-key KEY]
+//                [--mode closed|open] [--users N] [--rate R]
+//                [--arrivals uniform|poisson] [--max-in-flight N]
+//                [--duration S] [--turns T] [--prompt TEXT] [--json]
+//
+// Closed loop: --users sessions run back to back until --duration is
+// up, so the offered load adapts to the server.  Open loop: sessions
+// start at --rate per second whether or not earlier ones finished, up
+// to --max-in-flight at once.  Open-loop latency is measured from when
+// a session was due to start, so a stalled server cannot hide its
+// queueing delay (coordinated omission).
+//
+// Each session sends --turns user messages.  "First response" is the
+// time until the first API response of a turn arrives; "turn" is the
+// whole turn, including tool-call rounds.  Tools other than read_file
+// and read_output are denied.  Each worker keeps spilled tool results
+// in a directory of its own under the temp directory, removed when it
+// finishes.
+// ----------------------------------------------------------------------
+#include "wjh/chat/LatencyHistogram.hpp"
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/client/OpenRouterClient.hpp"
+#include "wjh/chat/client/Transport.hpp"
+#include "wjh/chat/conversation/Conversation.hpp"
+#include "wjh/chat/tools/ApprovalPolicy.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+using namespace wjh::chat;
+using clock_type = std::chrono::steady_clock;
+
+enum class Mode { closed, open };
+enum class Arrivals { uniform, poisson };
+
+struct LoadOptions
+{
+    client::Endpoint endpoint{}; ///< Parsed from url.
+    std::string url = "http://127.0.0.1:8080";
+    std::string api_key = "fake";
+    std::string model = "anthropic/claude-sonnet-4";
+    Mode mode = Mode::closed;
+    std::size_t users = 8;
+    double rate = 10.0;
+    Arrivals arrivals = Arrivals::poisson;
+    std::size_t max_in_flight = 64;
+    std::chrono::duration<double> duration{10.0};
+    std::size_t turns = 1;
+    std::string prompt = "Say hello.";
+    bool json = false;
+};
+
+constexpr std::string_view usage =
+    "usage: chat_loadgen [--url URL] [--model ID] [--api-key KEY]\n"
+    "           [--mode closed|open] [--users N] [--rate R]\n"
+    "           [--arrivals uniform|poisson] [--max-in-flight N]\n"
+    "           [--duration S] [--turns T] [--prompt TEXT] [--json]\n"
+    "\n"
+    "  --url        API base URL (default: OPENROUTER_URL or\n"
+    "               http://127.0.0.1:8080)\n"
+    "  --users      Concurrent sessions in closed-loop mode\n"
+    "  --rate       Sessions started per second in open-loop mode\n"
+    "  --duration   Seconds to generate load\n"
+    "  --turns      User messages per session\n"
+    "  --json       Print the report as JSON\n";
+
+template <typename T>
+bool
+parse_number(std::string_view text, T & value)
+{
+    auto [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} and ptr == text.data() + text.size();
+}
+
+Result<LoadOptions>
+parse_options(int argc, char * argv[])
+{
+    LoadOptions options;
+    if (auto const * url = std::getenv("OPENROUTER_URL")) {
+        options.url = url;
+    }
+    if (auto const * key = std::getenv("OPENROUTER_API_KEY")) {
+        options.api_key = key;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const flag = argv[i];
+        if (flag == "--json") {
+            options.json = true;
+            continue;
+        }
+        if (i + 1 == argc) {
+            return make_error("{} needs a value", flag);
+        }
+        std::string_view const value = argv[++i];
+
+        if (flag == "--url") {
+            options.url = value;
+        } else if (flag == "--model") {
+            options.model = value;
+        } else if (flag == "--api-key") {
+            options.api_key = value;
+        } else if (flag == "--mode") {
+            if (value == "closed") {
+                options.mode = Mode::closed;
+            } else if (value == "open") {
+                options.mode = Mode::open;
+            } else {
+                return make_error("Invalid --mode: {}", value);
+            }
+        } else if (flag == "--arrivals") {
+            if (value == "uniform") {
+                options.arrivals = Arrivals::uniform;
+            } else if (value == "poisson") {
+                options.arrivals = Arrivals::poisson;
+            } else {
+                return make_error("Invalid --arrivals: {}", value);
+            }
+        } else if (flag == "--users") {
+            if (not parse_number(value, options.users) or options.users == 0)
+            {
+                return make_error("Invalid --users: {}", value);
+            }
+        } else if (flag == "--max-in-flight") {
+            if (not parse_number(value, options.max_in_flight)
+                or options.max_in_flight == 0)
+            {
+                return make_error("Invalid --max-in-flight: {}", value);
+            }
+        } else if (flag == "--turns") {
+            if (not parse_number(value, options.turns) or options.turns == 0)
+            {
+                return make_error("Invalid --turns: {}", value);
+            }
+        } else if (flag == "--rate") {
+            if (not parse_number(value, options.rate)
+                or not (options.rate > 0))
+            {
+                return make_error("Invalid --rate: {}", value);
+            }
+        } else if (flag == "--duration") {
+            double seconds = 0;
+            if (not parse_number(value, seconds) or not (seconds > 0)) {
+                return make_error("Invalid --duration: {}", value);
+            }
+            options.duration = std::chrono::duration<double>(seconds);
+        } else if (flag == "--prompt") {
+            options.prompt = value;
+        } else {
+            return make_error("Unknown option {}", flag);
+        }
+    }
+
+    auto endpoint = client::parse_endpoint(options.url);
+    if (not endpoint) {
+        return make_error("Invalid --url: {}", endpoint.error());
+    }
+    options.endpoint = *endpoint;
+    return options;
+}
+
+/**
+ * Notes when the first response of a turn arrives.
+ */
+class TimedTransport
+: public client::ITransport
+{
+public:
+    explicit TimedTransport(std::unique_ptr<client::ITransport> inner)
+    : inner_(std::move(inner))
+    { }
+
+    void start_turn() { first_.reset(); }
+
+    std::optional<clock_type::time_point> first_response() const
+    {
+        return first_;
+    }
+
+private:
+    Result<client::HttpResponse> do_post(
+        client::HttpPath const & path,
+        client::HttpBody const & body,
+        client::HttpHeaders const & headers) override
+    {
+        auto response = inner_->post(path, body, headers);
+        if (not first_) {
+            first_ = clock_type::now();
+        }
+        return response;
+    }
+
+    std::unique_ptr<client::ITransport> inner_;
+    std::optional<clock_type::time_point> first_;
+};
+
+/**
+ * What one worker measured; merged at the end.
+ */
+struct Tally
+{
+    LatencyHistogram first_response{};
+    LatencyHistogram turn{};
+    std::uint64_t sessions = 0;
+    std::uint64_t turns = 0;
+    std::map<std::string, std::uint64_t> errors{};
+
+    void merge(Tally const & other)
+    {
+        first_response.merge(other.first_response);
+        turn.merge(other.turn);
+        sessions += other.sessions;
+        turns += other.turns;
+        for (auto const & [error, count] : other.errors) {
+            errors[error] += count;
+        }
+    }
+};
+
+std::uint64_t
+micros(clock_type::duration elapsed)
+{
+    auto const us =
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+    return us.count() < 0 ? 0 : static_cast<std::uint64_t>(us.count());
+}
+
+/**
+ * One simulated user: a client of its own and the conversation it
+ * builds up.
+ */
+class Session
+{
+public:
+    Session(
+        LoadOptions const & options,
+        tools::ApprovalPolicy policy,
+        std::size_t worker)
+    : options_(options)
+    , dir_(std::filesystem::temp_directory_path()
+           / std::format("chat_loadgen_{}_{}", getpid(), worker))
+    {
+        auto timed = std::make_unique<TimedTransport>(
+            client::make_openrouter_transport(options.endpoint));
+        timed_ = timed.get();
+        auto config = client::OpenRouterClientConfig{
+            .api_key = ApiKey(options.api_key),
+            .model = ModelId(options.model),
+            .max_tokens = MaxTokens(256u),
+            .system_prompt = std::nullopt,
+            .temperature = std::nullopt,
+            .tool_policy = std::move(policy)};
+        config.blob_dir = dir_ / "outputs";
+        config.build_log_dir = dir_ / "build_logs";
+        client_ = std::make_unique<client::OpenRouterClient>(
+            std::move(config),
+            std::move(timed));
+    }
+
+    ~Session()
+    {
+        client_.reset();
+        std::error_code ec;
+        std::filesystem::remove_all(dir_, ec);
+    }
+
+    Session(Session const &) = delete;
+    Session & operator = (Session const &) = delete;
+
+    /**
+     * Run a whole session; the first turn is timed from `due`.
+     */
+    void run(clock_type::time_point due, Tally & tally)
+    {
+        conversation::Conversation conversation;
+        for (std::size_t i = 0; i < options_.turns; ++i) {
+            auto const start = i == 0 ? due : clock_type::now();
+            timed_->start_turn();
+            conversation.add_message(UserInput{options_.prompt});
+            auto result = client_->send_message(conversation);
+            auto const end = clock_type::now();
+            if (not result) {
+                ++tally.errors[result.error()];
+                break;
+            }
+            ++tally.turns;
+            tally.turn.record(micros(end - start));
+            if (auto const first = timed_->first_response()) {
+                tally.first_response.record(micros(*first - start));
+            }
+            for (auto & message : result->tool_messages) {
+                conversation.add_message(std::move(message));
+            }
+            conversation.add_message(result->response);
+        }
+        ++tally.sessions;
+    }
+
+private:
+    LoadOptions const & options_;
+    std::filesystem::path dir_; ///< Outputs and build logs, removed last.
+    TimedTransport * timed_ = nullptr;
+    std::unique_ptr<client::OpenRouterClient> client_;
+};
+
+/**
+ * Hands out open-loop start times: evenly spaced, or with exponential
+ * gaps for Poisson arrivals.
+ */
+class Schedule
+{
+public:
+    Schedule(LoadOptions const & options, clock_type::time_point start)
+    : arrivals_(options.arrivals)
+    , gap_(1.0 / options.rate)
+    , next_(start)
+    , end_(start
+          + std::chrono::duration_cast<clock_type::duration>(
+              options.duration))
+    { }
+
+    std::optional<clock_type::time_point> next()
+    {
+        std::lock_guard lock(mutex_);
+        if (next_ >= end_) {
+            return std::nullopt;
+        }
+        auto const due = next_;
+        auto gap = gap_;
+        if (arrivals_ == Arrivals::poisson) {
+            gap = std::exponential_distribution<double>(1.0 / gap_)(rng_);
+        }
+        next_ += std::chrono::duration_cast<clock_type::duration>(
+            std::chrono::duration<double>(gap));
+        return due;
+    }
+
+private:
+    std::mutex mutex_;
+    Arrivals arrivals_;
+    double gap_;
+    clock_type::time_point next_;
+    clock_type::time_point end_;
+    std::mt19937_64 rng_{std::random_device{}()};
+};
+
+nlohmann::json
+summary(LatencyHistogram const & histogram)
+{
+    auto ms = [&histogram](double q) {
+        return static_cast<double>(histogram.percentile(q)) / 1000.0;
+    };
+    return nlohmann::json{
+        {"count", histogram.count()},
+        {"mean_ms", histogram.mean() / 1000.0},
+        {"min_ms", static_cast<double>(histogram.min()) / 1000.0},
+        {"p50_ms", ms(0.5)},
+        {"p90_ms", ms(0.9)},
+        {"p99_ms", ms(0.99)},
+        {"p999_ms", ms(0.999)},
+        {"max_ms", static_cast<double>(histogram.max()) / 1000.0}};
+}
+
+void
+print_line(std::string_view name, LatencyHistogram const & histogram)
+{
+    auto ms = [&histogram](double q) {
+        return static_cast<double>(histogram.percentile(q)) / 1000.0;
+    };
+    std::cout << std::format(
+        "{:<15} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f} ms\n",
+        name,
+        ms(0.5),
+        ms(0.9),
+        ms(0.99),
+        ms(0.999),
+        static_cast<double>(histogram.max()) / 1000.0);
+}
+
+void
+report(LoadOptions const & options, Tally const & tally, double seconds)
+{
+    std::uint64_t failures = 0;
+    for (auto const & [error, count] : tally.errors) {
+        failures += count;
+    }
+    auto const per_second = [seconds](std::uint64_t n) {
+        return static_cast<double>(n) / seconds;
+    };
+
+    if (options.json) {
+        nlohmann::json errors = nlohmann::json::object();
+        for (auto const & [error, count] : tally.errors) {
+            errors[error] = count;
+        }
+        nlohmann::json out{
+            {"mode", options.mode == Mode::closed ? "closed" : "open"},
+            {"seconds", seconds},
+            {"sessions", tally.sessions},
+            {"turns", tally.turns},
+            {"errors", failures},
+            {"turns_per_second", per_second(tally.turns)},
+            {"first_response", summary(tally.first_response)},
+            {"turn", summary(tally.turn)},
+            {"error_messages", std::move(errors)}};
+        std::cout << out.dump(2) << "\n";
+        return;
+    }
+
+    std::cout << std::format(
+        "{} sessions, {} turns, {} errors in {:.1f}s: "
+        "{:.1f} turns/s\n\n",
+        tally.sessions,
+        tally.turns,
+        failures,
+        seconds,
+        per_second(tally.turns));
+    std::cout << std::format(
+        "{:<15} {:>9} {:>9} {:>9} {:>9} {:>9}\n",
+        "",
+        "p50",
+        "p90",
+        "p99",
+        "p999",
+        "max");
+    print_line("first response", tally.first_response);
+    print_line("turn", tally.turn);
+    for (auto const & [error, count] : tally.errors) {
+        std::cout << std::format("\n{:>6} x {}", count, error);
+    }
+    if (not tally.errors.empty()) {
+        std::cout << "\n";
+    }
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char * argv[])
+{
+    auto options = parse_options(argc, argv);
+    if (not options) {
+        std::cerr << "Error: " << options.error() << "\n\n" << usage;
+        return 1;
+    }
+
+    // Nobody is there to answer an approval prompt.
+    auto policy = tools::ApprovalPolicy::parse(
+        "allow read_file; allow read_output; deny *");
+    if (not policy) {
+        std::cerr << "Error: " << policy.error() << "\n";
+        return 1;
+    }
+
+    auto const workers = options->mode == Mode::closed
+        ? options->users
+        : options->max_in_flight;
+    std::vector<Tally> tallies(workers);
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+
+    auto const start = clock_type::now();
+    auto const end = start
+        + std::chrono::duration_cast<clock_type::duration>(
+            options->duration);
+    Schedule schedule(*options, start);
+
+    for (std::size_t w = 0; w < workers; ++w) {
+        auto & tally = tallies[w];
+        threads.emplace_back([&options, &policy, &schedule, &tally, end, w] {
+            Session session(*options, *policy, w);
+            if (options->mode == Mode::closed) {
+                while (clock_type::now() < end) {
+                    session.run(clock_type::now(), tally);
+                }
+                return;
+            }
+            while (auto const due = schedule.next()) {
+                std::this_thread::sleep_until(*due);
+                session.run(*due, tally);
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    auto const seconds =
+        std::chrono::duration<double>(clock_type::now() - start).count();
+
+    Tally total;
+    for (auto const & tally : tallies) {
+        total.merge(tally);
+    }
+    report(*options, total, seconds);
+    return 0;
+}
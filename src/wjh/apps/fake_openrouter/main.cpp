@@ -0,0 +1,226 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+//
+// Loopback stand-in for the OpenRouter chat completions API, for load
+// and latency tests that should not spend tokens.
+//
+//   fake_openrouter [--host H] [--port P] [--threads N]
+//                   [--script FILE] [--latency SPEC] [--chunk-delay D]
+//                   [--faults SPEC] [--seed N] [--cert FILE --key FILE]
+//
+// Point the chat app at it with OPENROUTER_URL=http://H:P.  --port 0
+// picks a free port; the address is printed once the server listens.
+// With --cert and --key it serves HTTPS instead.
+// ----------------------------------------------------------------------
+#include "testing/FakeOpenRouter.hpp"
+
+#include <httplib.h>
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+using testing::FakeOpenRouter;
+using testing::FakeOptions;
+using testing::FakeReply;
+
+struct ServerOptions
+{
+    std::string host = "127.0.0.1";
+    int port = 8080;
+    std::size_t threads = 8;
+    std::optional<std::string> cert{};
+    std::optional<std::string> key{};
+    FakeOptions fake{};
+};
+
+constexpr std::string_view usage =
+    "usage: fake_openrouter [--host H] [--port P] [--threads N]\n"
+    "           [--script FILE] [--latency SPEC] [--chunk-delay D]\n"
+    "           [--faults SPEC] [--seed N] [--cert FILE --key FILE]\n"
+    "\n"
+    "  --latency    200ms, uniform:50ms:300ms, or normal:200ms:50ms\n"
+    "  --chunk-delay  Delay between streamed events, e.g. 20ms\n"
+    "  --faults     Injected errors, e.g. 429:0.05,503:0.01\n"
+    "  --script     JSONL replies; see FakeOpenRouter.hpp\n";
+
+template <typename T>
+bool
+parse_number(std::string_view text, T & value)
+{
+    auto [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} and ptr == text.data() + text.size();
+}
+
+wjh::chat::Result<ServerOptions>
+parse_options(int argc, char * argv[])
+{
+    using wjh::chat::make_error;
+
+    ServerOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const flag = argv[i];
+        if (i + 1 == argc) {
+            return make_error("{} needs a value", flag);
+        }
+        std::string_view const value = argv[++i];
+
+        if (flag == "--host") {
+            options.host = value;
+        } else if (flag == "--port") {
+            if (not parse_number(value, options.port) or options.port < 0) {
+                return make_error("Invalid --port: {}", value);
+            }
+        } else if (flag == "--threads") {
+            if (not parse_number(value, options.threads)
+                or options.threads == 0)
+            {
+                return make_error("Invalid --threads: {}", value);
+            }
+        } else if (flag == "--seed") {
+            if (not parse_number(value, options.fake.seed)) {
+                return make_error("Invalid --seed: {}", value);
+            }
+        } else if (flag == "--latency") {
+            auto latency = testing::parse_latency(value);
+            if (not latency) {
+                return make_error("Invalid --latency: {}", latency.error());
+            }
+            options.fake.latency = *latency;
+        } else if (flag == "--chunk-delay") {
+            auto latency = testing::parse_latency(value);
+            if (not latency or latency->kind != testing::Latency::Kind::fixed)
+            {
+                return make_error("Invalid --chunk-delay: {}", value);
+            }
+            options.fake.chunk_delay = latency->first;
+        } else if (flag == "--faults") {
+            auto faults = testing::parse_faults(value);
+            if (not faults) {
+                return make_error("Invalid --faults: {}", faults.error());
+            }
+            options.fake.faults = std::move(*faults);
+        } else if (flag == "--script") {
+            std::ifstream file{std::string(value)};
+            if (not file) {
+                return make_error("Cannot open {}", value);
+            }
+            std::string const text(
+                (std::istreambuf_iterator<char>(file)),
+                std::istreambuf_iterator<char>());
+            auto script = testing::parse_script(text);
+            if (not script) {
+                return make_error("{}: {}", value, script.error());
+            }
+            options.fake.script = std::move(*script);
+        } else if (flag == "--cert") {
+            options.cert = value;
+        } else if (flag == "--key") {
+            options.key = value;
+        } else {
+            return make_error("Unknown option {}", flag);
+        }
+    }
+    if (options.cert.has_value() != options.key.has_value()) {
+        return make_error("--cert and --key go together");
+    }
+    return options;
+}
+
+void
+send(FakeReply reply, httplib::Response & res)
+{
+    res.status = reply.status;
+    for (auto const & [name, value] : reply.headers) {
+        res.set_header(name, value);
+    }
+    if (reply.chunks.size() == 1) {
+        std::this_thread::sleep_for(reply.delay);
+        res.set_content(reply.chunks.front(), reply.content_type);
+        return;
+    }
+
+    // Stream each event as its own chunk so clients see them arrive.
+    auto const content_type = reply.content_type;
+    res.set_chunked_content_provider(
+        content_type,
+        [events = std::move(reply)](std::size_t, httplib::DataSink & sink) {
+            for (std::size_t i = 0; i < events.chunks.size(); ++i) {
+                std::this_thread::sleep_for(
+                    i == 0 ? events.delay : events.chunk_delay);
+                auto const & chunk = events.chunks[i];
+                if (not sink.write(chunk.data(), chunk.size())) {
+                    return false;
+                }
+            }
+            sink.done();
+            return true;
+        });
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char * argv[])
+{
+    auto options = parse_options(argc, argv);
+    if (not options) {
+        std::cerr << "Error: " << options.error() << "\n\n" << usage;
+        return 1;
+    }
+
+    std::unique_ptr<httplib::Server> server;
+    if (options->cert) {
+        server = std::make_unique<httplib::SSLServer>(
+            options->cert->c_str(),
+            options->key->c_str());
+    } else {
+        server = std::make_unique<httplib::Server>();
+    }
+    if (not server->is_valid()) {
+        std::cerr << "Error: cannot set up the server (certificate?)\n";
+        return 1;
+    }
+
+    FakeOpenRouter fake(std::move(options->fake));
+    auto const threads = options->threads;
+    server->new_task_queue = [threads] {
+        return new httplib::ThreadPool(threads);
+    };
+    server->Post(
+        "/api/v1/chat/completions",
+        [&fake](httplib::Request const & req, httplib::Response & res) {
+            send(fake.respond(req.body), res);
+        });
+
+    auto port = options->port;
+    if (port == 0) {
+        port = server->bind_to_any_port(options->host);
+    } else if (not server->bind_to_port(options->host, port)) {
+        port = -1;
+    }
+    if (port < 0) {
+        std::cerr << "Error: cannot listen on " << options->host << ":"
+            << options->port << "\n";
+        return 1;
+    }
+
+    std::cout << "Listening on " << (options->cert ? "https" : "http")
+        << "://" << options->host << ":" << port << std::endl;
+    server->listen_after_bind();
+    std::cout << fake.requests() << " requests served\n";
+    return 0;
+}
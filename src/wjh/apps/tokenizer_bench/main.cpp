@@ -0,0 +1,169 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+//
+// Measures BpeTokenizer throughput on large tool outputs.
+//
+//   tokenizer_bench <vocabulary.tiktoken> [file...]
+//
+// Each file is tokenized several times and the fastest run is
+// reported.  Without files, synthetic tool output is used: a build log,
+// a source listing as read_file returns it, and a JSON dump.
+// ----------------------------------------------------------------------
+#include "wjh/chat/BpeTokenizer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+using wjh::chat::BpeTokenizer;
+
+constexpr std::size_t synthetic_bytes = 8u << 20;
+constexpr int runs = 5;
+
+struct Input
+{
+    std::string name;
+    std::string text;
+};
+
+std::string
+build_log()
+{
+    std::string out;
+    for (std::size_t i = 0; out.size() < synthetic_bytes; ++i) {
+        out += std::format(
+            "[{:4}/2048] Building CXX object src/wjh/chat/CMakeFiles/"
+            "wjh_chat.dir/module_{}.cpp.o\n",
+            i % 2048,
+            i % 97);
+        if (i % 13 == 0) {
+            out += std::format(
+                "src/wjh/chat/module_{}.cpp:{}:{}: warning: implicit "
+                "conversion loses integer precision: 'std::size_t' to "
+                "'int' [-Wshorten-64-to-32]\n",
+                i % 97,
+                i % 400 + 1,
+                i % 60 + 1);
+        }
+    }
+    return out;
+}
+
+std::string
+source_listing()
+{
+    std::string out;
+    for (std::size_t i = 1; out.size() < synthetic_bytes; ++i) {
+        out += std::format(
+            "{:>6}\t    auto const value_{} = compute(input[{}], "
+            "options.threshold_{}); // step {}\n",
+            i,
+            i % 31,
+            i % 1024,
+            i % 7,
+            i);
+    }
+    return out;
+}
+
+std::string
+json_dump()
+{
+    std::string out = "[\n";
+    for (std::size_t i = 0; out.size() < synthetic_bytes; ++i) {
+        out += std::format(
+            "  {{\"id\": {}, \"name\": \"item-{}\", \"price\": {}.{:02}, "
+            "\"tags\": [\"alpha\", \"beta\"], \"active\": {}}},\n",
+            i,
+            i * 7919 % 100000,
+            i % 1000,
+            i % 100,
+            i % 3 == 0 ? "true" : "false");
+    }
+    return out + "]\n";
+}
+
+void
+report(BpeTokenizer const & tokenizer, Input const & input)
+{
+    using clock = std::chrono::steady_clock;
+
+    std::size_t tokens = 0;
+    auto best = clock::duration::max();
+    for (int run = 0; run < runs; ++run) {
+        auto const start = clock::now();
+        tokens = tokenizer.count(input.text);
+        best = std::min(best, clock::now() - start);
+    }
+
+    auto const seconds = std::chrono::duration<double>(best).count();
+    auto const bytes = static_cast<double>(input.text.size());
+    std::cout << std::format(
+        "{:<16} {:>10} bytes {:>9} tokens {:>5.2f} bytes/token "
+        "{:>8.1f} MB/s {:>8.2f} Mtokens/s\n",
+        input.name,
+        input.text.size(),
+        tokens,
+        bytes / static_cast<double>(std::max(tokens, std::size_t{1})),
+        bytes / seconds / 1e6,
+        static_cast<double>(tokens) / seconds / 1e6);
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char * argv[])
+{
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0]
+            << " <vocabulary.tiktoken> [file...]\n";
+        return 1;
+    }
+
+    auto const tokenizer = BpeTokenizer::load(argv[1]);
+    if (not tokenizer) {
+        std::cerr << "Error: " << tokenizer.error() << "\n";
+        return 1;
+    }
+
+    std::vector<Input> inputs;
+    for (int i = 2; i < argc; ++i) {
+        std::ifstream file(argv[i], std::ios::binary);
+        if (not file) {
+            std::cerr << "Error: cannot open " << argv[i] << "\n";
+            return 1;
+        }
+        inputs.push_back(Input{
+            .name = argv[i],
+            .text = std::string(
+                (std::istreambuf_iterator<char>(file)),
+                std::istreambuf_iterator<char>())});
+    }
+    if (inputs.empty()) {
+        inputs.push_back(Input{.name = "build log", .text = build_log()});
+        inputs.push_back(
+            Input{.name = "source listing", .text = source_listing()});
+        inputs.push_back(Input{.name = "json dump", .text = json_dump()});
+    }
+
+    std::cout << std::format(
+        "vocabulary: {} tokens; best of {} runs\n",
+        tokenizer->vocabulary_size(),
+        runs);
+    for (auto const & input : inputs) {
+        report(*tokenizer, input);
+    }
+    return 0;
+}
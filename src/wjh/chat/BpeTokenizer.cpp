@@ -0,0 +1,408 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/BpeTokenizer.hpp"
+
+#include "wjh/chat/tools/ContentHash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+
+namespace wjh::chat {
+
+namespace {
+
+// Pieces are merged in windows of at most this many bytes, which keeps
+// the quadratic merge loop cheap on long runs such as base64 blobs or
+// rows of '='.  Splitting can only add tokens at window edges.
+constexpr std::size_t max_piece = 128;
+
+bool
+is_letter(unsigned char c)
+{
+    return (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or c >= 0x80;
+}
+
+bool
+is_digit(unsigned char c)
+{
+    return c >= '0' and c <= '9';
+}
+
+bool
+is_newline(unsigned char c)
+{
+    return c == '\n' or c == '\r';
+}
+
+bool
+is_space(unsigned char c)
+{
+    return c == ' ' or c == '\t' or c == '\v' or c == '\f' or is_newline(c);
+}
+
+bool
+is_other(unsigned char c)
+{
+    return not is_letter(c) and not is_digit(c) and not is_space(c);
+}
+
+char
+lower(char c)
+{
+    return c >= 'A' and c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Length of an English contraction ("'s", "'ll", ...) at text[0].
+std::size_t
+contraction(std::string_view text)
+{
+    if (text.size() < 2 or text[0] != '\'') {
+        return 0;
+    }
+    auto const a = lower(text[1]);
+    if (a == 's' or a == 'd' or a == 'm' or a == 't') {
+        return 2;
+    }
+    if (text.size() < 3) {
+        return 0;
+    }
+    auto const b = lower(text[2]);
+    if ((a == 'l' and b == 'l') or (a == 'v' and b == 'e')
+        or (a == 'r' and b == 'e'))
+    {
+        return 3;
+    }
+    return 0;
+}
+
+// Length of the piece starting at text[0]; text is not empty.
+std::size_t
+next_piece(std::string_view text)
+{
+    auto const at = [text](std::size_t i) {
+        return static_cast<unsigned char>(text[i]);
+    };
+    auto const run = [text, &at](std::size_t i, auto pred) {
+        while (i < text.size() and pred(at(i))) {
+            ++i;
+        }
+        return i;
+    };
+
+    if (auto const n = contraction(text)) {
+        return n;
+    }
+
+    auto const c = at(0);
+    auto const has_next = text.size() > 1;
+    if (is_letter(c)) {
+        return run(1, is_letter);
+    }
+    if (not is_newline(c) and not is_digit(c) and has_next
+        and is_letter(at(1)))
+    {
+        return run(2, is_letter);
+    }
+    if (is_digit(c)) {
+        return std::min(run(1, is_digit), std::size_t{3});
+    }
+
+    auto const punct = c == ' ' and has_next and is_other(at(1)) ? 1u : 0u;
+    if (punct == 1 or is_other(c)) {
+        return run(run(punct, is_other), is_newline);
+    }
+
+    // Whitespace: through the last newline if the run has one,
+    // otherwise all but the space that leads the next word.
+    auto const end = run(0, is_space);
+    for (auto i = end; i > 0; --i) {
+        if (is_newline(at(i - 1))) {
+            return i;
+        }
+    }
+    return end > 1 and end < text.size() ? end - 1 : end;
+}
+
+int
+base64_value(char c)
+{
+    if (c >= 'A' and c <= 'Z') {
+        return c - 'A';
+    }
+    if (c >= 'a' and c <= 'z') {
+        return c - 'a' + 26;
+    }
+    if (c >= '0' and c <= '9') {
+        return c - '0' + 52;
+    }
+    if (c == '+') {
+        return 62;
+    }
+    if (c == '/') {
+        return 63;
+    }
+    return -1;
+}
+
+std::optional<std::string>
+decode_base64(std::string_view text)
+{
+    while (text.ends_with('=')) {
+        text.remove_suffix(1);
+    }
+    std::string out;
+    out.reserve(text.size() * 3 / 4);
+    unsigned bits = 0;
+    int count = 0;
+    for (auto const c : text) {
+        auto const v = base64_value(c);
+        if (v < 0) {
+            return std::nullopt;
+        }
+        bits = (bits << 6) | static_cast<unsigned>(v);
+        count += 6;
+        if (count >= 8) {
+            count -= 8;
+            out += static_cast<char>((bits >> count) & 0xFFu);
+        }
+    }
+    return out;
+}
+
+// The next piece to merge: at most max_piece bytes, and found without
+// scanning further ahead than that.
+std::string_view
+next_window(std::string_view text)
+{
+    auto const n = next_piece(text.substr(0, max_piece + 2));
+    return text.substr(0, std::min(n, max_piece));
+}
+
+} // anonymous namespace
+
+std::vector<std::string_view>
+pretokenize(std::string_view text)
+{
+    std::vector<std::string_view> pieces;
+    while (not text.empty()) {
+        auto const n = next_piece(text);
+        pieces.push_back(text.substr(0, n));
+        text.remove_prefix(n);
+    }
+    return pieces;
+}
+
+Result<BpeTokenizer>
+BpeTokenizer::
+load(std::filesystem::path const & path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (not file) {
+        return make_error("Cannot open vocabulary {}", path.string());
+    }
+    std::string const contents(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    auto tokenizer = parse(contents);
+    if (not tokenizer) {
+        return make_error("{}: {}", path.string(), tokenizer.error());
+    }
+    return tokenizer;
+}
+
+Result<BpeTokenizer>
+BpeTokenizer::
+parse(std::string_view vocabulary)
+{
+    auto const lines = static_cast<std::size_t>(
+        std::ranges::count(vocabulary, '\n') + 1);
+
+    BpeTokenizer tokenizer;
+    tokenizer.slots_.resize(std::bit_ceil(lines * 2));
+    tokenizer.arena_.reserve(vocabulary.size() * 3 / 4);
+
+    std::size_t line_number = 0;
+    while (not vocabulary.empty()) {
+        auto const nl = vocabulary.find('\n');
+        auto line = vocabulary.substr(0, nl);
+        vocabulary.remove_prefix(
+            nl == std::string_view::npos ? vocabulary.size() : nl + 1);
+        ++line_number;
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+        if (line.empty()) {
+            continue;
+        }
+
+        auto const space = line.rfind(' ');
+        if (space == std::string_view::npos) {
+            return make_error("line {}: expected <base64> <rank>", line_number);
+        }
+        auto const bytes = decode_base64(line.substr(0, space));
+        auto const digits = line.substr(space + 1);
+        std::uint32_t rank = 0;
+        auto [ptr, ec] = std::from_chars(
+            digits.data(), digits.data() + digits.size(), rank);
+        if (not bytes or bytes->empty() or ec != std::errc{}
+            or ptr != digits.data() + digits.size() or rank == no_rank)
+        {
+            return make_error("line {}: expected <base64> <rank>", line_number);
+        }
+        if (tokenizer.rank_of(*bytes) == no_rank) {
+            tokenizer.insert(*bytes, rank);
+        }
+    }
+
+    for (unsigned b = 0; b < 256; ++b) {
+        auto const byte = static_cast<char>(b);
+        if (tokenizer.rank_of(std::string_view(&byte, 1)) == no_rank) {
+            return make_error("vocabulary has no token for byte 0x{:02x}", b);
+        }
+    }
+    return tokenizer;
+}
+
+std::uint32_t
+BpeTokenizer::
+rank_of(std::string_view bytes) const
+{
+    auto const hash = tools::content_hash(bytes);
+    auto const mask = slots_.size() - 1;
+    for (auto i = hash & mask;; i = (i + 1) & mask) {
+        auto const & slot = slots_[i];
+        if (slot.rank == no_rank) {
+            return no_rank;
+        }
+        if (slot.hash == hash and slot.length == bytes.size()
+            and std::memcmp(
+                arena_.data() + slot.offset, bytes.data(), bytes.size()) == 0)
+        {
+            return slot.rank;
+        }
+    }
+}
+
+void
+BpeTokenizer::
+insert(std::string_view bytes, std::uint32_t rank)
+{
+    auto const hash = tools::content_hash(bytes);
+    auto const mask = slots_.size() - 1;
+    auto i = hash & mask;
+    while (slots_[i].rank != no_rank) {
+        i = (i + 1) & mask;
+    }
+    slots_[i] = Slot{
+        .hash = hash,
+        .offset = static_cast<std::uint32_t>(arena_.size()),
+        .length = static_cast<std::uint32_t>(bytes.size()),
+        .rank = rank};
+    arena_.append(bytes);
+    ++size_;
+}
+
+// Merge one piece of at most max_piece bytes, calling emit with the
+// bytes of each resulting token in order.  parts[i] is where part i
+// starts and the rank of merging it with part i + 1; the array lives
+// on the stack and shrinks in place as parts merge.
+template <typename Emit>
+void
+BpeTokenizer::
+merge_piece(std::string_view piece, Emit && emit) const
+{
+    if (piece.size() == 1 or rank_of(piece) != no_rank) {
+        emit(piece);
+        return;
+    }
+
+    struct Part
+    {
+        std::uint32_t start;
+        std::uint32_t rank;
+    };
+    std::array<Part, max_piece + 1> parts;
+    auto n = piece.size() + 1;
+    for (std::size_t i = 0; i < n; ++i) {
+        parts[i].start = static_cast<std::uint32_t>(i);
+    }
+
+    auto const pair_rank = [this, piece, &parts, &n](std::size_t i) {
+        return i + 2 < n
+            ? rank_of(piece.substr(
+                parts[i].start,
+                parts[i + 2].start - parts[i].start))
+            : no_rank;
+    };
+    for (std::size_t i = 0; i < n; ++i) {
+        parts[i].rank = pair_rank(i);
+    }
+
+    while (n > 2) {
+        std::size_t best = 0;
+        for (std::size_t i = 1; i + 2 < n; ++i) {
+            if (parts[i].rank < parts[best].rank) {
+                best = i;
+            }
+        }
+        if (parts[best].rank == no_rank) {
+            break;
+        }
+        std::copy(
+            parts.begin() + static_cast<std::ptrdiff_t>(best + 2),
+            parts.begin() + static_cast<std::ptrdiff_t>(n),
+            parts.begin() + static_cast<std::ptrdiff_t>(best + 1));
+        --n;
+        parts[best].rank = pair_rank(best);
+        if (best > 0) {
+            parts[best - 1].rank = pair_rank(best - 1);
+        }
+    }
+
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        emit(piece.substr(parts[i].start, parts[i + 1].start - parts[i].start));
+    }
+}
+
+std::vector<std::uint32_t>
+BpeTokenizer::
+encode(std::string_view text) const
+{
+    std::vector<std::uint32_t> tokens;
+    tokens.reserve(text.size() / 3);
+    auto const emit = [this, &tokens](std::string_view bytes) {
+        tokens.push_back(rank_of(bytes));
+    };
+    while (not text.empty()) {
+        auto const piece = next_window(text);
+        merge_piece(piece, emit);
+        text.remove_prefix(piece.size());
+    }
+    return tokens;
+}
+
+std::size_t
+BpeTokenizer::
+count(std::string_view text) const
+{
+    std::size_t tokens = 0;
+    auto const emit = [&tokens](std::string_view) { ++tokens; };
+    while (not text.empty()) {
+        auto const piece = next_window(text);
+        merge_piece(piece, emit);
+        text.remove_prefix(piece.size());
+    }
+    return tokens;
+}
+
+} // namespace wjh::chat
@@ -0,0 +1,107 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_3B8E5D1A7C2F4E96A0D4B7E2915C6F38
+#define WJH_CHAT_3B8E5D1A7C2F4E96A0D4B7E2915C6F38
+
+#include "wjh/chat/Result.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat {
+
+/**
+ * Split text into the pieces a BPE tokenizer merges independently.
+ *
+ * An ASCII approximation of the cl100k pre-tokenizer: English
+ * contractions, words with one leading non-letter (usually a space),
+ * runs of up to three digits, punctuation runs with one leading space,
+ * and whitespace, where a run of spaces leaves its last space to the
+ * word that follows.  Bytes above 0x7F count as letters.
+ */
+[[nodiscard]]
+std::vector<std::string_view> pretokenize(std::string_view text);
+
+/**
+ * Byte-level BPE tokenizer for estimating prompt sizes locally.
+ *
+ * The vocabulary is a tiktoken-style file: one token per line, as
+ * base64 bytes followed by its rank, where a lower rank merges first.
+ * Tokens are stored in one flat open-addressed table over a single byte
+ * arena, and each piece is merged in a small contiguous array, so
+ * counting stays in cache for typical input.
+ *
+ * Counts match the provider exactly only for the same vocabulary and
+ * mostly-ASCII text; they are meant for budgeting, not billing.
+ */
+class BpeTokenizer
+{
+public:
+    /**
+     * Load a vocabulary file.
+     */
+    [[nodiscard]]
+    static Result<BpeTokenizer> load(std::filesystem::path const & path);
+
+    /**
+     * Parse vocabulary text in the format load() reads.  Every single
+     * byte must have a token, so any input can be encoded.
+     */
+    [[nodiscard]]
+    static Result<BpeTokenizer> parse(std::string_view vocabulary);
+
+    /**
+     * Token ranks for text.
+     */
+    [[nodiscard]]
+    std::vector<std::uint32_t> encode(std::string_view text) const;
+
+    /**
+     * Number of tokens encode() would return, without building them.
+     */
+    [[nodiscard]]
+    std::size_t count(std::string_view text) const;
+
+    [[nodiscard]]
+    std::size_t vocabulary_size() const
+    {
+        return size_;
+    }
+
+private:
+    BpeTokenizer() = default;
+
+    static constexpr std::uint32_t no_rank = 0xFFFF'FFFFu;
+
+    struct Slot
+    {
+        std::uint64_t hash = 0;
+        std::uint32_t offset = 0;
+        std::uint32_t length = 0;
+        std::uint32_t rank = no_rank; ///< no_rank marks an empty slot.
+    };
+
+    [[nodiscard]]
+    std::uint32_t rank_of(std::string_view bytes) const;
+
+    void insert(std::string_view bytes, std::uint32_t rank);
+
+    template <typename Emit>
+    void merge_piece(std::string_view piece, Emit && emit) const;
+
+    std::vector<Slot> slots_;
+    std::string arena_;
+    std::size_t size_ = 0;
+};
+
+} // namespace wjh::chat
+
+#endif // WJH_CHAT_3B8E5D1A7C2F4E96A0D4B7E2915C6F38
@@ -7,16 +7,128 @@
 #include "wjh/chat/ChatLoop.hpp"
 
 #include "wjh/chat/CommandLine.hpp"
+#include "wjh/chat/OpenMetrics.hpp"
 #include "wjh/chat/json_convert.hpp"
 #include "wjh/chat/client/OpenRouterClient.hpp"
-
+#include "wjh/chat/client/PerfCounters.hpp"
+#include "wjh/chat/client/Tracer.hpp"
+#include "wjh/chat/client/WireLog.hpp"
+#include "wjh/chat/tools/BlobStore.hpp"
+#include "wjh/chat/tools/BuildTool.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <format>
+#include <fstream>
 #include <string>
+#include <string_view>
 
 #include <iostream>
 
 namespace wjh::chat {
 
+namespace {
+
+// Microseconds below a millisecond, then ms, then seconds.
+std::string
+format_duration(TurnTiming::Duration duration)
+{
+    auto const us = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            .count());
+    if (us < 1e3) {
+        return std::format("{:.0f} us", us);
+    }
+    if (us < 1e6) {
+        return std::format("{:.1f} ms", us / 1e3);
+    }
+    return std::format("{:.2f} s", us / 1e6);
+}
+
+// Histogram values of metrics named *_us are durations.
+std::string
+format_metric(std::string_view name, std::uint64_t value)
+{
+    if (name.ends_with("_us")) {
+        return format_duration(
+            std::chrono::microseconds(static_cast<std::int64_t>(value)));
+    }
+    return std::to_string(value);
+}
+
+// Per-call means, such as 1.25M cycles.
+std::string
+format_count(double value)
+{
+    if (value < 1e4) {
+        return std::format("{:.0f}", value);
+    }
+    if (value < 1e7) {
+        return std::format("{:.1f}K", value / 1e3);
+    }
+    if (value < 1e10) {
+        return std::format("{:.2f}M", value / 1e6);
+    }
+    return std::format("{:.2f}G", value / 1e9);
+}
+
+// Hardware counters per phase, as means per call.
+void
+write_perf(std::ostream & out)
+{
+    using client::PerfCounters;
+    using client::PerfEvent;
+
+    auto const phases = PerfCounters::snapshot();
+    if (phases.empty()) {
+        return;
+    }
+    out << std::format(
+        "\n  {:<24s} {:>6s} {:>9s} {:>9s} {:>9s} {:>5s} {:>10s} {:>9s}\n",
+        "Per call", "Calls", "CPU", "Cycles", "Instr", "IPC",
+        "Cache miss", "Br miss");
+    for (auto const & phase : phases) {
+        auto const calls = static_cast<double>(phase.calls);
+        auto const mean = [&phase, calls](PerfEvent event) {
+            return PerfCounters::counted(event)
+                ? format_count(static_cast<double>(phase.counts[event]) / calls)
+                : std::string{"-"};
+        };
+        auto const cycles = phase.counts[PerfEvent::cycles];
+        auto const ipc = cycles == 0
+            ? std::string{"-"}
+            : std::format(
+                  "{:.2f}",
+                  static_cast<double>(phase.counts[PerfEvent::instructions])
+                      / static_cast<double>(cycles));
+        out << std::format(
+            "  {:<24s} {:>6d} {:>9s} {:>9s} {:>9s} {:>5s} {:>10s} {:>9s}\n",
+            phase.name,
+            phase.calls,
+            format_duration(std::chrono::nanoseconds(static_cast<std::int64_t>(
+                phase.counts[PerfEvent::task_clock] / phase.calls))),
+            mean(PerfEvent::cycles),
+            mean(PerfEvent::instructions),
+            ipc,
+            mean(PerfEvent::cache_misses),
+            mean(PerfEvent::branch_misses));
+    }
+}
+
+void
+write_stats(std::filesystem::path const & path, MetricsSnapshot const & stats)
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << to_json(stats).dump(2) << "\n";
+    if (not file) {
+        std::cerr << "Warning: cannot write stats to " << path.string()
+            << "\n";
+    }
+}
+
+} // anonymous namespace
+
 // ------------------------------------------------------------------
 // ChatLoop construction / destruction
 // ------------------------------------------------------------------
@@ -29,6 +141,7 @@ ChatLoop(
     std::ostream & out)
 : config_(std::move(config))
 , client_(std::move(client))
+, compactor_(config_.compaction)
 , in_(in)
 , out_(out)
 { }
@@ -48,6 +161,43 @@ run()
         conversation_.set_system_prompt(*config_.system_prompt);
     }
 
+    if (config_.tokenizer_vocab) {
+        auto tokenizer = BpeTokenizer::load(*config_.tokenizer_vocab);
+        if (tokenizer) {
+            estimator_.set_tokenizer(
+                std::make_shared<BpeTokenizer const>(std::move(*tokenizer)));
+        } else {
+            std::cerr << "Warning: " << tokenizer.error()
+                << "; estimating tokens from bytes\n";
+        }
+    }
+
+    if (config_.trace_file) {
+        client::Tracer::start();
+    }
+    if (config_.perf_counters) {
+        auto const events = client::PerfCounters::start();
+        if (not events) {
+            std::cerr << "Warning: " << events.error()
+                << "; perf counters off\n";
+        } else if (events->size() == 1) {
+            std::cerr << "Warning: no hardware counters here;"
+                " counting CPU time only\n";
+        }
+    }
+    if (config_.wire_log) {
+        if (auto opened = client::WireLog::open(
+                *config_.wire_log, config_.wire_log_bytes);
+            not opened)
+        {
+            std::cerr << "Warning: " << opened.error() << "\n";
+        }
+    }
+    auto const exporter = config_.metrics_file
+        ? std::make_unique<MetricsFileExporter>(
+              metrics_, *config_.metrics_file, config_.metrics_interval)
+        : nullptr;
+
     do_display_welcome();
 
     while (true) {
@@ -71,6 +221,21 @@ run()
         do_process_input(UserInput{std::move(*line)});
     }
 
+    if (config_.stats_file) {
+        write_stats(*config_.stats_file, metrics_.snapshot());
+    }
+    if (config_.trace_file) {
+        // A summary may still be running; its spans belong in the file.
+        compactor_.cancel();
+        client::Tracer::stop();
+        if (auto written = client::Tracer::write(*config_.trace_file);
+            not written)
+        {
+            std::cerr << "Warning: " << written.error() << "\n";
+        }
+    }
+    client::WireLog::close();
+    client::PerfCounters::stop();
     return ExitCode::success;
 }
 
@@ -88,8 +253,11 @@ handle_builtin_command(std::string_view cmd)
     }
 
     if (cmd == "/clear") {
+        compactor_.cancel();
         conversation_.clear();
         usage_history_.clear();
+        usage_total_ = TokenUsage{};
+        timing_history_.clear();
         out_ << "Conversation cleared.\n\n";
         return CommandResult::handled;
     }
@@ -102,27 +270,27 @@ handle_builtin_command(std::string_view cmd)
 
         out_ << "Per-turn token usage:\n"
             << std::format(
-                   "  {:>4s}  {:>8s}  {:>10s}  {:>7s}\n",
-                   "Turn", "Prompt", "Completion", "Total");
+                   "  {:>4s}  {:>8s}  {:>8s}  {:>10s}  {:>7s}\n",
+                   "Turn", "Prompt", "Cached", "Completion", "Total");
 
         auto cumulative = TokenUsage{};
         for (std::size_t i = 0; i < usage_history_.size(); ++i) {
             auto const & u = usage_history_[i];
             out_ << std::format(
-                "  {:>4d}  {:>8d}  {:>10d}  {:>7d}\n",
+                "  {:>4d}  {:>8d}  {:>8d}  {:>10d}  {:>7d}\n",
                 i + 1,
                 json_value(u.prompt_tokens),
+                json_value(u.cached_tokens),
                 json_value(u.completion_tokens),
                 json_value(u.total_tokens));
-            cumulative.prompt_tokens += u.prompt_tokens;
-            cumulative.completion_tokens += u.completion_tokens;
-            cumulative.total_tokens += u.total_tokens;
+            cumulative += u;
         }
 
         out_ << std::format(
-            "\nCumulative: {} prompt + {} completion"
+            "\nCumulative: {} prompt ({} cached) + {} completion"
             " = {} total tokens\n\n",
             json_value(cumulative.prompt_tokens),
+            json_value(cumulative.cached_tokens),
             json_value(cumulative.completion_tokens),
             json_value(cumulative.total_tokens));
         return CommandResult::handled;
@@ -134,23 +302,192 @@ handle_builtin_command(std::string_view cmd)
             return CommandResult::handled;
         }
 
-        auto cumulative = TokenUsage{};
-        for (auto const & u : usage_history_) {
-            cumulative.prompt_tokens += u.prompt_tokens;
-            cumulative.completion_tokens += u.completion_tokens;
-            cumulative.total_tokens += u.total_tokens;
-        }
-
+        auto const & cumulative = usage_total_;
         out_ << std::format(
             "Token usage ({} turn{}):\n"
             "  Prompt:     {}\n"
             "  Completion: {}\n"
-            "  Total:      {}\n\n",
+            "  Total:      {}\n"
+            "  History:    ~{} tokens ({})\n",
             usage_history_.size(),
             usage_history_.size() == 1 ? "" : "s",
             json_value(cumulative.prompt_tokens),
             json_value(cumulative.completion_tokens),
-            json_value(cumulative.total_tokens));
+            json_value(cumulative.total_tokens),
+            estimator_.estimate(conversation_),
+            estimator_.has_tokenizer() ? "tokenizer" : "bytes / 4");
+        if (cumulative.cached_tokens != CachedTokens{}
+            or cumulative.cache_write_tokens != CacheWriteTokens{})
+        {
+            auto const prompt = std::uint64_t{
+                json_value(cumulative.prompt_tokens)};
+            auto const cached = std::uint64_t{
+                json_value(cumulative.cached_tokens)};
+            out_ << std::format(
+                "  Cache:      {} read ({}% of prompt), {} written\n",
+                cached,
+                prompt == 0 ? 0u : cached * 100u / prompt,
+                json_value(cumulative.cache_write_tokens));
+        }
+        if (cumulative.replayed_requests != ReplayedRequests{}) {
+            auto const replayed = json_value(cumulative.replayed_requests);
+            out_ << std::format(
+                "  Replayed:   {} request{} from the response cache"
+                " (not billed)\n",
+                replayed,
+                replayed == 1 ? "" : "s");
+        }
+        out_ << "\n";
+        return CommandResult::handled;
+    }
+
+    if (cmd == "/timing all") {
+        if (timing_history_.empty()) {
+            out_ << "No timing data recorded.\n\n";
+            return CommandResult::handled;
+        }
+
+        out_ << "Per-turn timing:\n"
+            << std::format(
+                   "  {:>4s}  {:>9s}  {:>9s}  {:>9s}  {:>9s}  {:>9s}"
+                   "  {:>9s}  {:>9s}  {:>4s}\n",
+                   "Turn", "Total", "Wait", "Download", "Build", "Parse",
+                   "Tools", "Other", "Reqs");
+
+        auto cumulative = TurnTiming{};
+        for (std::size_t i = 0; i < timing_history_.size(); ++i) {
+            auto const & t = timing_history_[i];
+            out_ << std::format(
+                "  {:>4d}  {:>9s}  {:>9s}  {:>9s}  {:>9s}  {:>9s}"
+                "  {:>9s}  {:>9s}  {:>4d}\n",
+                i + 1,
+                format_duration(t.total),
+                format_duration(t.wait),
+                format_duration(t.download),
+                format_duration(t.build),
+                format_duration(t.parse),
+                format_duration(t.tools),
+                format_duration(t.other()),
+                t.requests);
+            cumulative += t;
+        }
+
+        out_ << std::format(
+            "\nCumulative: {} over {} request{}; waiting {}, tools {}\n\n",
+            format_duration(cumulative.total),
+            cumulative.requests,
+            cumulative.requests == 1 ? "" : "s",
+            format_duration(cumulative.wait),
+            format_duration(cumulative.tools));
+        return CommandResult::handled;
+    }
+
+    if (cmd == "/timing") {
+        if (timing_history_.empty()) {
+            out_ << "No timing data recorded.\n\n";
+            return CommandResult::handled;
+        }
+
+        auto const & t = timing_history_.back();
+        out_ << std::format(
+            "Last turn: {} over {} request{}\n"
+            "  Build:      {}\n"
+            "  Wait:       {}  (connect, TLS, upload, server)\n"
+            "  Download:   {}\n"
+            "  Parse:      {}\n"
+            "  Tools:      {}\n",
+            format_duration(t.total),
+            t.requests,
+            t.requests == 1 ? "" : "s",
+            format_duration(t.build),
+            format_duration(t.wait),
+            format_duration(t.download),
+            format_duration(t.parse),
+            format_duration(t.tools));
+        for (auto const & call : t.tool_calls) {
+            out_ << std::format(
+                "    {:<12s} {}\n",
+                call.name,
+                format_duration(call.elapsed));
+        }
+        out_ << std::format(
+            "  Other:      {}\n\n",
+            format_duration(t.other()));
+        return CommandResult::handled;
+    }
+
+    if (cmd == "/stats") {
+        auto const stats = metrics_.snapshot();
+        out_ << "Session metrics:\n";
+        for (auto const & c : stats.counters) {
+            out_ << std::format(
+                "  {:<48s} {:>10d}\n",
+                series_name(c.name, c.labels),
+                c.value);
+        }
+        for (auto const & g : stats.gauges) {
+            out_ << std::format(
+                "  {:<48s} {:>10d}\n",
+                series_name(g.name, g.labels),
+                g.value);
+        }
+        out_ << std::format(
+            "\n  {:<40s} {:>6s} {:>9s} {:>9s} {:>9s} {:>9s}\n",
+            "", "Count", "p50", "p90", "p99", "Max");
+        for (auto const & h : stats.histograms) {
+            if (h.value.count() == 0) {
+                continue;
+            }
+            out_ << std::format(
+                "  {:<40s} {:>6d} {:>9s} {:>9s} {:>9s} {:>9s}\n",
+                series_name(h.name, h.labels),
+                h.value.count(),
+                format_metric(h.name, h.value.percentile(0.50)),
+                format_metric(h.name, h.value.percentile(0.90)),
+                format_metric(h.name, h.value.percentile(0.99)),
+                format_metric(h.name, h.value.max()));
+        }
+        write_perf(out_);
+        out_ << "\n";
+        return CommandResult::handled;
+    }
+
+    if (cmd == "/wirelog off") {
+        client::WireLog::set_enabled(false);
+        out_ << "Wire logging off.\n\n";
+        return CommandResult::handled;
+    }
+
+    if (cmd == "/wirelog on" or cmd.starts_with("/wirelog on ")) {
+        auto file = cmd.substr(std::string_view{"/wirelog on"}.size());
+        file.remove_prefix(file.empty() ? 0 : 1);
+        auto path = std::filesystem::path{file};
+        if (path.empty() and not client::WireLog::path()) {
+            path = config_.wire_log.value_or("chat_wire.log");
+        }
+        if (not path.empty()) {
+            auto opened =
+                client::WireLog::open(path, config_.wire_log_bytes);
+            if (not opened) {
+                out_ << "Error: " << opened.error() << "\n\n";
+                return CommandResult::handled;
+            }
+        }
+        client::WireLog::set_enabled(true);
+        out_ << "Wire logging on: " << client::WireLog::path()->string()
+            << "\n\n";
+        return CommandResult::handled;
+    }
+
+    if (cmd == "/wirelog") {
+        auto const path = client::WireLog::path();
+        if (not path) {
+            out_ << "Wire logging off.\n\n";
+        } else {
+            out_ << "Wire logging "
+                << (client::WireLog::enabled() ? "on" : "paused") << ": "
+                << path->string() << "\n\n";
+        }
         return CommandResult::handled;
     }
 
@@ -160,6 +497,10 @@ handle_builtin_command(std::string_view cmd)
             << "  /clear        Clear conversation history\n"
             << "  /usage        Show cumulative token usage\n"
             << "  /usage all    Show per-turn token usage\n"
+            << "  /timing       Show where the last turn's time went\n"
+            << "  /timing all   Show per-turn timing\n"
+            << "  /stats        Show session metrics\n"
+            << "  /wirelog      Show or switch (on [file]|off) API logging\n"
             << "  /help         Show this help\n\n";
         return CommandResult::handled;
     }
@@ -204,10 +545,23 @@ void
 ChatLoop::
 do_process_input(UserInput input)
 {
+    // A summary started after the last turn must land before the
+    // client is used again; on failure the history is left as is.
+    auto const span = client::TraceSpan("turn");
+    if (auto compacted = compactor_.finish(conversation_); not compacted) {
+        std::cerr << "Warning: " << compacted.error() << "\n";
+    }
+
     conversation_.add_message(input);
+    auto const start = std::chrono::steady_clock::now();
     auto result = client_->send_message(conversation_);
+    auto const end = std::chrono::steady_clock::now();
+    auto const elapsed = end - start;
+    client::Tracer::record("send_message", start, end);
 
     if (not result) {
+        session_metrics_.record_error(
+            result.error(), client_->failed_timing());
         do_handle_error(result.error());
         return;
     }
@@ -216,10 +570,23 @@ do_process_input(UserInput input)
 
     if (chat_response.usage) {
         usage_history_.push_back(*chat_response.usage);
+        usage_total_ += *chat_response.usage;
     }
+    chat_response.timing.total = elapsed;
+    session_metrics_.record_turn(chat_response);
+    timing_history_.push_back(std::move(chat_response.timing));
 
     do_display_response(chat_response.response);
+    if (config_.tool_retention.persist) {
+        for (auto & msg : chat_response.tool_messages) {
+            conversation_.add_message(std::move(msg));
+        }
+    }
     conversation_.add_message(chat_response.response);
+    (void)conversation_.trim_tool_results(config_.tool_retention);
+    auto const tokens = estimator_.estimate(conversation_);
+    session_metrics_.record_history(conversation_.size(), tokens);
+    (void)compactor_.start(conversation_, tokens, *client_);
 }
 
 void
@@ -274,15 +641,40 @@ run(int argc, char * argv[])
         return ExitCode::success;
     }
 
+    auto transport = client::make_transport(config.transport);
+    if (not transport) {
+        std::cerr << "Error: " << transport.error() << "\n";
+        return ExitCode::error;
+    }
+
     auto client = std::make_unique<client::OpenRouterClient>(
         client::OpenRouterClientConfig{
             .api_key = config.api_key,
             .model = config.model,
             .max_tokens = config.max_tokens,
             .system_prompt = config.system_prompt,
-            .temperature = config.temperature});
-
-    return run(config, std::move(client), std::cin, std::cout);
+            .temperature = config.temperature,
+            .tool_policy = config.tool_policy,
+            .tool_audit_log = config.tool_audit_log,
+            .tool_limits = config.tool_limits,
+            .tool_output_utf8 = config.tool_output_utf8,
+            .tool_output_compaction = config.tool_output_compaction,
+            .tool_output_spill = config.tool_output_spill,
+            .dedupe_tool_results = config.dedupe_tool_results,
+            .diff_rereads = config.diff_rereads,
+            .prompt_cache = config.prompt_cache,
+            .report_request_prefix = config.report_request_prefix,
+            .response_cache = config.response_cache},
+        std::move(*transport));
+
+    auto const code = run(config, std::move(client), std::cin, std::cout);
+
+    // The session's spilled outputs and build logs are of no use after.
+    std::error_code blob_ec;
+    std::error_code log_ec;
+    std::filesystem::remove_all(tools::default_blob_dir(), blob_ec);
+    std::filesystem::remove_all(tools::default_build_log_dir(), log_ec);
+    return code;
 }
 
 ExitCode
@@ -8,6 +8,10 @@
 #define WJH_CHAT_E1F2A3B4C5D6478890ABCDEF12345678
 
 #include "wjh/chat/Config.hpp"
+#include "wjh/chat/ContextCompactor.hpp"
+#include "wjh/chat/Metrics.hpp"
+#include "wjh/chat/SessionMetrics.hpp"
+#include "wjh/chat/TokenEstimator.hpp"
 #include "wjh/chat/TokenUsage.hpp"
 #include "wjh/chat/client/IClient.hpp"
 #include "wjh/chat/conversation/Conversation.hpp"
@@ -103,10 +107,17 @@ protected:
         return out_;
     }
 
+    [[nodiscard]]
+    MetricsRegistry & metrics()
+    {
+        return metrics_;
+    }
+
     /// @}
 
     /**
-     * Handle built-in commands (/exit, /quit, /clear, /help).
+     * Handle built-in commands (/exit, /quit, /clear, /usage, /timing,
+     * /stats, /help).
      *
      * Derived classes can call this as a fallback after checking
      * their own commands in do_handle_command().
@@ -161,7 +172,13 @@ private:
     Config config_;
     std::unique_ptr<client::IClient> client_;
     conversation::Conversation conversation_;
+    TokenEstimator estimator_;
+    ContextCompactor compactor_; ///< Destroyed before client_.
     std::vector<TokenUsage> usage_history_;
+    TokenUsage usage_total_{}; ///< Sum of usage_history_.
+    std::vector<TurnTiming> timing_history_;
+    MetricsRegistry metrics_; ///< Session-wide; /clear keeps them.
+    SessionMetrics session_metrics_{metrics_};
     std::istream & in_;
     std::ostream & out_;
 };
@@ -81,6 +81,14 @@ parse_args(std::span<char const * const> args)
             continue;
         }
 
+        if (arg == "--wire-log") {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            result.wire_log = std::filesystem::path{args[++i]};
+            continue;
+        }
+
         return make_error("Unknown argument: '{}'", arg);
     }
 
@@ -99,6 +107,7 @@ Options:
   -s, --system-prompt <text>  System prompt
   -t, --max-tokens <n>        Max response tokens (default: 4096)
   --temperature <value>       LLM temperature (0.0-2.0)
+  --wire-log <file>           Log API traffic to a ring-buffer file
   --show-config               Display resolved config and exit
   -h, --help                  Show this help message
 
@@ -108,10 +117,40 @@ Environment variables:
   MAX_TOKENS                  Max tokens override
   TEMPERATURE                 LLM temperature override
   SYSTEM_PROMPT               System prompt
+  TOOL_POLICY                 Tool approval rules (see README)
+  TOOL_AUDIT_LOG              File to append tool decisions to
+  TOOL_LIMITS                 Per-tool CPU/memory/time/output limits
+  TOOL_STRIP_CONTROL          Drop control characters from tool output
+  TOOL_COMPACT                Compaction of bash output (on, off, list)
+  TOOL_SPILL_THRESHOLD        Store tool results above this many bytes
+  TOOL_DEDUP                  Drop repeated tool results from history
+  TOOL_READ_DIFF              Answer file re-reads with a diff
+  TOOL_HISTORY                Tool results kept across turns (off, all, N)
+  COMPACT_THRESHOLD           Summarize old turns above this many tokens
+  COMPACT_KEEP_TURNS          Recent turns kept verbatim when summarizing
+  COMPACT_MODEL               Model that writes the summaries
+  TOKENIZER_VOCAB             BPE vocabulary for local token counts
+  PROMPT_CACHE                Prompt cache breakpoints (auto, on, off)
+  DEBUG_REQUEST_PREFIX        Report bytes each request shares with the last
+  RESPONSE_CACHE_DIR          Cache responses here when TEMPERATURE=0
+  RESPONSE_CACHE_MAX_BYTES    Size the response cache is trimmed to
+  OPENROUTER_URL              API server (default: https://openrouter.ai)
+  TRANSPORT_RECORD            Append every API exchange to this file
+  TRANSPORT_REPLAY            Answer requests from a recording instead
+  TRANSPORT_REPLAY_PACE       Replay speed (fast, recorded)
+  STATS_FILE                  Write session metrics here as JSON on exit
+  METRICS_FILE                Keep OpenMetrics text for Prometheus here
+  METRICS_INTERVAL            Seconds between METRICS_FILE rewrites
+  WIRE_LOG                    Log API traffic to this ring-buffer file
+  WIRE_LOG_BYTES              Size of the wire log ring (default: 64 MiB)
+  PERF_COUNTERS               Count CPU cycles, cache misses, ... per phase
+  TRACE_FILE                  Write a Chrome/Perfetto trace here on exit
 
 REPL commands:
   /exit, /quit                Exit the chat
   /clear                      Clear conversation history
+  /stats                      Show session metrics
+  /wirelog [on [file]|off]    Show or switch API traffic logging
   /help                       Show REPL commands
 )";
     return HelpText{std::format(fmt, program_name)};
@@ -10,6 +10,7 @@
 #include "wjh/chat/Result.hpp"
 #include "wjh/chat/types.hpp"
 
+#include <filesystem>
 #include <optional>
 #include <span>
 #include <string>
@@ -28,6 +29,7 @@ struct CommandLineArgs
     std::optional<SystemPrompt> system_prompt;
     std::optional<MaxTokens> max_tokens;
     std::optional<Temperature> temperature;
+    std::optional<std::filesystem::path> wire_log{};
     ShowConfig show_config;
     ShowHelp help;
 };
@@ -40,6 +42,7 @@ struct CommandLineArgs
  *   -s, --system-prompt <text> System prompt
  *   -t, --max-tokens <n>      Max response tokens
  *   --temperature <value>      LLM temperature (0.0-2.0)
+ *   --wire-log <file>          Log API traffic to a ring-buffer file
  *   --show-config              Display resolved config and exit
  *   -h, --help                 Show help
  */
@@ -9,11 +9,14 @@
 #include "wjh/chat/json_convert.hpp"
 
 #include <charconv>
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <ranges>
 #include <string>
+#include <string_view>
 
 #include <dotenv.h>
 
@@ -39,6 +42,31 @@ get_env(char const * name)
     return std::nullopt;
 }
 
+std::optional<bool>
+parse_flag(std::string_view value)
+{
+    if (value == "1" or value == "true" or value == "yes" or value == "on") {
+        return true;
+    }
+    if (value == "0" or value == "false" or value == "no" or value == "off")
+    {
+        return false;
+    }
+    return std::nullopt;
+}
+
+std::optional<std::size_t>
+parse_count(std::string_view value)
+{
+    std::size_t val = 0;
+    auto [ptr, ec] =
+        std::from_chars(value.data(), value.data() + value.size(), val);
+    if (ec != std::errc{} or ptr != value.data() + value.size()) {
+        return std::nullopt;
+    }
+    return val;
+}
+
 } // anonymous namespace
 
 void
@@ -121,6 +149,198 @@ resolve_config(CommandLineArgs const & args)
         config.temperature = Temperature{val};
     }
 
+    // Tool approval rules and audit log: env > built-in defaults
+    if (auto env = get_env("TOOL_POLICY")) {
+        auto policy = tools::ApprovalPolicy::parse(*env);
+        if (not policy) {
+            return make_error("Invalid TOOL_POLICY: {}", policy.error());
+        }
+        config.tool_policy = std::move(*policy);
+    }
+    if (auto env = get_env("TOOL_AUDIT_LOG")) {
+        config.tool_audit_log = std::filesystem::path{std::move(*env)};
+    }
+
+    // Per-tool resource limits: env overrides on top of defaults
+    if (auto env = get_env("TOOL_LIMITS")) {
+        auto limits = tools::parse_tool_limits(*env, config.tool_limits);
+        if (not limits) {
+            return make_error("Invalid TOOL_LIMITS: {}", limits.error());
+        }
+        config.tool_limits = std::move(*limits);
+    }
+
+    if (auto env = get_env("TOOL_STRIP_CONTROL")) {
+        auto const flag = parse_flag(*env);
+        if (not flag) {
+            return make_error("Invalid TOOL_STRIP_CONTROL value: '{}'", *env);
+        }
+        config.tool_output_utf8.strip_control = *flag;
+    }
+
+    if (auto env = get_env("TOOL_COMPACT")) {
+        auto options = tools::parse_compact_options(*env);
+        if (not options) {
+            return make_error("Invalid TOOL_COMPACT: {}", options.error());
+        }
+        config.tool_output_compaction = *options;
+    }
+
+    if (auto env = get_env("TOOL_SPILL_THRESHOLD")) {
+        auto const bytes = parse_count(*env);
+        if (not bytes) {
+            return make_error(
+                "Invalid TOOL_SPILL_THRESHOLD value: '{}'", *env);
+        }
+        config.tool_output_spill.threshold = *bytes;
+    }
+
+    if (auto env = get_env("TOOL_DEDUP")) {
+        auto const flag = parse_flag(*env);
+        if (not flag) {
+            return make_error("Invalid TOOL_DEDUP value: '{}'", *env);
+        }
+        config.dedupe_tool_results = *flag;
+    }
+
+    if (auto env = get_env("TOOL_READ_DIFF")) {
+        auto const flag = parse_flag(*env);
+        if (not flag) {
+            return make_error("Invalid TOOL_READ_DIFF value: '{}'", *env);
+        }
+        config.diff_rereads = *flag;
+    }
+
+    if (auto env = get_env("TOOL_HISTORY")) {
+        auto retention = conversation::parse_tool_retention(*env);
+        if (not retention) {
+            return make_error("Invalid TOOL_HISTORY: {}", retention.error());
+        }
+        config.tool_retention = *retention;
+    }
+
+    if (auto env = get_env("COMPACT_THRESHOLD")) {
+        auto const tokens = parse_count(*env);
+        if (not tokens) {
+            return make_error("Invalid COMPACT_THRESHOLD value: '{}'", *env);
+        }
+        config.compaction.threshold_tokens = *tokens;
+    }
+
+    if (auto env = get_env("COMPACT_KEEP_TURNS")) {
+        auto const turns = parse_count(*env);
+        if (not turns or *turns == 0) {
+            return make_error("Invalid COMPACT_KEEP_TURNS value: '{}'", *env);
+        }
+        config.compaction.keep_turns = *turns;
+    }
+
+    if (auto env = get_env("COMPACT_MODEL")) {
+        config.compaction.model = ModelId{*env};
+    }
+
+    if (auto env = get_env("TOKENIZER_VOCAB")) {
+        config.tokenizer_vocab = std::filesystem::path{std::move(*env)};
+    }
+
+    if (auto env = get_env("PROMPT_CACHE")) {
+        auto mode = client::parse_prompt_cache_mode(*env);
+        if (not mode) {
+            return make_error("Invalid PROMPT_CACHE: {}", mode.error());
+        }
+        config.prompt_cache = *mode;
+    }
+
+    if (auto env = get_env("DEBUG_REQUEST_PREFIX")) {
+        auto const flag = parse_flag(*env);
+        if (not flag) {
+            return make_error("Invalid DEBUG_REQUEST_PREFIX value: '{}'", *env);
+        }
+        config.report_request_prefix = *flag;
+    }
+
+    if (auto env = get_env("RESPONSE_CACHE_DIR")) {
+        config.response_cache.dir = std::filesystem::path{std::move(*env)};
+    }
+
+    if (auto env = get_env("RESPONSE_CACHE_MAX_BYTES")) {
+        auto const bytes = parse_count(*env);
+        if (not bytes or *bytes == 0) {
+            return make_error(
+                "Invalid RESPONSE_CACHE_MAX_BYTES value: '{}'", *env);
+        }
+        config.response_cache.max_bytes = *bytes;
+    }
+
+    if (auto env = get_env("OPENROUTER_URL")) {
+        auto endpoint = client::parse_endpoint(*env);
+        if (not endpoint) {
+            return make_error("Invalid OPENROUTER_URL: {}", endpoint.error());
+        }
+        config.transport.endpoint = std::move(*endpoint);
+    }
+
+    if (auto env = get_env("TRANSPORT_RECORD")) {
+        config.transport.record = std::filesystem::path{std::move(*env)};
+    }
+
+    if (auto env = get_env("TRANSPORT_REPLAY")) {
+        config.transport.replay = std::filesystem::path{std::move(*env)};
+    }
+
+    if (auto env = get_env("TRANSPORT_REPLAY_PACE")) {
+        auto pace = client::parse_replay_pace(*env);
+        if (not pace) {
+            return make_error(
+                "Invalid TRANSPORT_REPLAY_PACE: {}", pace.error());
+        }
+        config.transport.replay_pace = *pace;
+    }
+
+    if (auto env = get_env("STATS_FILE")) {
+        config.stats_file = std::filesystem::path{std::move(*env)};
+    }
+
+    if (auto env = get_env("METRICS_FILE")) {
+        config.metrics_file = std::filesystem::path{std::move(*env)};
+    }
+
+    if (auto env = get_env("METRICS_INTERVAL")) {
+        auto const seconds = parse_count(*env);
+        if (not seconds or *seconds == 0) {
+            return make_error("Invalid METRICS_INTERVAL value: '{}'", *env);
+        }
+        config.metrics_interval =
+            std::chrono::seconds(static_cast<std::int64_t>(*seconds));
+    }
+
+    if (auto env = get_env("TRACE_FILE")) {
+        config.trace_file = std::filesystem::path{std::move(*env)};
+    }
+
+    // Wire log: CLI > env > off
+    if (args.wire_log) {
+        config.wire_log = *args.wire_log;
+    } else if (auto env = get_env("WIRE_LOG")) {
+        config.wire_log = std::filesystem::path{std::move(*env)};
+    }
+
+    if (auto env = get_env("WIRE_LOG_BYTES")) {
+        auto const bytes = parse_count(*env);
+        if (not bytes or *bytes == 0) {
+            return make_error("Invalid WIRE_LOG_BYTES value: '{}'", *env);
+        }
+        config.wire_log_bytes = *bytes;
+    }
+
+    if (auto env = get_env("PERF_COUNTERS")) {
+        auto const flag = parse_flag(*env);
+        if (not flag) {
+            return make_error("Invalid PERF_COUNTERS value: '{}'", *env);
+        }
+        config.perf_counters = *flag;
+    }
+
     return config;
 }
 
@@ -137,6 +357,35 @@ print_config(Config const & config, std::ostream & out)
     if (config.system_prompt) {
         out << "  System:     " << *config.system_prompt << "\n";
     }
+    for (auto const & rule : config.tool_policy.rules()) {
+        out << "  Tool rule:  " << rule.text << "\n";
+    }
+    if (config.tool_audit_log) {
+        out << "  Tool audit: " << config.tool_audit_log->string() << "\n";
+    }
+    if (config.response_cache.dir) {
+        out << "  Responses:  " << config.response_cache.dir->string()
+            << (client::is_deterministic(config.temperature)
+                    ? "\n"
+                    : " (unused: temperature is not 0)\n");
+    }
+    if (config.stats_file) {
+        out << "  Stats:      " << config.stats_file->string() << "\n";
+    }
+    if (config.metrics_file) {
+        out << "  Metrics:    " << config.metrics_file->string()
+            << " (every " << config.metrics_interval.count() << " s)\n";
+    }
+    if (config.trace_file) {
+        out << "  Trace:      " << config.trace_file->string() << "\n";
+    }
+    if (config.wire_log) {
+        out << "  Wire log:   " << config.wire_log->string() << " ("
+            << config.wire_log_bytes << " bytes)\n";
+    }
+    if (config.perf_counters) {
+        out << "  Perf:       counting each turn phase\n";
+    }
 }
 
 void
@@ -167,6 +416,25 @@ append_agents_file(
 #pragma GCC diagnostic pop
 #endif
 
+    // The file becomes the front of every request, so line endings and
+    // trailing blanks are normalized: editor noise should not invalidate
+    // a provider's prompt cache.
+    std::erase(content, '\r');
+    auto trimmed = std::string{};
+    trimmed.reserve(content.size());
+    for (auto const line : std::views::split(content, '\n')) {
+        auto text = std::string_view(line.begin(), line.end());
+        while (not text.empty() and (text.back() == ' ' or text.back() == '\t'))
+        {
+            text.remove_suffix(1);
+        }
+        trimmed.append(text).push_back('\n');
+    }
+    while (trimmed.ends_with('\n')) {
+        trimmed.pop_back();
+    }
+    content = std::move(trimmed);
+
     if (content.empty()) {
         return;
     }
@@ -8,9 +8,20 @@
 #define WJH_CHAT_C4D5E6F7A8B9401CABCDEF1234567890
 
 #include "wjh/chat/CommandLine.hpp"
+#include "wjh/chat/ContextCompactor.hpp"
+#include "wjh/chat/client/PromptCache.hpp"
+#include "wjh/chat/client/ResponseCache.hpp"
+#include "wjh/chat/client/Transport.hpp"
 #include "wjh/chat/Result.hpp"
 #include "wjh/chat/types.hpp"
+#include "wjh/chat/conversation/ToolRetention.hpp"
+#include "wjh/chat/tools/ApprovalPolicy.hpp"
+#include "wjh/chat/tools/BlobStore.hpp"
+#include "wjh/chat/tools/OutputCompactor.hpp"
+#include "wjh/chat/tools/ResourceLimits.hpp"
+#include "wjh/chat/tools/Utf8.hpp"
 
+#include <chrono>
 #include <filesystem>
 #include <optional>
 #include <ostream>
@@ -28,6 +39,29 @@ struct Config
     std::optional<SystemPrompt> system_prompt;
     std::optional<Temperature> temperature;
     ShowConfig show_config;
+    tools::ApprovalPolicy tool_policy{}; ///< From TOOL_POLICY.
+    std::optional<std::filesystem::path> tool_audit_log{};
+    tools::ToolLimits tool_limits = tools::default_tool_limits();
+    tools::Utf8Options tool_output_utf8{}; ///< TOOL_STRIP_CONTROL.
+    tools::CompactOptions tool_output_compaction{}; ///< TOOL_COMPACT.
+    tools::SpillOptions tool_output_spill{}; ///< TOOL_SPILL_THRESHOLD.
+    bool dedupe_tool_results = true; ///< TOOL_DEDUP.
+    bool diff_rereads = true; ///< TOOL_READ_DIFF.
+    conversation::ToolRetention tool_retention{}; ///< TOOL_HISTORY.
+    CompactionOptions compaction{}; ///< COMPACT_*.
+    std::optional<std::filesystem::path> tokenizer_vocab{};
+    client::PromptCacheMode prompt_cache =
+        client::PromptCacheMode::automatic; ///< PROMPT_CACHE.
+    bool report_request_prefix = false; ///< DEBUG_REQUEST_PREFIX.
+    client::ResponseCacheOptions response_cache{}; ///< RESPONSE_CACHE_*.
+    client::TransportOptions transport{}; ///< TRANSPORT_*.
+    std::optional<std::filesystem::path> stats_file{}; ///< STATS_FILE.
+    std::optional<std::filesystem::path> metrics_file{}; ///< METRICS_FILE.
+    std::chrono::seconds metrics_interval{15}; ///< METRICS_INTERVAL.
+    std::optional<std::filesystem::path> trace_file{}; ///< TRACE_FILE.
+    std::optional<std::filesystem::path> wire_log{}; ///< WIRE_LOG.
+    std::size_t wire_log_bytes = 64u << 20; ///< WIRE_LOG_BYTES.
+    bool perf_counters = false; ///< PERF_COUNTERS.
 };
 
 /**
@@ -0,0 +1,171 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/ContextCompactor.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+
+#include <format>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat {
+
+namespace {
+
+using conversation::Conversation;
+using conversation::Message;
+using conversation::Role;
+
+constexpr std::string_view summary_header =
+    "[Summary of the earlier conversation, written to save context]\n";
+
+constexpr std::string_view summarizer_prompt =
+    "You compress the history of a chat between a user and a coding "
+    "assistant that uses tools. Write a summary the assistant can "
+    "continue from without the original messages. Keep every user "
+    "request and preference, decisions made and why, file paths, names "
+    "of functions and types, commands run and what they showed, errors "
+    "still open, and unfinished work. Drop pleasantries and output that "
+    "no longer matters. Write plain text, at most about 800 words.";
+
+// Longest tool output or argument text copied into the transcript.
+constexpr std::size_t max_quoted = 2000;
+
+std::string_view
+clipped(std::string_view text)
+{
+    return text.substr(0, max_quoted);
+}
+
+// Plain-text transcript of messages [0, count) for the summarizer.
+std::string
+transcript(Conversation const & conversation, std::size_t count)
+{
+    std::string out;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const & msg = conversation.messages()[i];
+        std::string_view const text = json_value(msg.text());
+        if (msg.is_tool_result()) {
+            out += std::format(
+                "Tool result{}:\n{}\n\n",
+                text.size() > max_quoted ? " (clipped)" : "",
+                clipped(text));
+            continue;
+        }
+        if (not text.empty()) {
+            out += std::format(
+                "{}: {}\n\n",
+                msg.role() == Role::user ? "User" : "Assistant",
+                text);
+        }
+        for (auto const & call : msg.calls()) {
+            out += std::format(
+                "Assistant called {} with {}\n\n",
+                call.name,
+                clipped(call.arguments));
+        }
+    }
+    return out;
+}
+
+// Index of the first message kept verbatim: the start of the
+// keep_turns-th user turn from the end, or 0 if there are fewer.
+std::size_t
+split_point(Conversation const & conversation, std::size_t keep_turns)
+{
+    auto const & messages = conversation.messages();
+    auto split = messages.size();
+    std::size_t turns = 0;
+    while (split > 0 and turns < keep_turns) {
+        --split;
+        if (messages[split].role() == Role::user) {
+            ++turns;
+        }
+    }
+    return turns < keep_turns ? 0 : split;
+}
+
+} // anonymous namespace
+
+ContextCompactor::
+ContextCompactor(CompactionOptions options)
+: options_(std::move(options))
+{ }
+
+bool
+ContextCompactor::
+start(
+    Conversation const & conversation,
+    std::size_t tokens,
+    client::IClient & client)
+{
+    if (pending()) {
+        return true;
+    }
+    if (options_.threshold_tokens == 0 or tokens <= options_.threshold_tokens)
+    {
+        return false;
+    }
+
+    auto const split = split_point(conversation, options_.keep_turns);
+    if (split < 2) {
+        return false;
+    }
+
+    auto request = Conversation{};
+    request.set_system_prompt(SystemPrompt{std::string(summarizer_prompt)});
+    request.add_message(UserInput{transcript(conversation, split)});
+
+    covered_ = split;
+    summary_ = std::async(
+        std::launch::async,
+        [&client, request = std::move(request), model = options_.model]() {
+            return client.complete(request, model);
+        });
+    return true;
+}
+
+Result<std::size_t>
+ContextCompactor::
+finish(Conversation & conversation)
+{
+    if (not pending()) {
+        return 0u;
+    }
+
+    auto summary = summary_.get();
+    if (not summary) {
+        return make_error("Context compaction failed: {}", summary.error());
+    }
+
+    // The history only grows at the end between start() and finish(),
+    // but make sure the covered messages still end at a turn boundary.
+    auto const & messages = conversation.messages();
+    if (covered_ >= messages.size()
+        or messages[covered_].role() != Role::user)
+    {
+        return make_error("Context compaction skipped: history changed");
+    }
+
+    conversation.replace_prefix(
+        covered_,
+        Message::user(UserInput{
+            std::string(summary_header) + json_value(*summary)}));
+    return covered_;
+}
+
+void
+ContextCompactor::
+cancel()
+{
+    if (pending()) {
+        summary_.wait();
+        summary_ = {};
+    }
+}
+
+} // namespace wjh::chat
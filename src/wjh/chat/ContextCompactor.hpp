@@ -0,0 +1,89 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_6F2A9C1D8E3B4A57B0C4E92D17F5A38B
+#define WJH_CHAT_6F2A9C1D8E3B4A57B0C4E92D17F5A38B
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/types.hpp"
+#include "wjh/chat/client/IClient.hpp"
+#include "wjh/chat/conversation/Conversation.hpp"
+
+#include <cstddef>
+#include <future>
+#include <optional>
+
+namespace wjh::chat {
+
+/**
+ * When and how old turns are summarized.
+ */
+struct CompactionOptions
+{
+    /// Summarize once the estimated prompt exceeds this; 0 = never.
+    std::size_t threshold_tokens = 100'000;
+    std::size_t keep_turns = 4; ///< Recent user turns kept verbatim.
+    ModelId model = ModelId{"anthropic/claude-3.5-haiku"};
+};
+
+/**
+ * Replaces the oldest turns of a conversation with a summary written
+ * by a cheaper model.
+ *
+ * start() takes a copy of the turns to summarize and asks the model on
+ * a background thread, so the work overlaps with the user typing the
+ * next message.  finish() waits for the summary and splices it in.  The
+ * caller must call finish() (or cancel()) before using the client
+ * again, so the two requests never run at the same time.
+ */
+class ContextCompactor
+{
+public:
+    explicit ContextCompactor(CompactionOptions options);
+
+    ContextCompactor(ContextCompactor const &) = delete;
+    ContextCompactor & operator = (ContextCompactor const &) = delete;
+
+    /**
+     * Start summarizing if the conversation, estimated at `tokens`, is
+     * over the threshold and has turns older than the ones kept
+     * verbatim.
+     *
+     * @return Whether a summary is now pending.
+     */
+    bool start(
+        conversation::Conversation const & conversation,
+        std::size_t tokens,
+        client::IClient & client);
+
+    /**
+     * Wait for a pending summary and replace the turns it covers.
+     *
+     * @return Number of messages replaced; 0 if nothing was pending.
+     */
+    Result<std::size_t> finish(conversation::Conversation & conversation);
+
+    /**
+     * Drop a pending summary (e.g., after /clear), waiting for the
+     * request to end.
+     */
+    void cancel();
+
+    [[nodiscard]]
+    bool pending() const
+    {
+        return summary_.valid();
+    }
+
+private:
+    CompactionOptions options_;
+    std::future<Result<AssistantResponse>> summary_;
+    std::size_t covered_ = 0; ///< Messages the pending summary replaces.
+};
+
+} // namespace wjh::chat
+
+#endif // WJH_CHAT_6F2A9C1D8E3B4A57B0C4E92D17F5A38B
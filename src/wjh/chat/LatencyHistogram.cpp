@@ -0,0 +1,146 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <utility>
+
+namespace wjh::chat {
+
+std::size_t
+LatencyHistogram::
+bucket_of(std::uint64_t value)
+{
+    if (value < sub_count) {
+        return static_cast<std::size_t>(value);
+    }
+    auto const shift =
+        static_cast<unsigned>(std::bit_width(value)) - sub_bits;
+    return static_cast<std::size_t>(
+        sub_count + (shift - 1) * half_count
+        + ((value >> shift) - half_count));
+}
+
+std::uint64_t
+LatencyHistogram::
+bucket_top(std::size_t index)
+{
+    if (index < sub_count) {
+        return index;
+    }
+    auto const offset = index - sub_count;
+    auto const shift = static_cast<unsigned>(offset / half_count) + 1;
+    auto const sub = half_count + offset % half_count;
+    return ((sub + 1) << shift) - 1;
+}
+
+LatencyHistogram::
+LatencyHistogram()
+: buckets_(bucket_count)
+{ }
+
+LatencyHistogram
+LatencyHistogram::
+from_buckets(
+    std::vector<std::uint64_t> buckets,
+    std::uint64_t low,
+    std::uint64_t high,
+    long double total)
+{
+    auto result = LatencyHistogram{};
+    buckets.resize(bucket_count);
+    result.buckets_ = std::move(buckets);
+    for (auto const n : result.buckets_) {
+        result.count_ += n;
+    }
+    if (result.count_ != 0) {
+        result.min_ = low;
+        result.max_ = high;
+        result.sum_ = total;
+    }
+    return result;
+}
+
+void
+LatencyHistogram::
+record(std::uint64_t value)
+{
+    record(value, 1);
+}
+
+void
+LatencyHistogram::
+record(std::uint64_t value, std::uint64_t times)
+{
+    if (times == 0) {
+        return;
+    }
+    buckets_[bucket_of(value)] += times;
+    count_ += times;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    sum_ += static_cast<long double>(value) * static_cast<long double>(times);
+}
+
+void
+LatencyHistogram::
+merge(LatencyHistogram const & other)
+{
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+}
+
+void
+LatencyHistogram::
+reset()
+{
+    std::ranges::fill(buckets_, std::uint64_t{0});
+    count_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+    sum_ = 0;
+}
+
+double
+LatencyHistogram::
+mean() const
+{
+    return count_ == 0
+        ? 0.0
+        : static_cast<double>(sum_ / static_cast<long double>(count_));
+}
+
+std::uint64_t
+LatencyHistogram::
+percentile(double quantile) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+    auto const clamped = std::clamp(quantile, 0.0, 1.0);
+    auto const rank = std::max(
+        std::uint64_t{1},
+        static_cast<std::uint64_t>(
+            std::ceil(clamped * static_cast<double>(count_))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            return std::clamp(bucket_top(i), min(), max_);
+        }
+    }
+    return max_;
+}
+
+} // namespace wjh::chat
@@ -0,0 +1,134 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_C61E8A4F2D0B4397A5E3B9F17D2C8064
+#define WJH_CHAT_C61E8A4F2D0B4397A5E3B9F17D2C8064
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace wjh::chat {
+
+/**
+ * Histogram of non-negative values (typically microseconds) with
+ * bounded relative error, in the style of HdrHistogram.
+ *
+ * Values below 128 are counted exactly.  Above that, each power of two
+ * is split into 64 equal buckets, so a reported value is within 1/64
+ * (about 1.6%) of the recorded one.  The bucket array has a fixed size
+ * that covers the whole 64-bit range, so recording never allocates and
+ * histograms kept per thread can be merged.
+ */
+class LatencyHistogram
+{
+    static constexpr unsigned sub_bits = 7;
+    static constexpr std::uint64_t sub_count = std::uint64_t{1} << sub_bits;
+    static constexpr std::uint64_t half_count = sub_count / 2;
+
+public:
+    /// Buckets needed to cover every 64-bit value.
+    static constexpr std::size_t bucket_count =
+        sub_count + (64 - sub_bits) * half_count;
+
+    /**
+     * Index of the bucket that counts value.
+     */
+    [[nodiscard]]
+    static std::size_t bucket_of(std::uint64_t value);
+
+    /**
+     * Largest value counted by bucket index.
+     */
+    [[nodiscard]]
+    static std::uint64_t bucket_top(std::size_t index);
+
+    LatencyHistogram();
+
+    /**
+     * Histogram holding the given per-bucket counts (bucket_count of
+     * them), with the exact extremes and sum tracked alongside, as a
+     * concurrent recorder keeps them.
+     */
+    [[nodiscard]]
+    static LatencyHistogram from_buckets(
+        std::vector<std::uint64_t> buckets,
+        std::uint64_t low,
+        std::uint64_t high,
+        long double total);
+
+    void record(std::uint64_t value);
+
+    /**
+     * Record value `times` times at once.
+     */
+    void record(std::uint64_t value, std::uint64_t times);
+
+    /**
+     * Add the counts of another histogram.
+     */
+    void merge(LatencyHistogram const & other);
+
+    void reset();
+
+    [[nodiscard]]
+    std::uint64_t count() const
+    {
+        return count_;
+    }
+
+    /**
+     * Smallest and largest values recorded, exactly; 0 when empty.
+     */
+    [[nodiscard]]
+    std::uint64_t min() const
+    {
+        return count_ == 0 ? 0 : min_;
+    }
+
+    [[nodiscard]]
+    std::uint64_t max() const
+    {
+        return max_;
+    }
+
+    [[nodiscard]]
+    long double sum() const
+    {
+        return sum_;
+    }
+
+    [[nodiscard]]
+    double mean() const;
+
+    /**
+     * Number of values recorded in bucket index.
+     */
+    [[nodiscard]]
+    std::uint64_t bucket(std::size_t index) const
+    {
+        return buckets_[index];
+    }
+
+    /**
+     * Value at or below which `quantile` (0 to 1) of the recorded
+     * values fall: the top of the bucket holding that rank, but never
+     * more than max().  0 when empty.
+     */
+    [[nodiscard]]
+    std::uint64_t percentile(double quantile) const;
+
+private:
+    std::vector<std::uint64_t> buckets_;
+    std::uint64_t count_ = 0;
+    std::uint64_t min_ = UINT64_MAX;
+    std::uint64_t max_ = 0;
+    long double sum_ = 0;
+};
+
+} // namespace wjh::chat
+
+#endif // WJH_CHAT_C61E8A4F2D0B4397A5E3B9F17D2C8064
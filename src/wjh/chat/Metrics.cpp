@@ -0,0 +1,197 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/Metrics.hpp"
+
+#include <algorithm>
+
+namespace wjh::chat {
+
+// ------------------------------------------------------------------
+// Histogram
+// ------------------------------------------------------------------
+
+void
+Histogram::
+record(std::uint64_t value)
+{
+    buckets_[LatencyHistogram::bucket_of(value)].fetch_add(
+        1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    auto low = min_.load(std::memory_order_relaxed);
+    while (value < low
+           and not min_.compare_exchange_weak(
+               low, value, std::memory_order_relaxed))
+    { }
+    auto high = max_.load(std::memory_order_relaxed);
+    while (value > high
+           and not max_.compare_exchange_weak(
+               high, value, std::memory_order_relaxed))
+    { }
+}
+
+LatencyHistogram
+Histogram::
+snapshot() const
+{
+    auto counts = std::vector<std::uint64_t>(buckets_.size());
+    for (std::size_t i = 0; i < buckets_.size(); ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    return LatencyHistogram::from_buckets(
+        std::move(counts),
+        min_.load(std::memory_order_relaxed),
+        max_.load(std::memory_order_relaxed),
+        static_cast<long double>(sum_.load(std::memory_order_relaxed)));
+}
+
+// ------------------------------------------------------------------
+// MetricsRegistry
+// ------------------------------------------------------------------
+
+template <typename T>
+T &
+MetricsRegistry::
+find_or_add(
+    std::map<std::string, Family<T>, std::less<>> & families,
+    std::string_view name,
+    std::string_view help,
+    Labels labels)
+{
+    auto const lock = std::lock_guard{mutex_};
+    auto family = families.find(name);
+    if (family == families.end()) {
+        family = families
+            .emplace(std::string(name), Family<T>{.help = std::string(help)})
+            .first;
+    }
+    auto & metric = family->second.series[std::move(labels)];
+    if (not metric) {
+        metric = std::make_unique<T>();
+    }
+    return *metric;
+}
+
+Counter &
+MetricsRegistry::
+counter(std::string_view name, std::string_view help, Labels labels)
+{
+    return find_or_add(counters_, name, help, std::move(labels));
+}
+
+Gauge &
+MetricsRegistry::
+gauge(std::string_view name, std::string_view help, Labels labels)
+{
+    return find_or_add(gauges_, name, help, std::move(labels));
+}
+
+Histogram &
+MetricsRegistry::
+histogram(std::string_view name, std::string_view help, Labels labels)
+{
+    return find_or_add(histograms_, name, help, std::move(labels));
+}
+
+MetricsSnapshot
+MetricsRegistry::
+snapshot() const
+{
+    auto const lock = std::lock_guard{mutex_};
+    auto result = MetricsSnapshot{};
+    for (auto const & [name, family] : counters_) {
+        for (auto const & [labels, metric] : family.series) {
+            result.counters.push_back(
+                {name, family.help, labels, metric->value()});
+        }
+    }
+    for (auto const & [name, family] : gauges_) {
+        for (auto const & [labels, metric] : family.series) {
+            result.gauges.push_back(
+                {name, family.help, labels, metric->value()});
+        }
+    }
+    for (auto const & [name, family] : histograms_) {
+        for (auto const & [labels, metric] : family.series) {
+            result.histograms.push_back(
+                {name, family.help, labels, metric->snapshot()});
+        }
+    }
+    return result;
+}
+
+// ------------------------------------------------------------------
+// Free functions
+// ------------------------------------------------------------------
+
+std::string
+series_name(std::string_view name, Labels const & labels)
+{
+    auto result = std::string(name);
+    if (labels.empty()) {
+        return result;
+    }
+    result += '{';
+    for (std::size_t i = 0; i < labels.size(); ++i) {
+        if (i > 0) {
+            result += ',';
+        }
+        result += labels[i].first;
+        result += "=\"";
+        for (auto const c : labels[i].second) {
+            switch (c) {
+            case '\\':
+                result += "\\\\";
+                break;
+            case '"':
+                result += "\\\"";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            default:
+                result += c;
+            }
+        }
+        result += '"';
+    }
+    result += '}';
+    return result;
+}
+
+nlohmann::json
+to_json(MetricsSnapshot const & snapshot)
+{
+    auto counters = nlohmann::json::object();
+    for (auto const & sample : snapshot.counters) {
+        counters[series_name(sample.name, sample.labels)] = sample.value;
+    }
+    auto gauges = nlohmann::json::object();
+    for (auto const & sample : snapshot.gauges) {
+        gauges[series_name(sample.name, sample.labels)] = sample.value;
+    }
+    auto histograms = nlohmann::json::object();
+    for (auto const & sample : snapshot.histograms) {
+        auto const & h = sample.value;
+        histograms[series_name(sample.name, sample.labels)] = {
+            {"count", h.count()},
+            {"sum", static_cast<double>(h.sum())},
+            {"min", h.min()},
+            {"max", h.max()},
+            {"mean", h.mean()},
+            {"p50", h.percentile(0.50)},
+            {"p90", h.percentile(0.90)},
+            {"p99", h.percentile(0.99)},
+            {"p999", h.percentile(0.999)}};
+    }
+    return {
+        {"counters", std::move(counters)},
+        {"gauges", std::move(gauges)},
+        {"histograms", std::move(histograms)}};
+}
+
+} // namespace wjh::chat
@@ -0,0 +1,194 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_A974629BE0D84942A6078AD3CF3E93FF
+#define WJH_CHAT_A974629BE0D84942A6078AD3CF3E93FF
+
+#include "wjh/chat/LatencyHistogram.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace wjh::chat {
+
+/**
+ * Label names and values that tell apart the series of one metric,
+ * e.g. {{"tool", "read_file"}}.
+ */
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * Monotonic count of events.
+ */
+class Counter
+{
+public:
+    void add(std::uint64_t n = 1)
+    {
+        value_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    std::uint64_t value() const
+    {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::uint64_t> value_{0};
+};
+
+/**
+ * Value that goes up and down, such as the size of the history.
+ */
+class Gauge
+{
+public:
+    void set(std::int64_t value)
+    {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    void add(std::int64_t n)
+    {
+        value_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    std::int64_t value() const
+    {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::int64_t> value_{0};
+};
+
+/**
+ * Distribution of non-negative values, bucketed like LatencyHistogram.
+ *
+ * Recording is a handful of relaxed atomic operations on a fixed
+ * array, so any thread may record without locking or allocating.  A
+ * snapshot taken while others record may be off by the values in
+ * flight, but each bucket is read whole.
+ */
+class Histogram
+{
+public:
+    void record(std::uint64_t value);
+
+    [[nodiscard]]
+    LatencyHistogram snapshot() const;
+
+private:
+    std::array<std::atomic<std::uint64_t>, LatencyHistogram::bucket_count>
+        buckets_{};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> min_{UINT64_MAX};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+/**
+ * Point-in-time copy of every metric in a registry, ordered by name
+ * and then labels.
+ */
+struct MetricsSnapshot
+{
+    template <typename T>
+    struct Sample
+    {
+        std::string name;
+        std::string help;
+        Labels labels{};
+        T value{};
+    };
+
+    std::vector<Sample<std::uint64_t>> counters{};
+    std::vector<Sample<std::int64_t>> gauges{};
+    std::vector<Sample<LatencyHistogram>> histograms{};
+};
+
+/**
+ * Named counters, gauges, and histograms for one session.
+ *
+ * Looking a metric up takes a lock and may allocate, so callers on a
+ * hot path look each one up once and keep the reference, which stays
+ * valid for the life of the registry.  Asking again for the same name
+ * and labels returns the same metric; the help text of the first
+ * request is kept.  Names should follow the Prometheus conventions
+ * (snake_case, unit suffix such as _us or _bytes, _total for counters)
+ * and must not be reused across metric kinds.
+ */
+class MetricsRegistry
+{
+public:
+    Counter & counter(
+        std::string_view name,
+        std::string_view help,
+        Labels labels = {});
+
+    Gauge & gauge(
+        std::string_view name,
+        std::string_view help,
+        Labels labels = {});
+
+    Histogram & histogram(
+        std::string_view name,
+        std::string_view help,
+        Labels labels = {});
+
+    [[nodiscard]]
+    MetricsSnapshot snapshot() const;
+
+private:
+    template <typename T>
+    struct Family
+    {
+        std::string help;
+        std::map<Labels, std::unique_ptr<T>> series{};
+    };
+
+    template <typename T>
+    T & find_or_add(
+        std::map<std::string, Family<T>, std::less<>> & families,
+        std::string_view name,
+        std::string_view help,
+        Labels labels);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family<Counter>, std::less<>> counters_;
+    std::map<std::string, Family<Gauge>, std::less<>> gauges_;
+    std::map<std::string, Family<Histogram>, std::less<>> histograms_;
+};
+
+/**
+ * Name of a series as Prometheus writes it: `name{label="value",...}`,
+ * or just the name without labels.
+ */
+[[nodiscard]]
+std::string series_name(std::string_view name, Labels const & labels);
+
+/**
+ * JSON object with "counters", "gauges", and "histograms", each keyed
+ * by series_name().  Histograms report count, sum, min, max, mean,
+ * and the p50, p90, p99, and p999 percentiles.
+ */
+[[nodiscard]]
+nlohmann::json to_json(MetricsSnapshot const & snapshot);
+
+} // namespace wjh::chat
+
+#endif // WJH_CHAT_A974629BE0D84942A6078AD3CF3E93FF
@@ -0,0 +1,218 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/OpenMetrics.hpp"
+
+#include <array>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace wjh::chat {
+
+namespace {
+
+// 1, 2, 5, 10, 20, 50, ... 5e9: microseconds up to about 80 minutes.
+constexpr auto bucket_bounds = [] {
+    auto bounds = std::array<std::uint64_t, 30>{};
+    auto decade = std::uint64_t{1};
+    for (std::size_t i = 0; i < bounds.size(); i += 3) {
+        bounds[i] = decade;
+        bounds[i + 1] = 2 * decade;
+        bounds[i + 2] = 5 * decade;
+        decade *= 10;
+    }
+    return bounds;
+}();
+
+std::string
+escape_help(std::string_view help)
+{
+    auto result = std::string{};
+    for (auto const c : help) {
+        if (c == '\\') {
+            result += "\\\\";
+        } else if (c == '\n') {
+            result += "\\n";
+        } else {
+            result += c;
+        }
+    }
+    return result;
+}
+
+void
+write_family(
+    std::string & out,
+    std::string_view family,
+    std::string_view type,
+    std::string_view help)
+{
+    out += std::format(
+        "# TYPE {} {}\n# HELP {} {}\n",
+        family,
+        type,
+        family,
+        escape_help(help));
+}
+
+std::string_view
+counter_family(std::string_view name)
+{
+    constexpr auto suffix = std::string_view{"_total"};
+    if (name.ends_with(suffix)) {
+        name.remove_suffix(suffix.size());
+    }
+    return name;
+}
+
+Labels
+with_bound(Labels labels, std::string bound)
+{
+    labels.emplace_back("le", std::move(bound));
+    return labels;
+}
+
+void
+write_histogram(
+    std::string & out,
+    std::string_view name,
+    Labels const & labels,
+    LatencyHistogram const & h)
+{
+    auto const bucket = std::string(name) + "_bucket";
+    auto cumulative = std::uint64_t{0};
+    auto index = std::size_t{0};
+    for (auto const bound : bucket_bounds) {
+        while (index < LatencyHistogram::bucket_count
+               and LatencyHistogram::bucket_top(index) <= bound)
+        {
+            cumulative += h.bucket(index);
+            ++index;
+        }
+        out += std::format(
+            "{} {}\n",
+            series_name(bucket, with_bound(labels, std::to_string(bound))),
+            cumulative);
+    }
+    out += std::format(
+        "{} {}\n{} {}\n{} {}\n",
+        series_name(bucket, with_bound(labels, "+Inf")),
+        h.count(),
+        series_name(std::string(name) + "_count", labels),
+        h.count(),
+        series_name(std::string(name) + "_sum", labels),
+        static_cast<double>(h.sum()));
+}
+
+} // anonymous namespace
+
+std::string
+to_openmetrics(MetricsSnapshot const & snapshot)
+{
+    auto out = std::string{};
+    auto previous = std::string_view{};
+
+    // Samples come ordered by name, so each family is contiguous.
+    for (auto const & sample : snapshot.counters) {
+        auto const family = counter_family(sample.name);
+        if (family != previous) {
+            write_family(out, family, "counter", sample.help);
+            previous = family;
+        }
+        out += std::format(
+            "{} {}\n",
+            series_name(std::string(family) + "_total", sample.labels),
+            sample.value);
+    }
+    for (auto const & sample : snapshot.gauges) {
+        if (sample.name != previous) {
+            write_family(out, sample.name, "gauge", sample.help);
+            previous = sample.name;
+        }
+        out += std::format(
+            "{} {}\n",
+            series_name(sample.name, sample.labels),
+            sample.value);
+    }
+    for (auto const & sample : snapshot.histograms) {
+        if (sample.name != previous) {
+            write_family(out, sample.name, "histogram", sample.help);
+            previous = sample.name;
+        }
+        write_histogram(out, sample.name, sample.labels, sample.value);
+    }
+    out += "# EOF\n";
+    return out;
+}
+
+// ------------------------------------------------------------------
+// MetricsFileExporter
+// ------------------------------------------------------------------
+
+MetricsFileExporter::
+MetricsFileExporter(
+    MetricsRegistry const & registry,
+    std::filesystem::path path,
+    std::chrono::milliseconds interval)
+: registry_(registry)
+, path_(std::move(path))
+, interval_(interval)
+, thread_([this](std::stop_token stop) { run(std::move(stop)); })
+{ }
+
+MetricsFileExporter::
+~MetricsFileExporter()
+{
+    thread_.request_stop();
+    thread_.join();
+    (void)write();
+}
+
+bool
+MetricsFileExporter::
+write() const
+{
+    auto const text = to_openmetrics(registry_.snapshot());
+
+    // Write under a temporary name so a scrape never sees half a file.
+    auto const tmp = path_.string() + ".tmp";
+    std::error_code ec;
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out << text;
+        if (not out) {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp, path_, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+void
+MetricsFileExporter::
+run(std::stop_token stop)
+{
+    (void)write();
+    auto lock = std::unique_lock{mutex_};
+    while (not stop.stop_requested()) {
+        // Only a stop request ends the wait early.
+        (void)wake_.wait_for(lock, stop, interval_, [] { return false; });
+        if (not stop.stop_requested()) {
+            (void)write();
+        }
+    }
+}
+
+} // namespace wjh::chat
@@ -0,0 +1,80 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_76DB2F20BF5F4682A69632FBFA534317
+#define WJH_CHAT_76DB2F20BF5F4682A69632FBFA534317
+
+#include "wjh/chat/Metrics.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+namespace wjh::chat {
+
+/**
+ * The snapshot in OpenMetrics text format, ending with "# EOF".
+ *
+ * Counters are exposed as <family>_total, with the family name taken
+ * from the metric name less its _total suffix.  Histograms get the
+ * cumulative buckets of a fixed 1-2-5 series of bounds (1 to 5e9,
+ * then +Inf) so every scrape has the same series.  A bound that falls
+ * inside one of LatencyHistogram's buckets counts that bucket only
+ * under the next bound, so bucket counts, like percentiles, are
+ * accurate to about 1/64 of the value.
+ */
+[[nodiscard]]
+std::string to_openmetrics(MetricsSnapshot const & snapshot);
+
+/**
+ * Rewrites a file with a registry's metrics in OpenMetrics text, for
+ * a scraper such as the node exporter's textfile collector.
+ *
+ * A background thread writes the file when started and then once per
+ * interval; destruction stops the thread and writes a last time, so
+ * the file ends with the final counts.  Each write goes to a temporary
+ * name first and is renamed into place, so readers never see a
+ * partial file.  Taking a snapshot only locks out registering new
+ * metrics; updates to existing ones go on undisturbed.
+ */
+class MetricsFileExporter
+{
+public:
+    MetricsFileExporter(
+        MetricsRegistry const & registry,
+        std::filesystem::path path,
+        std::chrono::milliseconds interval);
+
+    ~MetricsFileExporter();
+
+    MetricsFileExporter(MetricsFileExporter const &) = delete;
+    MetricsFileExporter & operator = (MetricsFileExporter const &) = delete;
+
+    /**
+     * Write the file now.
+     *
+     * @return Whether the file was replaced.
+     */
+    bool write() const;
+
+private:
+    void run(std::stop_token stop);
+
+    MetricsRegistry const & registry_;
+    std::filesystem::path path_;
+    std::chrono::milliseconds interval_;
+    std::mutex mutex_;
+    std::condition_variable_any wake_;
+    std::jthread thread_; ///< Last, so it starts after the rest.
+};
+
+} // namespace wjh::chat
+
+#endif // WJH_CHAT_76DB2F20BF5F4682A69632FBFA534317
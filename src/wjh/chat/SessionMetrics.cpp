@@ -0,0 +1,178 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/SessionMetrics.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace wjh::chat {
+
+namespace {
+
+std::uint64_t
+microseconds(TurnTiming::Duration duration)
+{
+    auto const us =
+        std::chrono::duration_cast<std::chrono::microseconds>(duration);
+    return us.count() < 0 ? 0 : static_cast<std::uint64_t>(us.count());
+}
+
+} // anonymous namespace
+
+SessionMetrics::
+SessionMetrics(MetricsRegistry & registry)
+: registry_(registry)
+, turns_(registry.counter(
+      "chat_turns_total", "Turns that produced a response"))
+, requests_(registry.counter(
+      "chat_requests_total", "Requests sent to the API"))
+, retries_(registry.counter(
+      "chat_retries_total", "Requests re-sent after an empty reply"))
+, bytes_sent_(registry.counter(
+      "chat_sent_bytes_total", "Request body bytes sent"))
+, bytes_received_(registry.counter(
+      "chat_received_bytes_total", "Response body bytes received"))
+, prompt_tokens_(registry.counter(
+      "chat_prompt_tokens_total", "Prompt tokens billed"))
+, completion_tokens_(registry.counter(
+      "chat_completion_tokens_total", "Completion tokens billed"))
+, cached_tokens_(registry.counter(
+      "chat_cached_tokens_total", "Prompt tokens read from the cache"))
+, cache_hits_(registry.counter(
+      "chat_response_cache_hits_total",
+      "Requests answered from the response cache"))
+, turn_duration_(registry.histogram(
+      "chat_turn_duration_us", "Time from sending a turn to its reply"))
+, request_duration_(registry.histogram(
+      "chat_request_duration_us",
+      "Time from sending a request to the last byte of its response"))
+, first_response_(registry.histogram(
+      "chat_first_response_us", "Time from sending a turn to the first "
+      "response"))
+, tokens_per_second_(registry.histogram(
+      "chat_completion_tokens_per_second",
+      "Completion tokens over time spent waiting and downloading"))
+, history_messages_(registry.gauge(
+      "chat_history_messages", "Messages in the history"))
+, history_tokens_(registry.gauge(
+      "chat_history_tokens", "Estimated prompt tokens in the history"))
+{ }
+
+void
+SessionMetrics::
+record_turn(ChatResponse const & response)
+{
+    auto const & timing = response.timing;
+    turns_.add();
+    record_requests(timing);
+    turn_duration_.record(microseconds(timing.total));
+    if (timing.requests != 0) {
+        first_response_.record(microseconds(timing.first_response));
+    }
+
+    if (response.usage) {
+        auto const & usage = *response.usage;
+        prompt_tokens_.add(json_value(usage.prompt_tokens));
+        completion_tokens_.add(json_value(usage.completion_tokens));
+        cached_tokens_.add(json_value(usage.cached_tokens));
+        cache_hits_.add(json_value(usage.replayed_requests));
+
+        auto const seconds = std::chrono::duration<double>(
+            timing.wait + timing.download).count();
+        auto const completion = json_value(usage.completion_tokens);
+        if (seconds > 0 and completion != 0) {
+            tokens_per_second_.record(static_cast<std::uint64_t>(
+                static_cast<double>(completion) / seconds));
+        }
+    }
+
+    for (auto const & call : timing.tool_calls) {
+        auto & tool = tool_metrics(call.name);
+        tool.calls.add();
+        tool.duration.record(microseconds(call.elapsed));
+    }
+}
+
+void
+SessionMetrics::
+record_error(std::string_view error, TurnTiming const & timing)
+{
+    record_requests(timing);
+
+    constexpr auto prefix = std::string_view{"API error ("};
+    auto status = std::string_view{"none"};
+    if (error.starts_with(prefix)) {
+        auto const digits = error.substr(prefix.size());
+        auto const end = digits.find(')');
+        if (end != std::string_view::npos) {
+            status = digits.substr(0, end);
+        }
+    }
+    error_counter(status).add();
+}
+
+void
+SessionMetrics::
+record_requests(TurnTiming const & timing)
+{
+    requests_.add(timing.requests);
+    retries_.add(timing.retries);
+    bytes_sent_.add(timing.bytes_sent);
+    bytes_received_.add(timing.bytes_received);
+    for (auto const elapsed : timing.request_times) {
+        request_duration_.record(microseconds(elapsed));
+    }
+}
+
+SessionMetrics::ToolMetrics &
+SessionMetrics::
+tool_metrics(std::string_view tool)
+{
+    if (auto found = tools_.find(tool); found != tools_.end()) {
+        return found->second;
+    }
+    auto const labels = Labels{{"tool", std::string(tool)}};
+    return tools_
+        .emplace(
+            std::string(tool),
+            ToolMetrics{
+                .calls = registry_.counter(
+                    "chat_tool_calls_total", "Tool calls run", labels),
+                .duration = registry_.histogram(
+                    "chat_tool_duration_us",
+                    "Time spent running a tool",
+                    labels)})
+        .first->second;
+}
+
+Counter &
+SessionMetrics::
+error_counter(std::string_view status)
+{
+    if (auto found = errors_.find(status); found != errors_.end()) {
+        return *found->second;
+    }
+    auto & counter = registry_.counter(
+        "chat_turn_errors_total",
+        "Turns that ended in an error, by HTTP status",
+        {{"status", std::string(status)}});
+    errors_.emplace(std::string(status), &counter);
+    return counter;
+}
+
+void
+SessionMetrics::
+record_history(std::size_t messages, std::size_t tokens)
+{
+    history_messages_.set(static_cast<std::int64_t>(messages));
+    history_tokens_.set(static_cast<std::int64_t>(tokens));
+}
+
+} // namespace wjh::chat
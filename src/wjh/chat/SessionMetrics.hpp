@@ -0,0 +1,93 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_3DC2C9C3CAC54446987F72912BD998FB
+#define WJH_CHAT_3DC2C9C3CAC54446987F72912BD998FB
+
+#include "wjh/chat/Metrics.hpp"
+#include "wjh/chat/TokenUsage.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat {
+
+/**
+ * The metrics the chat loop keeps about a session, registered once
+ * and updated per turn.
+ *
+ * Durations are recorded in microseconds.  The client does not stream,
+ * so the first response of a turn stands in for time to first token,
+ * and tokens per second is completion tokens over the time spent
+ * waiting for and downloading responses.  Retries are requests re-sent
+ * after the model returned neither text nor tool calls.
+ *
+ * Metrics labelled by tool or status are looked up in the registry
+ * the first time each label is seen and kept, so recording a turn
+ * takes no lock and allocates nothing once the session has seen its
+ * tools.  One thread (the chat loop's) records.
+ */
+class SessionMetrics
+{
+public:
+    explicit SessionMetrics(MetricsRegistry & registry);
+
+    /**
+     * Record a turn that produced a response.
+     */
+    void record_turn(ChatResponse const & response);
+
+    /**
+     * Record a turn that ended in an error, by the HTTP status the
+     * client reported in it ("API error (429): ..."), or "none" when
+     * the request failed without a response.  The requests, bytes,
+     * and request times the turn spent before failing count like
+     * those of any other turn.
+     */
+    void record_error(std::string_view error, TurnTiming const & timing);
+
+    /**
+     * Record the size of the history after a turn.
+     */
+    void record_history(std::size_t messages, std::size_t tokens);
+
+private:
+    struct ToolMetrics
+    {
+        Counter & calls;
+        Histogram & duration;
+    };
+
+    void record_requests(TurnTiming const & timing);
+    ToolMetrics & tool_metrics(std::string_view tool);
+    Counter & error_counter(std::string_view status);
+
+    MetricsRegistry & registry_;
+    Counter & turns_;
+    Counter & requests_;
+    Counter & retries_;
+    Counter & bytes_sent_;
+    Counter & bytes_received_;
+    Counter & prompt_tokens_;
+    Counter & completion_tokens_;
+    Counter & cached_tokens_;
+    Counter & cache_hits_;
+    Histogram & turn_duration_;
+    Histogram & request_duration_;
+    Histogram & first_response_;
+    Histogram & tokens_per_second_;
+    Gauge & history_messages_;
+    Gauge & history_tokens_;
+    std::map<std::string, ToolMetrics, std::less<>> tools_;
+    std::map<std::string, Counter *, std::less<>> errors_;
+};
+
+} // namespace wjh::chat
+
+#endif // WJH_CHAT_3DC2C9C3CAC54446987F72912BD998FB
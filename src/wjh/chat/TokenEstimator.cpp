@@ -0,0 +1,102 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/TokenEstimator.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+#include "wjh/chat/tools/ContentHash.hpp"
+
+namespace wjh::chat {
+
+namespace {
+
+using conversation::Message;
+
+// Hash of every part of a message that is sent.  Parts are separated
+// by a byte that cannot start a UTF-8 sequence, so moving text from
+// one part to the next changes the hash.
+std::uint64_t
+message_key(Message const & message)
+{
+    constexpr std::string_view sep = "\xff";
+    auto hash = tools::content_hash(json_value(message.role()));
+    hash = tools::content_hash(sep, hash);
+    hash = tools::content_hash(json_value(message.text()), hash);
+    for (auto const & call : message.calls()) {
+        hash = tools::content_hash(sep, hash);
+        hash = tools::content_hash(json_value(call.id), hash);
+        hash = tools::content_hash(sep, hash);
+        hash = tools::content_hash(call.name, hash);
+        hash = tools::content_hash(sep, hash);
+        hash = tools::content_hash(call.arguments, hash);
+    }
+    if (auto const & id = message.tool_call_id()) {
+        hash = tools::content_hash(sep, hash);
+        hash = tools::content_hash(json_value(*id), hash);
+    }
+    return hash;
+}
+
+} // anonymous namespace
+
+TokenEstimator::
+TokenEstimator(std::shared_ptr<BpeTokenizer const> tokenizer)
+: tokenizer_(std::move(tokenizer))
+{ }
+
+void
+TokenEstimator::
+set_tokenizer(std::shared_ptr<BpeTokenizer const> tokenizer)
+{
+    tokenizer_ = std::move(tokenizer);
+    cache_.clear();
+}
+
+std::size_t
+TokenEstimator::
+count(std::string_view text) const
+{
+    return tokenizer_ ? tokenizer_->count(text) : (text.size() + 3) / 4;
+}
+
+std::size_t
+TokenEstimator::
+count(Message const & message)
+{
+    auto & entry = cache_[message_key(message)];
+    entry.generation = generation_;
+    if (entry.tokens == 0) {
+        entry.tokens = per_message + count(json_value(message.text()));
+        for (auto const & call : message.calls()) {
+            entry.tokens += count(json_value(call.id)) + count(call.name)
+                + count(call.arguments);
+        }
+        if (auto const & id = message.tool_call_id()) {
+            entry.tokens += count(json_value(*id));
+        }
+    }
+    return entry.tokens;
+}
+
+std::size_t
+TokenEstimator::
+estimate(conversation::Conversation const & conversation)
+{
+    ++generation_;
+    auto tokens = per_request;
+    if (auto const & prompt = conversation.system_prompt()) {
+        tokens += per_message + count(json_value(*prompt));
+    }
+    for (auto const & message : conversation.messages()) {
+        tokens += count(message);
+    }
+    std::erase_if(cache_, [this](auto const & item) {
+        return item.second.generation != generation_;
+    });
+    return tokens;
+}
+
+} // namespace wjh::chat
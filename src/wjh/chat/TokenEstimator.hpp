@@ -0,0 +1,103 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_A47C2E9B05D34F1E8B6A3C7D2E91F054
+#define WJH_CHAT_A47C2E9B05D34F1E8B6A3C7D2E91F054
+
+#include "wjh/chat/BpeTokenizer.hpp"
+#include "wjh/chat/conversation/Conversation.hpp"
+#include "wjh/chat/conversation/Message.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+namespace wjh::chat {
+
+/**
+ * Estimates how many prompt tokens a conversation will cost before it
+ * is sent.
+ *
+ * With a BpeTokenizer the counts follow its vocabulary; without one,
+ * text is counted at four bytes per token.  Each message also costs a
+ * few tokens of chat framing.  Counts are cached per message content,
+ * so estimating a growing conversation only tokenizes the new
+ * messages; entries for messages no longer in the conversation (e.g.,
+ * trimmed or summarized) are dropped on the next estimate.
+ */
+class TokenEstimator
+{
+public:
+    /// Framing tokens per message (role and delimiters).
+    static constexpr std::size_t per_message = 4;
+
+    /// Framing tokens that prime the reply.
+    static constexpr std::size_t per_request = 3;
+
+    TokenEstimator() = default;
+
+    explicit TokenEstimator(std::shared_ptr<BpeTokenizer const> tokenizer);
+
+    /**
+     * Switch tokenizers (nullptr for the byte heuristic), dropping the
+     * cached counts.
+     */
+    void set_tokenizer(std::shared_ptr<BpeTokenizer const> tokenizer);
+
+    /**
+     * Whether counts come from a vocabulary rather than the heuristic.
+     */
+    [[nodiscard]]
+    bool has_tokenizer() const
+    {
+        return tokenizer_ != nullptr;
+    }
+
+    /**
+     * Tokens in plain text.
+     */
+    [[nodiscard]]
+    std::size_t count(std::string_view text) const;
+
+    /**
+     * Tokens for one message, including framing; cached.
+     */
+    [[nodiscard]]
+    std::size_t count(conversation::Message const & message);
+
+    /**
+     * Prompt tokens for a request carrying the conversation: system
+     * prompt and messages, without tool definitions.
+     */
+    [[nodiscard]]
+    std::size_t estimate(conversation::Conversation const & conversation);
+
+    /**
+     * Messages whose counts are cached.
+     */
+    [[nodiscard]]
+    std::size_t cached() const
+    {
+        return cache_.size();
+    }
+
+private:
+    struct Entry
+    {
+        std::size_t tokens = 0;
+        std::uint64_t generation = 0; ///< Last estimate that used it.
+    };
+
+    std::shared_ptr<BpeTokenizer const> tokenizer_;
+    std::unordered_map<std::uint64_t, Entry> cache_;
+    std::uint64_t generation_ = 0;
+};
+
+} // namespace wjh::chat
+
+#endif // WJH_CHAT_A47C2E9B05D34F1E8B6A3C7D2E91F054
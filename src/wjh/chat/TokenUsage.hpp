@@ -7,32 +7,59 @@
 #ifndef WJH_CHAT_A7B3C9D1E5F6482394AD8E1F2C3B4A56
 #define WJH_CHAT_A7B3C9D1E5F6482394AD8E1F2C3B4A56
 
+#include "wjh/chat/TurnTiming.hpp"
 #include "wjh/chat/types.hpp"
+#include "wjh/chat/conversation/Message.hpp"
 
 #include <optional>
+#include <vector>
 
 namespace wjh::chat {
 
 /**
  * Token usage statistics from a single API response.
+ *
+ * Cached and cache-write tokens are the parts of prompt_tokens that
+ * were read from or written to the provider's prompt cache; they stay
+ * zero for providers that do not report them.  Requests answered from
+ * the local response cache are only counted in replayed_requests;
+ * their tokens were not billed and are not included.
  */
 struct TokenUsage
 {
     PromptTokens prompt_tokens{};
     CompletionTokens completion_tokens{};
     TotalTokens total_tokens{};
+    CachedTokens cached_tokens{};
+    CacheWriteTokens cache_write_tokens{};
+    ReplayedRequests replayed_requests{};
+
+    TokenUsage & operator += (TokenUsage const & other)
+    {
+        prompt_tokens += other.prompt_tokens;
+        completion_tokens += other.completion_tokens;
+        total_tokens += other.total_tokens;
+        cached_tokens += other.cached_tokens;
+        cache_write_tokens += other.cache_write_tokens;
+        replayed_requests += other.replayed_requests;
+        return *this;
+    }
 };
 
 /**
  * Full response from the LLM client.
  *
  * Bundles the assistant's text with optional token usage
- * statistics (not all providers return usage data).
+ * statistics (not all providers return usage data), the tool calls
+ * and results exchanged before the text arrived, in order, and where
+ * the client spent its time.
  */
 struct ChatResponse
 {
     AssistantResponse response;
     std::optional<TokenUsage> usage;
+    std::vector<conversation::Message> tool_messages{};
+    TurnTiming timing{};
 };
 
 } // namespace wjh::chat
@@ -0,0 +1,93 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_A9F675C6A6F7488FBAD4CA0C65484D33
+#define WJH_CHAT_A9F675C6A6F7488FBAD4CA0C65484D33
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace wjh::chat {
+
+/**
+ * How long one tool call took.
+ */
+struct ToolTiming
+{
+    std::string name;
+    std::chrono::steady_clock::duration elapsed{};
+};
+
+/**
+ * Where the time of one turn went, summed over all of its requests.
+ *
+ * Times are taken from the steady clock.  cpp-httplib does not report
+ * when a connection is established or a request fully sent, so wait
+ * covers connect, TLS, upload, and server time together: from handing
+ * the request to the transport until the response headers arrive.
+ * Replayed requests count entirely as wait, and answers from the
+ * response cache are not counted as requests at all.  The traffic of
+ * the turn is kept alongside, since it explains most of the wait.
+ */
+struct TurnTiming
+{
+    using Duration = std::chrono::steady_clock::duration;
+
+    Duration total{}; ///< The whole turn, as the chat loop saw it.
+    Duration build{}; ///< Building and serializing request bodies.
+    Duration wait{}; ///< Request sent until response headers arrive.
+    Duration download{}; ///< Response headers until the last byte.
+    Duration parse{}; ///< Parsing response JSON into replies.
+    Duration tools{}; ///< Running tool calls.
+    Duration first_response{}; ///< Turn start until the first reply.
+    std::size_t requests = 0;
+    std::size_t retries = 0; ///< Requests re-sent after an empty reply.
+    std::size_t bytes_sent = 0; ///< Request bodies.
+    std::size_t bytes_received = 0; ///< Response bodies.
+    std::vector<Duration> request_times{}; ///< Each request, send to end.
+    std::vector<ToolTiming> tool_calls{};
+
+    /**
+     * Time in none of the measured parts (approval prompts, output,
+     * client bookkeeping).
+     */
+    [[nodiscard]]
+    Duration other() const
+    {
+        auto const known = build + wait + download + parse + tools;
+        return total > known ? total - known : Duration{};
+    }
+
+    TurnTiming & operator += (TurnTiming const & other)
+    {
+        total += other.total;
+        build += other.build;
+        wait += other.wait;
+        download += other.download;
+        parse += other.parse;
+        tools += other.tools;
+        first_response += other.first_response;
+        requests += other.requests;
+        retries += other.retries;
+        bytes_sent += other.bytes_sent;
+        bytes_received += other.bytes_received;
+        request_times.insert(
+            request_times.end(),
+            other.request_times.begin(),
+            other.request_times.end());
+        tool_calls.insert(
+            tool_calls.end(),
+            other.tool_calls.begin(),
+            other.tool_calls.end());
+        return *this;
+    }
+};
+
+} // namespace wjh::chat
+
+#endif // WJH_CHAT_A9F675C6A6F7488FBAD4CA0C65484D33
@@ -0,0 +1,82 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/HistoryDedup.hpp"
+
+#include "wjh/chat/tools/ContentHash.hpp"
+
+#include <cstdint>
+#include <format>
+#include <string>
+#include <unordered_map>
+
+namespace wjh::chat::client {
+
+namespace {
+
+struct Shown
+{
+    std::string const * content;
+    std::string id;
+};
+
+} // anonymous namespace
+
+DedupStats
+dedupe_tool_results(nlohmann::json & messages, std::size_t min_bytes)
+{
+    DedupStats stats;
+    if (not messages.is_array()) {
+        return stats;
+    }
+
+    // Walk from oldest to newest so the first copy seen is the one
+    // kept, and a message is judged only by the ones before it.
+    std::unordered_multimap<std::uint64_t, Shown> by_content;
+    for (auto & msg : messages) {
+        if (msg.value("role", std::string{}) != "tool"
+            or not msg.contains("content") or not msg["content"].is_string()
+            or not msg.contains("tool_call_id"))
+        {
+            continue;
+        }
+        auto const & content = msg["content"].get_ref<std::string const &>();
+        if (content.size() < min_bytes) {
+            continue;
+        }
+
+        std::string note;
+        auto const hash = tools::content_hash(content);
+        auto const [first, last] = by_content.equal_range(hash);
+        for (auto match = first; match != last; ++match) {
+            if (*match->second.content == content) {
+                note = std::format(
+                    "[Same output as tool call {}, shown earlier.]",
+                    match->second.id);
+                break;
+            }
+        }
+
+        if (note.empty()) {
+            by_content.emplace(
+                hash,
+                Shown{
+                    .content = &content,
+                    .id = msg["tool_call_id"].get<std::string>()});
+            continue;
+        }
+        if (note.size() >= content.size()) {
+            continue;
+        }
+
+        stats.bytes_saved += content.size() - note.size();
+        ++stats.replaced;
+        msg["content"] = std::move(note);
+    }
+    return stats;
+}
+
+} // namespace wjh::chat::client
@@ -0,0 +1,45 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_4D9B1E67C03A4F2E8B57A1C6D2E09F84
+#define WJH_CHAT_4D9B1E67C03A4F2E8B57A1C6D2E09F84
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+
+namespace wjh::chat::client {
+
+/**
+ * What one dedupe pass over the history changed.
+ */
+struct DedupStats
+{
+    std::size_t replaced = 0; ///< Tool results replaced by a reference.
+    std::size_t bytes_saved = 0;
+};
+
+/**
+ * Replace repeated tool results in OpenAI-format messages with a short
+ * reference to the first copy.
+ *
+ * A result is replaced when an earlier tool result has the same
+ * content and is at least min_bytes long.  Whether a message is
+ * replaced depends only on the messages before it, so appending to the
+ * history never changes a message already sent and the prefix a
+ * provider has cached stays valid.  The price is that a re-read with
+ * new content does not replace the older read; that copy stays until
+ * Conversation::trim_tool_results() cuts it.  Replaced results are
+ * short, so running the pass again on the rewritten history changes
+ * nothing more.
+ */
+DedupStats dedupe_tool_results(
+    nlohmann::json & messages,
+    std::size_t min_bytes = 256);
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_4D9B1E67C03A4F2E8B57A1C6D2E09F84
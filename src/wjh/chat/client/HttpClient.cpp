@@ -10,33 +10,43 @@
 
 #include <httplib.h>
 
+#include <chrono>
+
 namespace wjh::chat::client {
 
-HttpClient::
-HttpClient(Hostname host, PortNumber port)
-: host_(std::move(host))
-, port_(port)
-{ }
+namespace {
 
+template <typename ClientT>
 Result<HttpResponse>
-HttpClient::
-post(HttpPath const & path, HttpBody const & body, HttpHeaders const & headers)
+send_post(
+    ClientT & client,
+    HttpPath const & path,
+    HttpBody const & body,
+    HttpHeaders const & headers)
 {
-    httplib::SSLClient client(json_value(host_), json_value(port_));
-    client.set_connection_timeout(json_value(connection_timeout_), 0);
-    client.set_read_timeout(json_value(read_timeout_), 0);
-    client.enable_server_certificate_verification(true);
+    using clock = std::chrono::steady_clock;
 
-    httplib::Headers http_headers;
+    httplib::Request request;
+    request.method = "POST";
+    request.path = json_value(path);
+    request.body = json_value(body);
     for (auto const & [key, value] : headers) {
-        http_headers.emplace(key, value);
+        request.headers.emplace(key, value);
+    }
+    if (request.headers.find("Content-Type") == request.headers.end()) {
+        request.headers.emplace("Content-Type", "application/json");
     }
 
-    auto result = client.Post(
-        json_value(path),
-        http_headers,
-        json_value(body),
-        "application/json");
+    // Called once the status line and headers are in, before the body.
+    HttpTiming timing;
+    request.response_handler = [&timing](httplib::Response const &) {
+        timing.headers = clock::now();
+        return true;
+    };
+
+    timing.start = clock::now();
+    auto result = client.send(request);
+    timing.end = clock::now();
 
     if (not result) {
         auto err = result.error();
@@ -46,6 +56,7 @@ post(HttpPath const & path, HttpBody const & body, HttpHeaders const & headers)
     HttpResponse response;
     response.status = HttpStatusCode{result->status};
     response.body = HttpBody{result->body};
+    response.timing = timing;
 
     for (auto const & [key, value] : result->headers) {
         response.headers.add(HeaderName{key}, HeaderValue{value});
@@ -54,6 +65,33 @@ post(HttpPath const & path, HttpBody const & body, HttpHeaders const & headers)
     return response;
 }
 
+} // anonymous namespace
+
+HttpClient::
+HttpClient(Hostname host, PortNumber port, HttpScheme scheme)
+: host_(std::move(host))
+, port_(port)
+, scheme_(scheme)
+{ }
+
+Result<HttpResponse>
+HttpClient::
+post(HttpPath const & path, HttpBody const & body, HttpHeaders const & headers)
+{
+    if (scheme_ == HttpScheme::http) {
+        httplib::Client client(json_value(host_), json_value(port_));
+        client.set_connection_timeout(json_value(connection_timeout_), 0);
+        client.set_read_timeout(json_value(read_timeout_), 0);
+        return send_post(client, path, body, headers);
+    }
+
+    httplib::SSLClient client(json_value(host_), json_value(port_));
+    client.set_connection_timeout(json_value(connection_timeout_), 0);
+    client.set_read_timeout(json_value(read_timeout_), 0);
+    client.enable_server_certificate_verification(true);
+    return send_post(client, path, body, headers);
+}
+
 void
 HttpClient::
 set_connection_timeout(TimeoutSeconds seconds)
@@ -10,6 +10,7 @@
 #include "wjh/chat/Result.hpp"
 #include "wjh/chat/client/types.hpp"
 
+#include <chrono>
 #include <initializer_list>
 #include <map>
 #include <string>
@@ -74,6 +75,21 @@ private:
     std::map<std::string, std::string> headers_;
 };
 
+/**
+ * When an exchange reached each stage, on the steady clock.
+ *
+ * Only HttpClient fills these in; responses that did not come over the
+ * network leave them at the epoch.
+ */
+struct HttpTiming
+{
+    using time_point = std::chrono::steady_clock::time_point;
+
+    time_point start{}; ///< Request handed to the connection.
+    time_point headers{}; ///< Status line and headers read.
+    time_point end{}; ///< Body read.
+};
+
 /**
  * HTTP response containing status, headers, and body.
  */
@@ -82,13 +98,24 @@ struct HttpResponse
     HttpStatusCode status;
     HttpHeaders headers;
     HttpBody body;
+    HttpTiming timing{};
+};
+
+/**
+ * Whether requests are sent in the clear or over TLS.
+ */
+enum class HttpScheme
+{
+    http,
+    https
 };
 
 /**
  * Simple HTTP client abstraction using cpp-httplib.
  *
  * This provides a basic interface for making HTTPS requests,
- * primarily for the OpenRouter API.
+ * primarily for the OpenRouter API.  Plain HTTP is meant for local
+ * test servers.
  */
 class HttpClient
 {
@@ -97,8 +124,12 @@ public:
      * Construct a client for the given host.
      * @param host The hostname (e.g., "openrouter.ai")
      * @param port The port (default 443 for HTTPS)
+     * @param scheme HTTPS (verifying the server certificate) or HTTP
      */
-    explicit HttpClient(Hostname host, PortNumber port = PortNumber{443});
+    explicit HttpClient(
+        Hostname host,
+        PortNumber port = PortNumber{443},
+        HttpScheme scheme = HttpScheme::https);
 
     /**
      * Make a POST request.
@@ -126,6 +157,7 @@ public:
 private:
     Hostname host_;
     PortNumber port_;
+    HttpScheme scheme_;
     TimeoutSeconds connection_timeout_{30};
     TimeoutSeconds read_timeout_{120};
 };
@@ -11,4 +11,18 @@ namespace wjh::chat::client {
 IClient::
 ~IClient() = default;
 
+Result<AssistantResponse>
+IClient::
+do_complete(conversation::Conversation const &, ModelId const & model)
+{
+    return make_error("This client cannot run completions with {}", model);
+}
+
+TurnTiming
+IClient::
+do_failed_timing() const
+{
+    return {};
+}
+
 } // namespace wjh::chat::client
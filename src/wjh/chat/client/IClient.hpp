@@ -39,9 +39,47 @@ public:
         return do_send_message(conversation);
     }
 
+    /**
+     * Get a single text reply from the given model, without tools.
+     *
+     * Used for side tasks such as summarizing old turns with a cheaper
+     * model than the one the conversation uses.
+     */
+    [[nodiscard]]
+    Result<AssistantResponse> complete(
+        conversation::Conversation const & conversation,
+        ModelId const & model)
+    {
+        return do_complete(conversation, model);
+    }
+
+    /**
+     * What the last send_message spent before it failed: requests,
+     * bytes, and request times.  A failed turn returns no ChatResponse
+     * to carry its timing, so callers read it back from here.  Empty
+     * after a success.
+     */
+    [[nodiscard]]
+    TurnTiming failed_timing() const
+    {
+        return do_failed_timing();
+    }
+
 private:
     virtual Result<ChatResponse> do_send_message(
         conversation::Conversation const & conversation) = 0;
+
+    /**
+     * Default: not supported.
+     */
+    virtual Result<AssistantResponse> do_complete(
+        conversation::Conversation const & conversation,
+        ModelId const & model);
+
+    /**
+     * Default: nothing measured.
+     */
+    virtual TurnTiming do_failed_timing() const;
 };
 
 } // namespace wjh::chat::client
@@ -6,33 +6,23 @@
 // ----------------------------------------------------------------------
 #include "wjh/chat/client/OpenRouterClient.hpp"
 
+#include "wjh/chat/client/HistoryDedup.hpp"
+#include "wjh/chat/client/PerfCounters.hpp"
+#include "wjh/chat/client/Tracer.hpp"
 #include "wjh/chat/json_convert.hpp"
-#include "wjh/chat/stdfmt.hpp"
 #include "wjh/chat/conversation/Message.hpp"
+#include "wjh/chat/tools/ProcessRunner.hpp"
+#include "wjh/chat/tools/ReadTracker.hpp"
 
-#include <array>
-#include <cstdio>
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 namespace {
 
-constexpr bool DEBUG_COMMS = false;
-
-void debug_json(
-    std::string_view label,
-    nlohmann::json const & json)
-{
-    if constexpr (DEBUG_COMMS) {
-        wjh::chat::print(
-            stderr,
-            "\n=== {} ===\n{}\n",
-            label,
-            json.dump(2));
-    }
-}
-
 nlohmann::json make_tools_json()
 {
     auto bash_tool = nlohmann::json{
@@ -59,7 +49,11 @@ nlohmann::json make_tools_json()
           {"description",
            "Read the contents of a file. Returns "
            "lines with line numbers. Use this "
-           "instead of bash cat/head/tail."},
+           "instead of bash cat/head/tail. If the "
+           "same range was already shown earlier "
+           "in the conversation and has changed "
+           "little, returns a unified diff against "
+           "that copy instead."},
           {"parameters",
            {{"type", "object"},
             {"properties",
@@ -131,48 +125,139 @@ nlohmann::json make_tools_json()
              {"file_path", "old_string",
               "new_string"}}}}}}};
 
+    auto build_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "build"},
+          {"description",
+           "Build and test the project with its CMake "
+           "presets. Returns a compact summary of "
+           "compiler diagnostics and test results plus "
+           "the path of the full log. Use this instead "
+           "of bash cmake/ctest."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"preset",
+               {{"type", "string"},
+                {"description",
+                 "CMake preset (default: debug)"}}},
+              {"target",
+               {{"type", "string"},
+                {"description",
+                 "Build only this target (optional)"}}},
+              {"configure",
+               {{"type", "boolean"},
+                {"description",
+                 "Run cmake --preset first "
+                 "(default: false; done "
+                 "automatically if needed)"}}},
+              {"run_tests",
+               {{"type", "boolean"},
+                {"description",
+                 "Run ctest after a successful "
+                 "build (default: true)"}}},
+              {"test_filter",
+               {{"type", "string"},
+                {"description",
+                 "Only run tests matching this "
+                 "regex (optional)"}}},
+              {"max_diagnostics",
+               {{"type", "integer"},
+                {"description",
+                 "Maximum diagnostics to show "
+                 "(default: 20)"}}},
+              {"max_notes",
+               {{"type", "integer"},
+                {"description",
+                 "Maximum notes per diagnostic "
+                 "(default: 3)"}}}}}}}}}};
+
+    auto read_output_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "read_output"},
+          {"description",
+           "Read part of a large tool output that was "
+           "stored instead of returned in full. By "
+           "default returns numbered lines; give "
+           "byte_offset to read raw bytes instead."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"handle",
+               {{"type", "string"},
+                {"description",
+                 "Handle from the tool result "
+                 "(e.g. out-1a2b3c4d5e6f7a8b)"}}},
+              {"offset",
+               {{"type", "integer"},
+                {"description",
+                 "1-indexed line number to start "
+                 "from (default: 1)"}}},
+              {"limit",
+               {{"type", "integer"},
+                {"description",
+                 "Maximum number of lines "
+                 "(default: 200)"}}},
+              {"byte_offset",
+               {{"type", "integer"},
+                {"description",
+                 "Read bytes from this offset "
+                 "instead of lines (optional)"}}},
+              {"byte_length",
+               {{"type", "integer"},
+                {"description",
+                 "Number of bytes to read "
+                 "(default: 8192)"}}}}},
+            {"required", {"handle"}}}}}}};
+
     return {bash_tool, read_file_tool,
-            write_file_tool, edit_file_tool};
+            write_file_tool, edit_file_tool,
+            build_tool, read_output_tool};
 }
 
-std::string execute_bash(std::string const & command)
+std::string execute_bash(
+    std::string const & command,
+    wjh::chat::tools::ResourceLimits const & limits,
+    wjh::chat::tools::CompactOptions const & compaction)
 {
-    std::cerr << "\n[tool] bash: " << command
-              << "\n[y/n]> " << std::flush;
-    std::string answer;
-    std::getline(std::cin, answer);
-    if (answer.empty()
-        or (answer[0] != 'y' and answer[0] != 'Y'))
-    {
-        return "Command skipped by user";
+    if (command.empty()) {
+        return "Error: empty command";
     }
 
-    std::string full_cmd = command + " 2>&1";
-    std::array<char, 4096> buffer;
-    std::string result;
-
-    auto * pipe = popen(full_cmd.c_str(), "r");
-    if (not pipe) {
+    auto process = wjh::chat::tools::run_process(
+        wjh::chat::tools::ShellCommand{command}, limits);
+    if (not process) {
         return "Error: failed to execute command";
     }
 
-    while (fgets(buffer.data(), buffer.size(), pipe)) {
-        result += buffer.data();
-        if (result.size() > 100'000) {
-            result += "\n... [truncated at 100KB]";
-            break;
-        }
+    auto result = std::move(process->output);
+    auto const raw_size = result.size();
+    if (auto const saved =
+            wjh::chat::tools::compact_output(result, compaction))
+    {
+        result += std::format(
+            "\n[compacted: {} of {} bytes removed]", saved, raw_size);
+    }
+    if (process->limit_hit != wjh::chat::tools::LimitHit::none) {
+        result += "\n" + wjh::chat::tools::describe_limit(
+            process->limit_hit, limits);
+    } else if (process->possible_limit != wjh::chat::tools::LimitHit::none) {
+        result += "\n" + wjh::chat::tools::describe_possible_limit(
+            process->possible_limit, limits);
     }
-
-    auto status = pclose(pipe);
     result +=
         "\n[exit code: "
-        + std::to_string(WEXITSTATUS(status)) + "]";
+        + std::to_string(
+            wjh::chat::json_value(process->exit_status))
+        + "]";
     return result;
 }
 
 std::string execute_read_file(
-    nlohmann::json const & args)
+    nlohmann::json const & args,
+    wjh::chat::tools::ReadTracker * reads)
 {
     auto path =
         args["file_path"].get<std::string>();
@@ -193,6 +278,7 @@ std::string execute_read_file(
 
     std::string result;
     std::string line;
+    std::vector<std::string> lines;
     int line_num = 0;
     int lines_read = 0;
 
@@ -209,13 +295,37 @@ std::string execute_read_file(
         ++lines_read;
         if (result.size() > 100'000) {
             result += "\n... [truncated at 100KB]";
+            reads = nullptr;
             break;
         }
+        if (reads) {
+            lines.push_back(std::move(line));
+        }
     }
 
     if (result.empty()) {
         return "File is empty or offset is past end";
     }
+
+    if (reads) {
+        std::error_code ec;
+        auto const canonical =
+            std::filesystem::weakly_canonical(path, ec);
+        auto reply = reads->reread(wjh::chat::tools::FileRead{
+            .key = std::format(
+                "{}:{}:{}",
+                ec ? path : canonical.string(),
+                offset,
+                limit),
+            .display_path = path,
+            .first_line = static_cast<std::size_t>(
+                std::max(offset, 1)),
+            .lines = std::move(lines),
+            .full_size = result.size()});
+        if (reply) {
+            return std::move(*reply);
+        }
+    }
     return result;
 }
 
@@ -227,18 +337,6 @@ std::string execute_write_file(
     auto content =
         args["content"].get<std::string>();
 
-    std::cerr
-        << "\n[tool] write_file: " << path
-        << " (" << content.size() << " bytes)"
-        << "\n[y/n]> " << std::flush;
-    std::string answer;
-    std::getline(std::cin, answer);
-    if (answer.empty()
-        or (answer[0] != 'y' and answer[0] != 'Y'))
-    {
-        return "Write skipped by user";
-    }
-
     auto parent =
         std::filesystem::path(path).parent_path();
     if (not parent.empty()) {
@@ -286,7 +384,7 @@ std::string execute_edit_file(
         std::istreambuf_iterator<char>());
     file.close();
 
-    // Check uniqueness before prompting
+    // The edit must identify exactly one location
     std::size_t count = 0;
     std::size_t pos = 0;
     std::size_t found_pos = std::string::npos;
@@ -309,20 +407,6 @@ std::string execute_edit_file(
             + " occurrences)";
     }
 
-    // Show diff preview and prompt
-    std::cerr
-        << "\n[tool] edit_file: " << path
-        << "\n--- old ---\n" << old_string
-        << "\n--- new ---\n" << new_string
-        << "\n[y/n]> " << std::flush;
-    std::string answer;
-    std::getline(std::cin, answer);
-    if (answer.empty()
-        or (answer[0] != 'y' and answer[0] != 'Y'))
-    {
-        return "Edit skipped by user";
-    }
-
     // Apply the replacement
     contents.replace(
         found_pos, old_string.size(), new_string);
@@ -340,16 +424,72 @@ std::string execute_edit_file(
     return "Applied edit to " + path;
 }
 
+std::string execute_build(
+    nlohmann::json const & args,
+    wjh::chat::tools::BuildTool & build_tool)
+{
+    auto request = wjh::chat::tools::parse_build_request(args);
+    if (not request) {
+        return "Error: " + request.error();
+    }
+
+    return build_tool.run(*request);
+}
+
+std::string execute_read_output(
+    nlohmann::json const & args,
+    wjh::chat::tools::BlobStore const & outputs,
+    std::size_t max_bytes)
+{
+    auto request = wjh::chat::tools::parse_output_request(args);
+    if (not request) {
+        return "Error: " + request.error();
+    }
+
+    auto result = outputs.read(*request, max_bytes);
+    if (not result) {
+        return "Error: " + result.error();
+    }
+    return std::move(*result);
+}
+
+// Top-level request fields other than tools and messages.
+nlohmann::json request_settings(
+    wjh::chat::client::OpenRouterClientConfig const & config)
+{
+    auto settings = nlohmann::json{
+        {"model", wjh::chat::json_value(config.model)},
+        {"max_tokens", wjh::chat::json_value(config.max_tokens)}};
+    if (config.temperature) {
+        settings["temperature"] = wjh::chat::json_value(*config.temperature);
+    }
+    return settings;
+}
+
+// What the tool implementations need from the client.
+struct ToolContext
+{
+    wjh::chat::tools::BuildTool & build_tool;
+    wjh::chat::tools::BlobStore const & outputs;
+    wjh::chat::tools::ToolLimits const & limits;
+    wjh::chat::tools::CompactOptions const & compaction;
+    std::size_t max_read_bytes;
+    wjh::chat::tools::ReadTracker * reads; ///< Null: always send in full.
+};
+
 std::string dispatch_tool(
     std::string const & name,
-    nlohmann::json const & args)
+    nlohmann::json const & args,
+    ToolContext const & context)
 {
     if (name == "bash") {
         return execute_bash(
-            args["command"].get<std::string>());
+            args["command"].get<std::string>(),
+            wjh::chat::tools::limits_for(context.limits, "bash"),
+            context.compaction);
     }
     if (name == "read_file") {
-        return execute_read_file(args);
+        return execute_read_file(args, context.reads);
     }
     if (name == "write_file") {
         return execute_write_file(args);
@@ -357,6 +497,13 @@ std::string dispatch_tool(
     if (name == "edit_file") {
         return execute_edit_file(args);
     }
+    if (name == "build") {
+        return execute_build(args, context.build_tool);
+    }
+    if (name == "read_output") {
+        return execute_read_output(
+            args, context.outputs, context.max_read_bytes);
+    }
     return "Error: unknown tool: " + name;
 }
 
@@ -366,51 +513,32 @@ namespace wjh::chat::client {
 
 OpenRouterClient::
 OpenRouterClient(OpenRouterClientConfig config)
-: config_(std::move(config))
-, http_client_(Hostname{"openrouter.ai"}, PortNumber{443})
+: OpenRouterClient(std::move(config), make_openrouter_transport())
 { }
 
-nlohmann::json
 OpenRouterClient::
-convert_messages_to_openai(
-    conversation::Conversation const & conversation) const
+OpenRouterClient(
+    OpenRouterClientConfig config,
+    std::unique_ptr<ITransport> transport)
+: config_(std::move(config))
+, transport_(std::move(transport))
+, build_tool_(
+      config_.build_log_dir.value_or(tools::default_build_log_dir()),
+      tools::limits_for(config_.tool_limits, "build"))
+, blob_store_(config_.blob_dir.value_or(tools::default_blob_dir()))
+, approver_(
+      config_.tool_policy,
+      std::cin,
+      std::cerr,
+      config_.tool_audit_log)
+, request_prefix_(request_settings(config_), make_tools_json())
 {
-    auto messages = nlohmann::json::array();
-
-    // Add system message if present
-    auto const & system_prompt = config_.system_prompt
-        ? config_.system_prompt
-        : conversation.system_prompt();
-    if (system_prompt) {
-        messages.push_back(
-            {{"role", "system"}, {"content", json_value(*system_prompt)}});
-    }
-
-    // Convert each message (simple role + content format)
-    for (auto const & msg : conversation.messages()) {
-        messages.push_back(to_json(msg));
+    if (config_.response_cache.dir and is_deterministic(config_.temperature))
+    {
+        response_cache_.emplace(
+            *config_.response_cache.dir,
+            config_.response_cache.max_bytes);
     }
-
-    return messages;
-}
-
-nlohmann::json
-OpenRouterClient::
-build_request(conversation::Conversation const & conversation) const
-{
-    auto request = nlohmann::json{
-        {"model", json_value(config_.model)},
-        {"max_tokens", json_value(config_.max_tokens)},
-        {"messages", convert_messages_to_openai(conversation)}};
-
-    if (config_.temperature) {
-        request["temperature"] =
-            json_value(*config_.temperature);
-    }
-
-    request["tools"] = make_tools_json();
-
-    return request;
 }
 
 conversation::StopReason
@@ -445,14 +573,7 @@ parse_response(nlohmann::json const & json) const
         // tool-call and text-content paths)
         std::optional<TokenUsage> usage;
         if (json.contains("usage")) {
-            auto const & u = json["usage"];
-            usage = TokenUsage{
-                .prompt_tokens = PromptTokens{
-                    u.value("prompt_tokens", 0u)},
-                .completion_tokens = CompletionTokens{
-                    u.value("completion_tokens", 0u)},
-                .total_tokens = TotalTokens{
-                    u.value("total_tokens", 0u)}};
+            usage = parse_usage(json["usage"]);
         }
 
         // Check for tool calls
@@ -502,6 +623,16 @@ Result<nlohmann::json>
 OpenRouterClient::
 send_api_request(nlohmann::json const & request)
 {
+    auto timing = TurnTiming{};
+    return send_api_request(request.dump(), timing);
+}
+
+Result<nlohmann::json>
+OpenRouterClient::
+send_api_request(std::string body, TurnTiming & timing)
+{
+    using clock = std::chrono::steady_clock;
+
     HttpHeaders headers{
         {HeaderName{"Authorization"},
          HeaderValue{
@@ -509,10 +640,30 @@ send_api_request(nlohmann::json const & request)
         {HeaderName{"Content-Type"},
          HeaderValue{"application/json"}}};
 
-    auto result = http_client_.post(
-        HttpPath{"/api/v1/chat/completions"},
-        HttpBody{request.dump()},
-        headers);
+    auto const start = clock::now();
+    timing.bytes_sent += body.size();
+    auto result = [this, &body, &headers] {
+        auto const perf = PerfScope("http");
+        return transport_->post(
+            HttpPath{"/api/v1/chat/completions"},
+            HttpBody{std::move(body)},
+            headers);
+    }();
+    auto const received = clock::now();
+    ++timing.requests;
+    timing.request_times.push_back(received - start);
+    if (result) {
+        timing.bytes_received += json_value(result->body).size();
+    }
+    if (result and result->timing.headers != HttpTiming::time_point{}) {
+        timing.wait += result->timing.headers - start;
+        timing.download += received - result->timing.headers;
+        Tracer::record("http.wait", start, result->timing.headers);
+        Tracer::record("http.download", result->timing.headers, received);
+    } else {
+        timing.wait += received - start;
+        Tracer::record("http.wait", start, received);
+    }
     if (not result) {
         return make_error("{}", result.error());
     }
@@ -541,8 +692,14 @@ send_api_request(nlohmann::json const & request)
     }
 
     try {
-        return nlohmann::json::parse(
-            json_value(response.body));
+        auto json = [&response] {
+            auto const perf = PerfScope("parse");
+            return nlohmann::json::parse(json_value(response.body));
+        }();
+        auto const parsed = clock::now();
+        timing.parse += parsed - received;
+        Tracer::record("parse.json", received, parsed);
+        return json;
     } catch (nlohmann::json::parse_error const & e) {
         return make_error(
             "Failed to parse response JSON: {}",
@@ -550,36 +707,164 @@ send_api_request(nlohmann::json const & request)
     }
 }
 
+Result<AssistantResponse>
+OpenRouterClient::
+do_complete(
+    conversation::Conversation const & conversation,
+    ModelId const & model)
+{
+    auto messages = nlohmann::json::array();
+    if (auto const & prompt = conversation.system_prompt()) {
+        messages.push_back(
+            {{"role", "system"}, {"content", json_value(*prompt)}});
+    }
+    for (auto const & msg : conversation.messages()) {
+        messages.push_back(conversation::to_json(msg));
+    }
+
+    auto const request = nlohmann::json{
+        {"model", json_value(model)},
+        {"max_tokens", json_value(config_.max_tokens)},
+        {"messages", std::move(messages)}};
+
+    auto result = send_api_request(request);
+    if (not result) {
+        return make_error("{}", result.error());
+    }
+
+    auto response = parse_response(*result);
+    if (not response) {
+        return make_error("{}", response.error());
+    }
+    return std::move(response->response);
+}
+
 Result<ChatResponse>
 OpenRouterClient::
 do_send_message(
     conversation::Conversation const & conversation)
 {
-    auto messages =
-        convert_messages_to_openai(conversation);
-    auto const tools = make_tools_json();
+    auto timing = TurnTiming{};
+    auto result = run_turn(conversation, timing);
+    failed_timing_ = result ? TurnTiming{} : std::move(timing);
+    return result;
+}
+
+TurnTiming
+OpenRouterClient::
+do_failed_timing() const
+{
+    return failed_timing_;
+}
+
+Result<ChatResponse>
+OpenRouterClient::
+run_turn(
+    conversation::Conversation const & conversation,
+    TurnTiming & timing)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto const turn_start = clock::now();
+    auto build_start = turn_start;
+    auto messages = nlohmann::json::array();
+    {
+        auto const perf = PerfScope("build");
+        for (auto const & msg : conversation.messages()) {
+            messages.push_back(conversation::to_json(msg));
+        }
+    }
+    Tracer::record("build", turn_start, clock::now());
+    auto const & system_prompt = config_.system_prompt
+        ? config_.system_prompt
+        : conversation.system_prompt();
+    // Results from earlier turns may have been trimmed since, so only
+    // copies sent during this call serve as a base for diffs.
+    auto reads = tools::ReadTracker(config_.tool_output_spill.threshold);
+    std::vector<conversation::Message> tool_messages;
+    // Summed over every request of the turn, as each one is billed.
+    std::optional<TokenUsage> usage;
+    auto const mark_cache =
+        wants_cache_breakpoints(config_.prompt_cache, config_.model);
 
     for (int i = 0; i < 20; ++i) {
-        auto request = nlohmann::json{
-            {"model", json_value(config_.model)},
-            {"max_tokens",
-             json_value(config_.max_tokens)},
-            {"messages", messages},
-            {"tools", tools}};
-
-        if (config_.temperature) {
-            request["temperature"] =
-                json_value(*config_.temperature);
+        if (i > 0) {
+            build_start = clock::now();
+        }
+        auto build_perf = PerfScope("build");
+        if (config_.dedupe_tool_results) {
+            auto const span = TraceSpan("dedupe");
+            (void)dedupe_tool_results(messages);
         }
 
-        debug_json("request", request);
+        auto body = std::string{};
+        {
+            auto const span = TraceSpan("serialize");
+            if (mark_cache) {
+                // Mark in place and restore the (at most three) marked
+                // messages after, rather than copy the whole history.
+                auto const marks = cache_breakpoints(messages);
+                auto contents = std::vector<nlohmann::json>{};
+                contents.reserve(marks.size());
+                for (auto const index : marks) {
+                    contents.push_back(messages[index]["content"]);
+                    add_cache_breakpoint(messages[index]);
+                }
+                body = request_prefix_.build(system_prompt, true, messages);
+                for (std::size_t k = 0; k < marks.size(); ++k) {
+                    messages[marks[k]]["content"] = std::move(contents[k]);
+                }
+            } else {
+                body = request_prefix_.build(system_prompt, false, messages);
+            }
+        }
+        build_perf.stop();
+        timing.build += clock::now() - build_start;
+
+        if (config_.report_request_prefix) {
+            auto const common = prefix_monitor_.observe(body);
+            std::cerr << std::format(
+                "[request prefix: {} of {} bytes same as the last request]\n",
+                common,
+                body.size());
+        }
 
-        auto result = send_api_request(request);
+        // At temperature 0 an identical body has one answer, so a
+        // stored response stands in for the request.
+        auto const key = response_cache_
+            ? std::optional{response_key(body)}
+            : std::nullopt;
+        auto cached = std::optional<nlohmann::json>{};
+        if (key) {
+            auto const span = TraceSpan("cache.lookup");
+            cached = response_cache_->lookup(*key);
+        }
+        auto result = cached
+            ? Result<nlohmann::json>{std::move(*cached)}
+            : send_api_request(std::move(body), timing);
         if (not result) {
             return make_error("{}", result.error());
         }
+        if (i == 0) {
+            timing.first_response = clock::now() - turn_start;
+        }
 
-        debug_json("response", *result);
+        if (cached) {
+            if (not usage) {
+                usage = TokenUsage{};
+            }
+            usage->replayed_requests += ReplayedRequests{1u};
+        } else {
+            if (key and result->contains("choices")) {
+                (void)response_cache_->store(*key, *result);
+            }
+            if (result->contains("usage")) {
+                if (not usage) {
+                    usage = TokenUsage{};
+                }
+                *usage += parse_usage((*result)["usage"]);
+            }
+        }
 
         auto const & choice = (*result)["choices"][0];
         auto const & message = choice["message"];
@@ -588,26 +873,77 @@ do_send_message(
         if (message.contains("tool_calls")
             and not message["tool_calls"].empty())
         {
-            messages.push_back(message);
-
-            for (auto const & tc :
-                 message["tool_calls"])
-            {
-                auto name =
-                    tc["function"]["name"]
-                        .get<std::string>();
-                auto args = nlohmann::json::parse(
-                    tc["function"]["arguments"]
-                        .get<std::string>());
-
-                auto output =
-                    dispatch_tool(name, args);
+            auto const parse_start = clock::now();
+            auto parse_perf = PerfScope("parse");
+            auto const request_message =
+                conversation::parse_message(message);
+            messages.push_back(conversation::to_json(request_message));
+            tool_messages.push_back(request_message);
+
+            // Review all calls of this message together so the
+            // user is asked at most once per assistant turn.
+            std::vector<tools::ToolCall> calls;
+            for (auto const & call : request_message.calls()) {
+                calls.push_back(tools::ToolCall{
+                    .name = call.name,
+                    .arguments = nlohmann::json::parse(call.arguments)});
+            }
+            parse_perf.stop();
+            auto const parsed = clock::now();
+            timing.parse += parsed - parse_start;
+            Tracer::record("parse", parse_start, parsed);
+            auto const approvals = [this, &calls] {
+                auto const span = TraceSpan("approve");
+                return approver_.review(calls);
+            }();
+            auto const context = ToolContext{
+                .build_tool = build_tool_,
+                .outputs = blob_store_,
+                .limits = config_.tool_limits,
+                .compaction = config_.tool_output_compaction,
+                .max_read_bytes =
+                    std::max(config_.tool_output_spill.threshold,
+                             std::size_t{4096}),
+                .reads = config_.diff_rereads ? &reads : nullptr};
+
+            for (std::size_t j = 0; j < calls.size(); ++j) {
+                std::string output;
+                if (not approvals[j].approved) {
+                    output = approvals[j].reason;
+                } else {
+                    auto const tool_start = clock::now();
+                    auto tool_perf = PerfScope("tool", calls[j].name);
+                    output = dispatch_tool(
+                        calls[j].name,
+                        calls[j].arguments,
+                        context);
+                    tool_perf.stop();
+                    auto const tool_end = clock::now();
+                    auto const elapsed = tool_end - tool_start;
+                    Tracer::record(
+                        "tool", tool_start, tool_end, calls[j].name);
+                    timing.tools += elapsed;
+                    timing.tool_calls.push_back(ToolTiming{
+                        .name = calls[j].name,
+                        .elapsed = elapsed});
+                }
+                // A read_output page is already bounded by
+                // max_read_bytes; spilling it would only store it
+                // again under a new handle.
+                if (calls[j].name != "read_output") {
+                    tools::spill_output(
+                        output, blob_store_, config_.tool_output_spill);
+                }
+                // Binary or mangled output would make the next
+                // request fail to serialize.
+                tools::sanitize_utf8(output, config_.tool_output_utf8);
                 std::cerr << output << std::endl;
 
-                messages.push_back(
-                    {{"role", "tool"},
-                     {"tool_call_id", tc["id"]},
-                     {"content", output}});
+                auto result_message = conversation::Message::tool_result(
+                    request_message.calls()[j].id,
+                    conversation::MessageText{std::move(output)});
+                messages.push_back(conversation::to_json(result_message));
+                tool_messages.push_back(std::move(result_message));
             }
             continue;
         }
@@ -619,10 +955,23 @@ do_send_message(
                         .get<std::string>()
                         .empty())
         {
-            return parse_response(*result);
+            auto const parse_start = clock::now();
+            auto parse_perf = PerfScope("parse");
+            auto response = parse_response(*result);
+            parse_perf.stop();
+            auto const parsed = clock::now();
+            timing.parse += parsed - parse_start;
+            Tracer::record("parse", parse_start, parsed);
+            if (response) {
+                response->usage = usage;
+                response->tool_messages = std::move(tool_messages);
+                response->timing = std::move(timing);
+            }
+            return response;
         }
 
         // Empty/null content: nudge the model
+        ++timing.retries;
         if (message.contains("content")) {
             messages.push_back(message);
         }
@@ -9,17 +9,32 @@
 
 #include "wjh/chat/Result.hpp"
 #include "wjh/chat/types.hpp"
-#include "wjh/chat/client/HttpClient.hpp"
 #include "wjh/chat/client/IClient.hpp"
+#include "wjh/chat/client/PromptCache.hpp"
+#include "wjh/chat/client/RequestPrefix.hpp"
+#include "wjh/chat/client/ResponseCache.hpp"
+#include "wjh/chat/client/Transport.hpp"
+#include "wjh/chat/tools/ApprovalPolicy.hpp"
+#include "wjh/chat/tools/BlobStore.hpp"
+#include "wjh/chat/tools/BuildTool.hpp"
+#include "wjh/chat/tools/OutputCompactor.hpp"
+#include "wjh/chat/tools/ResourceLimits.hpp"
+#include "wjh/chat/tools/Utf8.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <filesystem>
+#include <memory>
 #include <optional>
 
 namespace wjh::chat::client {
 
 /**
  * Configuration for the OpenRouter client.
+ *
+ * Without blob_dir and build_log_dir, spilled tool results and build
+ * logs go to the per-process default_blob_dir() and
+ * default_build_log_dir().
  */
 struct OpenRouterClientConfig
 {
@@ -28,6 +43,19 @@ struct OpenRouterClientConfig
     MaxTokens max_tokens;
     std::optional<SystemPrompt> system_prompt;
     std::optional<Temperature> temperature;
+    tools::ApprovalPolicy tool_policy{};
+    std::optional<std::filesystem::path> tool_audit_log{};
+    tools::ToolLimits tool_limits = tools::default_tool_limits();
+    tools::Utf8Options tool_output_utf8{};
+    tools::CompactOptions tool_output_compaction{};
+    tools::SpillOptions tool_output_spill{};
+    bool dedupe_tool_results = true;
+    bool diff_rereads = true;
+    PromptCacheMode prompt_cache = PromptCacheMode::automatic;
+    bool report_request_prefix = false; ///< Print prefix reuse to stderr.
+    ResponseCacheOptions response_cache{}; ///< Used at temperature 0.
+    std::optional<std::filesystem::path> blob_dir{}; ///< Spilled results.
+    std::optional<std::filesystem::path> build_log_dir{};
 };
 
 /**
@@ -40,8 +68,19 @@ class OpenRouterClient
 : public IClient
 {
 public:
+    /**
+     * Talk to the OpenRouter API over HTTPS.
+     */
     explicit OpenRouterClient(OpenRouterClientConfig config);
 
+    /**
+     * Send requests through the given transport instead, such as a
+     * recording or a replay.
+     */
+    OpenRouterClient(
+        OpenRouterClientConfig config,
+        std::unique_ptr<ITransport> transport);
+
     /**
      * Get the current model being used.
      */
@@ -55,14 +94,28 @@ private:
     Result<ChatResponse> do_send_message(
         conversation::Conversation const & conversation) override;
 
-    OpenRouterClientConfig config_;
-    HttpClient http_client_;
+    Result<AssistantResponse> do_complete(
+        conversation::Conversation const & conversation,
+        ModelId const & model) override;
+
+    TurnTiming do_failed_timing() const override;
 
     /**
-     * Build request JSON in OpenAI format.
+     * The agent loop of one turn, adding what it spends to timing.
      */
-    nlohmann::json build_request(
-        conversation::Conversation const & conversation) const;
+    Result<ChatResponse> run_turn(
+        conversation::Conversation const & conversation,
+        TurnTiming & timing);
+
+    OpenRouterClientConfig config_;
+    std::unique_ptr<ITransport> transport_;
+    tools::BuildTool build_tool_;
+    tools::BlobStore blob_store_;
+    tools::Approver approver_;
+    RequestPrefix request_prefix_;
+    PrefixMonitor prefix_monitor_;
+    std::optional<ResponseCache> response_cache_;
+    TurnTiming failed_timing_{}; ///< Of the last turn, if it failed.
 
     /**
      * Parse response from OpenAI format to ChatResponse.
@@ -78,10 +131,12 @@ private:
         nlohmann::json const & request);
 
     /**
-     * Convert messages to OpenAI format.
+     * Send an already serialized request body, adding the time spent
+     * waiting, downloading, and parsing to timing.
      */
-    nlohmann::json convert_messages_to_openai(
-        conversation::Conversation const & conversation) const;
+    Result<nlohmann::json> send_api_request(
+        std::string body,
+        TurnTiming & timing);
 
     /**
      * Map OpenAI finish_reason to internal StopReason.
@@ -0,0 +1,369 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/PerfCounters.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace wjh::chat::client {
+
+namespace {
+
+struct ThreadTotals
+{
+    std::mutex mutex;
+    std::map<std::string, PerfPhase, std::less<>> phases{};
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadTotals>> all{};
+    std::array<std::atomic<bool>, perf_event_count> counted{};
+};
+
+Registry &
+registry()
+{
+    static auto instance = Registry{};
+    return instance;
+}
+
+// Registered on a thread's first scope; the registry keeps it alive.
+ThreadTotals &
+thread_totals()
+{
+    thread_local auto const totals = [] {
+        auto result = std::make_shared<ThreadTotals>();
+        auto & shared = registry();
+        auto const lock = std::lock_guard{shared.mutex};
+        shared.all.push_back(result);
+        return result;
+    }();
+    return *totals;
+}
+
+// The thread's counters, opened on first use and closed when the
+// thread exits; null if they cannot be opened.
+PerfGroup const *
+thread_group()
+{
+    thread_local auto const group = [] {
+        auto result = PerfGroup::open();
+        return result ? std::optional{std::move(*result)} : std::nullopt;
+    }();
+    return group ? &*group : nullptr;
+}
+
+#if defined(__linux__)
+
+struct EventSpec
+{
+    PerfEvent event;
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+// task_clock first: it leads the group, since it always opens.
+constexpr auto event_specs = std::array<EventSpec, perf_event_count>{{
+    {PerfEvent::task_clock, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+    {PerfEvent::cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PerfEvent::instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PerfEvent::cache_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PerfEvent::branch_misses,
+     PERF_TYPE_HARDWARE,
+     PERF_COUNT_HW_BRANCH_MISSES},
+}};
+
+int
+open_event(EventSpec const & spec, int leader)
+{
+    auto attr = perf_event_attr{};
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.read_format = PERF_FORMAT_GROUP
+        | PERF_FORMAT_TOTAL_TIME_ENABLED
+        | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(::syscall(
+        SYS_perf_event_open, &attr, 0, -1, leader, PERF_FLAG_FD_CLOEXEC));
+}
+
+#endif
+
+} // anonymous namespace
+
+std::string_view
+to_string(PerfEvent event)
+{
+    switch (event) {
+    case PerfEvent::task_clock:
+        return "task_clock";
+    case PerfEvent::cycles:
+        return "cycles";
+    case PerfEvent::instructions:
+        return "instructions";
+    case PerfEvent::cache_misses:
+        return "cache_misses";
+    case PerfEvent::branch_misses:
+        return "branch_misses";
+    }
+    return "unknown";
+}
+
+// ------------------------------------------------------------------
+// PerfGroup
+// ------------------------------------------------------------------
+
+Result<PerfGroup>
+PerfGroup::
+open()
+{
+#if defined(__linux__)
+    auto group = PerfGroup{};
+    auto leader = -1;
+    for (auto const & spec : event_specs) {
+        auto const fd = open_event(spec, leader);
+        if (fd < 0) {
+            if (leader < 0) {
+                return make_error(
+                    "Cannot open perf counters: {}",
+                    std::system_category().message(errno));
+            }
+            continue; // Not exposed here; count the rest.
+        }
+        if (leader < 0) {
+            leader = fd;
+        }
+        group.fds_[static_cast<std::size_t>(spec.event)] = fd;
+        group.order_.push_back(spec.event);
+    }
+    return group;
+#else
+    return make_error("Perf counters need Linux perf_event_open");
+#endif
+}
+
+PerfGroup::
+PerfGroup(PerfGroup && other) noexcept
+: fds_(std::exchange(other.fds_, {-1, -1, -1, -1, -1}))
+, order_(std::move(other.order_))
+{ }
+
+PerfGroup &
+PerfGroup::
+operator = (PerfGroup && other) noexcept
+{
+    if (this != &other) {
+        auto old = std::move(*this);
+        fds_ = std::exchange(other.fds_, {-1, -1, -1, -1, -1});
+        order_ = std::move(other.order_);
+    }
+    return *this;
+}
+
+PerfGroup::
+~PerfGroup()
+{
+#if defined(__linux__)
+    // Members before the leader.
+    for (auto i = fds_.size(); i-- > 0;) {
+        if (fds_[i] >= 0) {
+            ::close(fds_[i]);
+        }
+    }
+#endif
+}
+
+bool
+PerfGroup::
+counts(PerfEvent event) const
+{
+    return fds_[static_cast<std::size_t>(event)] >= 0;
+}
+
+PerfCounts
+PerfGroup::
+read() const
+{
+    auto result = PerfCounts{};
+#if defined(__linux__)
+    if (order_.empty()) {
+        return result;
+    }
+    // nr, time_enabled, time_running, then one value per event.
+    auto buffer = std::array<std::uint64_t, 3 + perf_event_count>{};
+    auto const leader = fds_[static_cast<std::size_t>(order_.front())];
+    auto const size = ::read(leader, buffer.data(), sizeof(buffer));
+    if (size < static_cast<ssize_t>(3 * sizeof(std::uint64_t))) {
+        return result;
+    }
+    auto const events = std::min<std::size_t>(buffer[0], order_.size());
+    auto const enabled = buffer[1];
+    auto const running = buffer[2];
+    for (std::size_t i = 0; i < events; ++i) {
+        auto value = buffer[3 + i];
+        if (running > 0 and running < enabled) {
+            value = static_cast<std::uint64_t>(
+                static_cast<long double>(value) * enabled / running);
+        }
+        result[order_[i]] = value;
+    }
+#endif
+    return result;
+}
+
+// ------------------------------------------------------------------
+// PerfCounters
+// ------------------------------------------------------------------
+
+std::atomic<bool> PerfCounters::enabled_{false};
+
+Result<std::vector<PerfEvent>>
+PerfCounters::
+start()
+{
+    auto const * group = thread_group();
+    if (group == nullptr) {
+        // Report why, from a throwaway group.
+        auto opened = PerfGroup::open();
+        return make_error(
+            "{}",
+            opened ? std::string{"Cannot open perf counters"}
+                   : opened.error());
+    }
+    auto events = std::vector<PerfEvent>{};
+    auto & shared = registry();
+    for (std::size_t i = 0; i < perf_event_count; ++i) {
+        auto const event = static_cast<PerfEvent>(i);
+        shared.counted[i].store(
+            group->counts(event), std::memory_order_relaxed);
+        if (group->counts(event)) {
+            events.push_back(event);
+        }
+    }
+    reset();
+    enabled_.store(true, std::memory_order_relaxed);
+    return events;
+}
+
+void
+PerfCounters::
+stop()
+{
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+void
+PerfCounters::
+reset()
+{
+    auto & shared = registry();
+    auto const lock = std::lock_guard{shared.mutex};
+    for (auto const & totals : shared.all) {
+        auto const totals_lock = std::lock_guard{totals->mutex};
+        totals->phases.clear();
+    }
+}
+
+std::vector<PerfPhase>
+PerfCounters::
+snapshot()
+{
+    auto merged = std::map<std::string, PerfPhase, std::less<>>{};
+    {
+        auto & shared = registry();
+        auto const lock = std::lock_guard{shared.mutex};
+        for (auto const & totals : shared.all) {
+            auto const totals_lock = std::lock_guard{totals->mutex};
+            for (auto const & [name, phase] : totals->phases) {
+                auto & into = merged[name];
+                into.name = name;
+                into.calls += phase.calls;
+                into.counts += phase.counts;
+            }
+        }
+    }
+    auto result = std::vector<PerfPhase>{};
+    result.reserve(merged.size());
+    for (auto & entry : merged) {
+        result.push_back(std::move(entry.second));
+    }
+    return result;
+}
+
+bool
+PerfCounters::
+counted(PerfEvent event)
+{
+    return registry().counted[static_cast<std::size_t>(event)].load(
+        std::memory_order_relaxed);
+}
+
+void
+PerfCounters::
+record(
+    std::string_view phase,
+    std::string_view detail,
+    PerfCounts const & counts)
+{
+    auto name = std::string(phase);
+    if (not detail.empty()) {
+        name += '/';
+        name += detail;
+    }
+    auto & totals = thread_totals();
+    auto const lock = std::lock_guard{totals.mutex};
+    auto found = totals.phases.find(name);
+    if (found == totals.phases.end()) {
+        found = totals.phases
+            .emplace(name, PerfPhase{.name = name})
+            .first;
+    }
+    ++found->second.calls;
+    found->second.counts += counts;
+}
+
+// ------------------------------------------------------------------
+// PerfScope
+// ------------------------------------------------------------------
+
+void
+PerfScope::
+begin()
+{
+    group_ = thread_group();
+    if (group_ == nullptr) {
+        phase_ = nullptr;
+        return;
+    }
+    start_ = group_->read();
+}
+
+void
+PerfScope::
+end()
+{
+    PerfCounters::record(phase_, detail_, group_->read().since(start_));
+}
+
+} // namespace wjh::chat::client
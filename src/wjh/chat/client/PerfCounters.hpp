@@ -0,0 +1,238 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_6329461F0D744890861A2CFBD2180F44
+#define WJH_CHAT_6329461F0D744890861A2CFBD2180F44
+
+#include "wjh/chat/Result.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::client {
+
+/**
+ * What a PerfGroup counts.  task_clock is the thread's CPU time in
+ * nanoseconds, a software counter that works where the hardware ones
+ * are hidden (most VMs and containers).
+ */
+enum class PerfEvent : std::size_t
+{
+    task_clock,
+    cycles,
+    instructions,
+    cache_misses,
+    branch_misses,
+};
+
+inline constexpr std::size_t perf_event_count = 5;
+
+/**
+ * Short name of an event, e.g. "cache_misses".
+ */
+[[nodiscard]]
+std::string_view to_string(PerfEvent event);
+
+/**
+ * One reading, or the difference of two, of every event.  Events that
+ * could not be counted stay zero.
+ */
+struct PerfCounts
+{
+    std::array<std::uint64_t, perf_event_count> values{};
+
+    [[nodiscard]]
+    std::uint64_t operator [] (PerfEvent event) const
+    {
+        return values[static_cast<std::size_t>(event)];
+    }
+
+    std::uint64_t & operator [] (PerfEvent event)
+    {
+        return values[static_cast<std::size_t>(event)];
+    }
+
+    PerfCounts & operator += (PerfCounts const & other)
+    {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            values[i] += other.values[i];
+        }
+        return *this;
+    }
+
+    /**
+     * Counts between an earlier reading and this one.  A counter that
+     * seems to run backwards, which scaling for multiplexing can cause,
+     * gives zero.
+     */
+    [[nodiscard]]
+    PerfCounts since(PerfCounts const & earlier) const
+    {
+        auto result = PerfCounts{};
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            result.values[i] = values[i] > earlier.values[i]
+                ? values[i] - earlier.values[i]
+                : 0;
+        }
+        return result;
+    }
+};
+
+/**
+ * The calling thread's counters, opened with Linux perf_event_open as
+ * one group so they start and stop together.
+ *
+ * Only user-space events are counted, which perf_event_paranoid allows
+ * up to level 2.  Hardware events the machine does not expose are
+ * left out; open() fails only when not even task_clock can be counted.
+ * When the kernel multiplexes the hardware counters, readings are
+ * scaled by the fraction of time the group was actually counting.
+ */
+class PerfGroup
+{
+public:
+    static Result<PerfGroup> open();
+
+    PerfGroup(PerfGroup && other) noexcept;
+    PerfGroup & operator = (PerfGroup && other) noexcept;
+    ~PerfGroup();
+
+    [[nodiscard]]
+    bool counts(PerfEvent event) const;
+
+    /**
+     * Totals since the group was opened.  Only the thread that opened
+     * the group may read it.
+     */
+    [[nodiscard]]
+    PerfCounts read() const;
+
+private:
+    PerfGroup() = default;
+
+    std::array<int, perf_event_count> fds_{-1, -1, -1, -1, -1};
+    std::vector<PerfEvent> order_{}; ///< Events in the group's read order.
+};
+
+/**
+ * Counters summed over every scope of one phase.
+ */
+struct PerfPhase
+{
+    std::string name; ///< The phase, then "/detail" if there was one.
+    std::uint64_t calls = 0;
+    PerfCounts counts{};
+};
+
+/**
+ * Process-wide hardware counters for the phases of a turn.
+ *
+ * Off by default; while off, a PerfScope costs one relaxed atomic
+ * load.  While on, each thread opens its own PerfGroup the first time
+ * it enters a scope and adds what each scope counted to its own
+ * totals, so scopes on different threads do not contend.
+ */
+class PerfCounters
+{
+public:
+    [[nodiscard]]
+    static bool enabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Open the calling thread's counters, drop any totals, and start
+     * counting.
+     *
+     * @return The events that can be counted on this machine.
+     */
+    static Result<std::vector<PerfEvent>> start();
+
+    /**
+     * Stop counting.  Totals are kept for snapshot().
+     */
+    static void stop();
+
+    /**
+     * Drop the totals and keep counting.
+     */
+    static void reset();
+
+    /**
+     * Totals of every phase so far, ordered by name.
+     */
+    [[nodiscard]]
+    static std::vector<PerfPhase> snapshot();
+
+    /**
+     * Whether start() found the event countable.
+     */
+    [[nodiscard]]
+    static bool counted(PerfEvent event);
+
+    static void record(
+        std::string_view phase,
+        std::string_view detail,
+        PerfCounts const & counts);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * RAII phase: counts from construction to destruction (or stop()),
+ * if counters were on at construction and the thread has them.
+ */
+class PerfScope
+{
+public:
+    explicit PerfScope(char const * phase, std::string_view detail = {})
+    : phase_(PerfCounters::enabled() ? phase : nullptr)
+    , detail_(detail)
+    {
+        if (phase_ != nullptr) {
+            begin();
+        }
+    }
+
+    ~PerfScope()
+    {
+        stop();
+    }
+
+    PerfScope(PerfScope const &) = delete;
+    PerfScope & operator = (PerfScope const &) = delete;
+
+    /**
+     * End the phase early; later calls do nothing.
+     */
+    void stop()
+    {
+        if (phase_ != nullptr) {
+            end();
+            phase_ = nullptr;
+        }
+    }
+
+private:
+    void begin();
+    void end();
+
+    char const * phase_;
+    std::string_view detail_; ///< Must outlive the scope.
+    PerfGroup const * group_ = nullptr;
+    PerfCounts start_{};
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_6329461F0D744890861A2CFBD2180F44
@@ -0,0 +1,160 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/PromptCache.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace wjh::chat::client {
+
+namespace {
+
+bool
+has_text(nlohmann::json const & message)
+{
+    auto const content = message.find("content");
+    if (content == message.end()) {
+        return false;
+    }
+    if (content->is_string()) {
+        return not content->get_ref<std::string const &>().empty();
+    }
+    return content->is_array() and not content->empty();
+}
+
+// Index of the last message before `end` that can carry a breakpoint.
+std::optional<std::size_t>
+last_with_text(nlohmann::json const & messages, std::size_t end)
+{
+    while (end > 0) {
+        --end;
+        if (has_text(messages[end])) {
+            return end;
+        }
+    }
+    return std::nullopt;
+}
+
+std::uint32_t
+count(nlohmann::json const & object, char const * key)
+{
+    auto const value = object.find(key);
+    return value != object.end() and value->is_number_unsigned()
+        ? value->get<std::uint32_t>()
+        : 0u;
+}
+
+} // anonymous namespace
+
+void
+add_cache_breakpoint(nlohmann::json & message)
+{
+    auto & content = message["content"];
+    if (content.is_string()) {
+        content = nlohmann::json::array(
+            {{{"type", "text"}, {"text", content.get<std::string>()}}});
+    }
+    content.back()["cache_control"] = {{"type", "ephemeral"}};
+}
+
+Result<PromptCacheMode>
+parse_prompt_cache_mode(std::string_view spec)
+{
+    if (spec == "off") {
+        return PromptCacheMode::off;
+    }
+    if (spec == "auto") {
+        return PromptCacheMode::automatic;
+    }
+    if (spec == "on") {
+        return PromptCacheMode::on;
+    }
+    return make_error("'{}' (expected off, auto, or on)", spec);
+}
+
+bool
+wants_cache_breakpoints(PromptCacheMode mode, ModelId const & model)
+{
+    if (mode != PromptCacheMode::automatic) {
+        return mode == PromptCacheMode::on;
+    }
+    std::string_view const id = json_value(model);
+    return id.starts_with("anthropic/") or id.starts_with("google/gemini");
+}
+
+std::vector<std::size_t>
+cache_breakpoints(nlohmann::json const & messages)
+{
+    auto result = std::vector<std::size_t>{};
+    if (not messages.empty() and messages[0].value("role", "") == "system"
+        and has_text(messages[0]))
+    {
+        result.push_back(0);
+    }
+
+    // The history of earlier turns ends just before the newest user
+    // message.
+    auto last_user = messages.size();
+    while (last_user > 0 and messages[last_user - 1].value("role", "")
+           != "user")
+    {
+        --last_user;
+    }
+    auto const first = result.size();
+    for (auto const end :
+         {last_user == 0 ? std::size_t{0} : last_user - 1, messages.size()})
+    {
+        auto const index = last_with_text(messages, end);
+        if (index and *index >= first
+            and (result.size() == first or result.back() != *index))
+        {
+            result.push_back(*index);
+        }
+    }
+    return result;
+}
+
+std::size_t
+add_cache_breakpoints(nlohmann::json & messages)
+{
+    auto const indices = cache_breakpoints(messages);
+    for (auto const index : indices) {
+        add_cache_breakpoint(messages[index]);
+    }
+    return indices.size();
+}
+
+TokenUsage
+parse_usage(nlohmann::json const & usage)
+{
+    auto result = TokenUsage{
+        .prompt_tokens = PromptTokens{count(usage, "prompt_tokens")},
+        .completion_tokens =
+            CompletionTokens{count(usage, "completion_tokens")},
+        .total_tokens = TotalTokens{count(usage, "total_tokens")},
+        .cached_tokens = CachedTokens{count(usage, "cache_read_input_tokens")},
+        .cache_write_tokens = CacheWriteTokens{
+            count(usage, "cache_creation_input_tokens")}};
+
+    auto const details = usage.find("prompt_tokens_details");
+    if (details != usage.end() and details->is_object()) {
+        if (details->contains("cached_tokens")) {
+            result.cached_tokens =
+                CachedTokens{count(*details, "cached_tokens")};
+        }
+        if (details->contains("cache_write_tokens")) {
+            result.cache_write_tokens =
+                CacheWriteTokens{count(*details, "cache_write_tokens")};
+        }
+    }
+    return result;
+}
+
+} // namespace wjh::chat::client
@@ -0,0 +1,89 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_8C15E3F2A9D04B7C9E61F0A4B3D2C718
+#define WJH_CHAT_8C15E3F2A9D04B7C9E61F0A4B3D2C718
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/TokenUsage.hpp"
+#include "wjh/chat/types.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::client {
+
+/**
+ * When requests carry prompt-cache breakpoints.
+ */
+enum class PromptCacheMode
+{
+    off,
+    automatic, ///< Only for models that need explicit breakpoints.
+    on
+};
+
+/**
+ * Parse PROMPT_CACHE: "off", "auto", or "on".
+ */
+[[nodiscard]]
+Result<PromptCacheMode> parse_prompt_cache_mode(std::string_view spec);
+
+/**
+ * Whether requests to a model should carry cache breakpoints.
+ *
+ * OpenAI-style providers cache long prefixes on their own; Anthropic
+ * and Gemini models cache only up to a marked breakpoint, so
+ * `automatic` marks requests only for those.
+ */
+[[nodiscard]]
+bool wants_cache_breakpoints(PromptCacheMode mode, ModelId const & model);
+
+/**
+ * Put a cache breakpoint at the end of one OpenAI-format message,
+ * turning string content into a single text part.
+ */
+void add_cache_breakpoint(nlohmann::json & message);
+
+/**
+ * Mark the stable prefix of OpenAI-format messages as cacheable.
+ *
+ * Places up to three `cache_control` breakpoints: on the system
+ * message, which also covers the tool definitions sent before it; on
+ * the last message of the history from earlier turns; and on the last
+ * message, so the next request of the same turn reads everything
+ * before its new tool results from the cache.  String content of a
+ * marked message becomes a single text part.  Messages with no text,
+ * such as tool calls without commentary, are skipped for the nearest
+ * earlier message with text.
+ *
+ * @return Number of breakpoints placed.
+ */
+std::size_t add_cache_breakpoints(nlohmann::json & messages);
+
+/**
+ * Indices of the messages add_cache_breakpoints() would mark, in
+ * order, so a caller can mark them in place and restore them after.
+ */
+[[nodiscard]]
+std::vector<std::size_t> cache_breakpoints(nlohmann::json const & messages);
+
+/**
+ * Token usage from the `usage` object of a chat completion.
+ *
+ * Cached and cache-write counts are read from the OpenAI-style
+ * `prompt_tokens_details` or, failing that, from Anthropic's
+ * `cache_read_input_tokens` and `cache_creation_input_tokens`.
+ */
+[[nodiscard]]
+TokenUsage parse_usage(nlohmann::json const & usage);
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_8C15E3F2A9D04B7C9E61F0A4B3D2C718
@@ -0,0 +1,85 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/RequestPrefix.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+#include "wjh/chat/client/PromptCache.hpp"
+
+#include <algorithm>
+
+namespace wjh::chat::client {
+
+RequestPrefix::
+RequestPrefix(nlohmann::json const & settings, nlohmann::json const & tools)
+{
+    // nlohmann::json keeps object keys sorted, so the same settings
+    // always serialize the same way; only the order of the top-level
+    // fields below is chosen here.
+    head_ = settings.dump();
+    head_.pop_back();
+    if (head_.size() > 1) {
+        head_ += ',';
+    }
+    head_ += "\"tools\":";
+    head_ += tools.dump();
+    head_ += ",\"messages\":[";
+}
+
+std::string
+RequestPrefix::
+build(
+    std::optional<SystemPrompt> const & system,
+    bool mark_system,
+    nlohmann::json const & messages)
+{
+    if (system and (system != system_prompt_ or mark_system != system_marked_))
+    {
+        auto message = nlohmann::json{
+            {"role", "system"},
+            {"content", json_value(*system)}};
+        if (mark_system) {
+            add_cache_breakpoint(message);
+        }
+        system_ = message.dump();
+        system_prompt_ = system;
+        system_marked_ = mark_system;
+    }
+
+    std::string body = head_;
+    auto first = true;
+    if (system) {
+        body += system_;
+        first = false;
+    }
+    for (auto const & message : messages) {
+        if (not first) {
+            body += ',';
+        }
+        body += message.dump();
+        first = false;
+    }
+    body += "]}";
+    return body;
+}
+
+std::size_t
+common_prefix(std::string_view a, std::string_view b)
+{
+    auto const end = std::ranges::mismatch(a, b).in1;
+    return static_cast<std::size_t>(end - a.begin());
+}
+
+std::size_t
+PrefixMonitor::
+observe(std::string_view body)
+{
+    auto const common = common_prefix(previous_, body);
+    previous_.assign(body);
+    return common;
+}
+
+} // namespace wjh::chat::client
@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_2F6D0B8E4A1C4D93B57E8A2C61F0D3B9
+#define WJH_CHAT_2F6D0B8E4A1C4D93B57E8A2C61F0D3B9
+
+#include "wjh/chat/types.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::client {
+
+/**
+ * Serializes chat requests so that the parts that do not change
+ * between requests lead the body, byte for byte.
+ *
+ * The request settings and tool definitions are serialized once, at
+ * construction, followed by the system message, which is serialized
+ * again only when the prompt changes.  Messages follow in order.  A
+ * provider's prefix cache can then match everything up to the first
+ * message that differs from the previous request.
+ */
+class RequestPrefix
+{
+public:
+    /**
+     * @param settings Top-level fields other than tools and messages,
+     *     such as model and max_tokens.
+     * @param tools Tool definitions, in the order they are offered.
+     */
+    RequestPrefix(
+        nlohmann::json const & settings,
+        nlohmann::json const & tools);
+
+    /**
+     * Serialize a request body.
+     *
+     * @param system System prompt sent as the first message, if any.
+     * @param mark_system Put a cache breakpoint on the system message.
+     * @param messages OpenAI-format messages after the system message.
+     */
+    [[nodiscard]]
+    std::string build(
+        std::optional<SystemPrompt> const & system,
+        bool mark_system,
+        nlohmann::json const & messages);
+
+private:
+    std::string head_; ///< Settings, tools, and the opening of messages.
+    std::optional<SystemPrompt> system_prompt_;
+    bool system_marked_ = false;
+    std::string system_; ///< Serialized system message.
+};
+
+/**
+ * Number of leading bytes two strings have in common.
+ */
+[[nodiscard]]
+std::size_t common_prefix(std::string_view a, std::string_view b);
+
+/**
+ * Tracks how much of each request body repeats the previous one.
+ */
+class PrefixMonitor
+{
+public:
+    /**
+     * Remember body as the latest request.
+     *
+     * @return Length of its common prefix with the previous request.
+     */
+    std::size_t observe(std::string_view body);
+
+private:
+    std::string previous_;
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_2F6D0B8E4A1C4D93B57E8A2C61F0D3B9
@@ -0,0 +1,199 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/ResponseCache.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+#include "wjh/chat/tools/ContentHash.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <unistd.h>
+
+namespace wjh::chat::client {
+
+namespace {
+
+constexpr std::string_view extension = ".cbor";
+constexpr std::string_view temp_extension = ".tmp";
+
+// A temporary file this old was left by a writer that died.
+constexpr auto stale_temp_age = std::chrono::minutes{10};
+
+// Numbers the temporary files of this process.
+std::atomic<std::uint64_t> temp_counter{0};
+
+// Offset basis for the check hash, different from content_hash's own.
+constexpr std::uint64_t check_seed = 0x9e3779b97f4a7c15u;
+
+struct Entry
+{
+    std::filesystem::file_time_type used{};
+    std::uintmax_t size = 0;
+    std::filesystem::path path{};
+};
+
+} // anonymous namespace
+
+ResponseKey
+response_key(std::string_view body)
+{
+    return ResponseKey{
+        .digest = tools::content_digest(body),
+        .check = tools::content_hash(body, check_seed),
+        .size = body.size()};
+}
+
+bool
+is_deterministic(std::optional<Temperature> const & temperature)
+{
+    return temperature and json_value(*temperature) <= 0.0f;
+}
+
+ResponseCache::
+ResponseCache(std::filesystem::path dir, std::size_t max_bytes)
+: dir_(std::move(dir))
+, max_bytes_(max_bytes)
+{ }
+
+std::filesystem::path
+ResponseCache::
+path_of(ResponseKey const & key) const
+{
+    return dir_ / (key.digest + std::string(extension));
+}
+
+std::optional<nlohmann::json>
+ResponseCache::
+lookup(ResponseKey const & key) const
+{
+    auto const path = path_of(key);
+    std::ifstream file(path, std::ios::binary);
+    if (not file) {
+        return std::nullopt;
+    }
+    std::vector<std::uint8_t> const bytes(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+
+    auto entry = nlohmann::json::from_cbor(bytes, true, false);
+    if (not entry.is_object() or not entry.contains("response")
+        or entry.value("check", std::uint64_t{}) != key.check
+        or entry.value("size", std::size_t{}) != key.size)
+    {
+        return std::nullopt;
+    }
+
+    std::error_code ec;
+    std::filesystem::last_write_time(
+        path, std::filesystem::file_time_type::clock::now(), ec);
+    return std::move(entry["response"]);
+}
+
+bool
+ResponseCache::
+store(ResponseKey const & key, nlohmann::json const & response)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(dir_, ec);
+    if (ec) {
+        return false;
+    }
+
+    auto const bytes = nlohmann::json::to_cbor(nlohmann::json{
+        {"check", key.check},
+        {"size", key.size},
+        {"response", response}});
+
+    // Write under a temporary name so a partial entry is never read.
+    // The name is unique to this process and store, since the
+    // directory may be shared.
+    auto const path = path_of(key);
+    auto const tmp = std::format(
+        "{}.{}.{}{}",
+        path.string(),
+        getpid(),
+        temp_counter.fetch_add(1, std::memory_order_relaxed),
+        temp_extension);
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        out.write(
+            reinterpret_cast<char const *>(bytes.data()),
+            static_cast<std::streamsize>(bytes.size()));
+        if (not out) {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+
+    evict();
+    return true;
+}
+
+void
+ResponseCache::
+evict() const
+{
+    std::error_code ec;
+    std::vector<Entry> entries;
+    std::uintmax_t total = 0;
+    auto const stale = std::filesystem::file_time_type::clock::now()
+        - stale_temp_age;
+    for (auto const & item : std::filesystem::directory_iterator(dir_, ec)) {
+        auto const ext = item.path().extension();
+        if (ext != extension and ext != temp_extension) {
+            continue;
+        }
+        std::error_code time_ec;
+        std::error_code size_ec;
+        auto entry = Entry{
+            .used = item.last_write_time(time_ec),
+            .size = item.file_size(size_ec),
+            .path = item.path()};
+        if (time_ec) {
+            continue;
+        }
+        if (ext == temp_extension) {
+            // Another store may still be writing a recent one.
+            if (entry.used < stale) {
+                std::error_code remove_ec;
+                std::filesystem::remove(entry.path, remove_ec);
+            }
+            continue;
+        }
+        if (not size_ec) {
+            total += entry.size;
+            entries.push_back(std::move(entry));
+        }
+    }
+    if (total <= max_bytes_) {
+        return;
+    }
+
+    std::ranges::sort(entries, {}, &Entry::used);
+    for (auto const & entry : entries) {
+        if (total <= max_bytes_) {
+            break;
+        }
+        std::error_code remove_ec;
+        if (std::filesystem::remove(entry.path, remove_ec)) {
+            total -= entry.size;
+        }
+    }
+}
+
+} // namespace wjh::chat::client
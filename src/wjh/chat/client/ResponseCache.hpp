@@ -0,0 +1,109 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_5D9A3E71C20B4F8E96B1A7D4E0C3F582
+#define WJH_CHAT_5D9A3E71C20B4F8E96B1A7D4E0C3F582
+
+#include "wjh/chat/types.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::client {
+
+/**
+ * Where the response cache lives and how large it may grow.
+ */
+struct ResponseCacheOptions
+{
+    std::optional<std::filesystem::path> dir{}; ///< Unset = no cache.
+    std::size_t max_bytes = 64u << 20;
+};
+
+/**
+ * Identity of a request body.
+ *
+ * The digest names the cache entry; a second hash and the length are
+ * stored with it and checked on lookup, so a digest collision reads as
+ * a miss rather than a wrong answer.
+ */
+struct ResponseKey
+{
+    std::string digest;
+    std::uint64_t check = 0;
+    std::size_t size = 0;
+};
+
+[[nodiscard]]
+ResponseKey response_key(std::string_view body);
+
+/**
+ * Whether requests at this temperature have one right answer to cache.
+ * Only an explicit temperature of zero qualifies; without one, the
+ * provider's default applies.
+ */
+[[nodiscard]]
+bool is_deterministic(std::optional<Temperature> const & temperature);
+
+/**
+ * Exact-match cache of API responses on disk.
+ *
+ * Each response is stored as CBOR in a file named by the digest of the
+ * request body that produced it.  A hit refreshes the file's
+ * modification time, and storing evicts the least recently used files
+ * once the directory holds more than max_bytes of entries, along with
+ * temporary files left by writers that died.  Failures
+ * to read or write are treated as misses: the cache never fails a
+ * request.
+ */
+class ResponseCache
+{
+public:
+    /**
+     * @param dir Directory for entries (created on demand); may be
+     *     shared by several processes.
+     * @param max_bytes Size the entries are trimmed to after a store.
+     */
+    ResponseCache(std::filesystem::path dir, std::size_t max_bytes);
+
+    /**
+     * The response stored for a request, if any.
+     */
+    [[nodiscard]]
+    std::optional<nlohmann::json> lookup(ResponseKey const & key) const;
+
+    /**
+     * Store the response to a request, then evict old entries.
+     *
+     * @return Whether the entry was written.
+     */
+    bool store(ResponseKey const & key, nlohmann::json const & response);
+
+    [[nodiscard]]
+    std::filesystem::path const & dir() const
+    {
+        return dir_;
+    }
+
+private:
+    [[nodiscard]]
+    std::filesystem::path path_of(ResponseKey const & key) const;
+
+    void evict() const;
+
+    std::filesystem::path dir_;
+    std::size_t max_bytes_;
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_5D9A3E71C20B4F8E96B1A7D4E0C3F582
@@ -0,0 +1,180 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/Tracer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace wjh::chat::client {
+
+namespace {
+
+struct Span
+{
+    char const * name = nullptr;
+    std::string detail{};
+    Tracer::clock::time_point start{};
+    Tracer::clock::time_point end{};
+    std::size_t thread = 0;
+};
+
+struct ThreadBuffer
+{
+    std::mutex mutex;
+    std::vector<Span> spans{};
+    std::size_t thread = 0;
+};
+
+struct Buffers
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> all{};
+    Tracer::clock::time_point origin{};
+};
+
+Buffers &
+buffers()
+{
+    static auto instance = Buffers{};
+    return instance;
+}
+
+// Registered on a thread's first span; the registry keeps it alive.
+ThreadBuffer &
+thread_buffer()
+{
+    thread_local auto const buffer = [] {
+        auto result = std::make_shared<ThreadBuffer>();
+        auto & registry = buffers();
+        auto const lock = std::lock_guard{registry.mutex};
+        result->thread = registry.all.size() + 1;
+        registry.all.push_back(result);
+        return result;
+    }();
+    return *buffer;
+}
+
+double
+microseconds(Tracer::clock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+} // anonymous namespace
+
+std::atomic<bool> Tracer::enabled_{false};
+
+void
+Tracer::
+start()
+{
+    auto & registry = buffers();
+    auto const lock = std::lock_guard{registry.mutex};
+    for (auto const & buffer : registry.all) {
+        auto const buffer_lock = std::lock_guard{buffer->mutex};
+        buffer->spans.clear();
+    }
+    registry.origin = clock::now();
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void
+Tracer::
+stop()
+{
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+void
+Tracer::
+record(
+    char const * name,
+    clock::time_point start,
+    clock::time_point end,
+    std::string_view detail)
+{
+    if (not enabled()) {
+        return;
+    }
+    auto & buffer = thread_buffer();
+    auto const lock = std::lock_guard{buffer.mutex};
+    buffer.spans.push_back(Span{
+        .name = name,
+        .detail = std::string(detail),
+        .start = start,
+        .end = end,
+        .thread = buffer.thread});
+}
+
+Result<std::size_t>
+Tracer::
+write(std::filesystem::path const & path)
+{
+    auto spans = std::vector<Span>{};
+    auto threads = std::size_t{0};
+    auto origin = clock::time_point{};
+    {
+        auto & registry = buffers();
+        auto const lock = std::lock_guard{registry.mutex};
+        origin = registry.origin;
+        threads = registry.all.size();
+        for (auto const & buffer : registry.all) {
+            auto const buffer_lock = std::lock_guard{buffer->mutex};
+            spans.insert(
+                spans.end(), buffer->spans.begin(), buffer->spans.end());
+        }
+    }
+    std::ranges::stable_sort(spans, {}, &Span::start);
+
+    auto events = nlohmann::json::array();
+    events.push_back(
+        {{"name", "process_name"},
+         {"ph", "M"},
+         {"pid", 1},
+         {"args", {{"name", "chat"}}}});
+    for (std::size_t thread = 1; thread <= threads; ++thread) {
+        events.push_back(
+            {{"name", "thread_name"},
+             {"ph", "M"},
+             {"pid", 1},
+             {"tid", thread},
+             {"args", {{"name", "thread " + std::to_string(thread)}}}});
+    }
+    for (auto const & span : spans) {
+        auto event = nlohmann::json{
+            {"name", span.name},
+            {"cat", "chat"},
+            {"ph", "X"},
+            {"ts", microseconds(span.start - origin)},
+            {"dur", microseconds(span.end - span.start)},
+            {"pid", 1},
+            {"tid", span.thread}};
+        if (not span.detail.empty()) {
+            event["args"] = {{"detail", span.detail}};
+        }
+        events.push_back(std::move(event));
+    }
+
+    auto const trace = nlohmann::json{
+        {"traceEvents", std::move(events)},
+        {"displayTimeUnit", "ms"}};
+    std::ofstream out(path, std::ios::trunc);
+    out << trace.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace)
+        << "\n";
+    if (not out) {
+        return make_error("Cannot write trace to '{}'", path.string());
+    }
+    return spans.size();
+}
+
+} // namespace wjh::chat::client
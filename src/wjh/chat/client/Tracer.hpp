@@ -0,0 +1,110 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_80625ED396DD4C7BBF307BD5DD362869
+#define WJH_CHAT_80625ED396DD4C7BBF307BD5DD362869
+
+#include "wjh/chat/Result.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace wjh::chat::client {
+
+/**
+ * Records spans (named intervals) from any thread and writes them as
+ * Chrome trace-event JSON, which Perfetto and chrome://tracing load.
+ *
+ * The tracer is process-wide and off by default.  While it is off, a
+ * span costs one relaxed atomic load, so the calls stay in production
+ * code.  While it is on, each thread appends finished spans to its own
+ * buffer; the buffer's lock is only ever contended by write().
+ * Buffers outlive their threads, so spans from short-lived threads
+ * (e.g. a background summary) are kept.
+ *
+ * Span names must be string literals, since only the pointer is kept;
+ * the detail (e.g. a tool name) is copied.
+ */
+class Tracer
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    [[nodiscard]]
+    static bool enabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Drop any recorded spans and start recording.
+     */
+    static void start();
+
+    /**
+     * Stop recording.  Spans recorded so far are kept for write().
+     */
+    static void stop();
+
+    /**
+     * Record a span that has already ended, e.g. one whose bounds
+     * came from a transport's timestamps.  Ignored while disabled.
+     */
+    static void record(
+        char const * name,
+        clock::time_point start,
+        clock::time_point end,
+        std::string_view detail = {});
+
+    /**
+     * Write every recorded span to path as a Chrome trace.
+     *
+     * @return Number of spans written.
+     */
+    static Result<std::size_t> write(std::filesystem::path const & path);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * RAII span: from construction to destruction, if the tracer was
+ * enabled at construction.
+ */
+class TraceSpan
+{
+public:
+    explicit TraceSpan(char const * name, std::string_view detail = {})
+    : name_(Tracer::enabled() ? name : nullptr)
+    , detail_(detail)
+    {
+        if (name_ != nullptr) {
+            start_ = Tracer::clock::now();
+        }
+    }
+
+    ~TraceSpan()
+    {
+        if (name_ != nullptr) {
+            Tracer::record(name_, start_, Tracer::clock::now(), detail_);
+        }
+    }
+
+    TraceSpan(TraceSpan const &) = delete;
+    TraceSpan & operator = (TraceSpan const &) = delete;
+
+private:
+    char const * name_;
+    std::string_view detail_; ///< Must outlive the span.
+    Tracer::clock::time_point start_{};
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_80625ED396DD4C7BBF307BD5DD362869
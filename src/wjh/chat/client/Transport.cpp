@@ -0,0 +1,294 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/Transport.hpp"
+
+#include "wjh/chat/client/WireLog.hpp"
+#include "wjh/chat/json_convert.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <charconv>
+#include <iterator>
+#include <string>
+#include <thread>
+
+namespace wjh::chat::client {
+
+namespace {
+
+nlohmann::json
+headers_json(HttpHeaders const & headers)
+{
+    auto out = nlohmann::json::object();
+    for (auto const & [key, value] : headers) {
+        out[key] = value;
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+ITransport::
+~ITransport() = default;
+
+Result<Endpoint>
+parse_endpoint(std::string_view url)
+{
+    auto endpoint = Endpoint{};
+    if (url.starts_with("https://")) {
+        url.remove_prefix(8);
+    } else if (url.starts_with("http://")) {
+        url.remove_prefix(7);
+        endpoint.scheme = HttpScheme::http;
+        endpoint.port = PortNumber{80};
+    } else {
+        return make_error("'{}' (expected http:// or https://)", url);
+    }
+    if (url.ends_with('/')) {
+        url.remove_suffix(1);
+    }
+
+    auto const colon = url.rfind(':');
+    auto const host = url.substr(0, colon);
+    if (host.empty() or host.find('/') != std::string_view::npos) {
+        return make_error("'{}' (expected a host and optional port)", url);
+    }
+    endpoint.host = Hostname{std::string(host)};
+    if (colon != std::string_view::npos) {
+        auto const digits = url.substr(colon + 1);
+        int port = 0;
+        auto [ptr, ec] = std::from_chars(
+            digits.data(), digits.data() + digits.size(), port);
+        if (ec != std::errc{} or ptr != digits.data() + digits.size()
+            or port <= 0 or port > 65535)
+        {
+            return make_error("'{}' (invalid port)", digits);
+        }
+        endpoint.port = PortNumber{port};
+    }
+    return endpoint;
+}
+
+HttpTransport::
+HttpTransport(Endpoint const & endpoint)
+: client_(endpoint.host, endpoint.port, endpoint.scheme)
+{ }
+
+Result<HttpResponse>
+HttpTransport::
+do_post(
+    HttpPath const & path,
+    HttpBody const & body,
+    HttpHeaders const & headers)
+{
+    WireLog::log_request(path, headers, body);
+    auto result = client_.post(path, body, headers);
+    WireLog::log_response(result);
+    return result;
+}
+
+Result<std::unique_ptr<RecordingTransport>>
+RecordingTransport::
+open(
+    std::unique_ptr<ITransport> inner,
+    std::filesystem::path const & path)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    if (not out) {
+        return make_error("Cannot open recording {}", path.string());
+    }
+    return std::unique_ptr<RecordingTransport>(
+        new RecordingTransport(std::move(inner), std::move(out)));
+}
+
+RecordingTransport::
+RecordingTransport(std::unique_ptr<ITransport> inner, std::ofstream out)
+: inner_(std::move(inner))
+, out_(std::move(out))
+{ }
+
+Result<HttpResponse>
+RecordingTransport::
+do_post(
+    HttpPath const & path,
+    HttpBody const & body,
+    HttpHeaders const & headers)
+{
+    auto const start = std::chrono::steady_clock::now();
+    auto result = inner_->post(path, body, headers);
+    auto const elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+
+    auto line = nlohmann::json{
+        {"path", json_value(path)},
+        {"request", json_value(body)},
+        {"elapsed_us", elapsed.count()}};
+    if (result) {
+        line["status"] = json_value(result->status);
+        line["headers"] = headers_json(result->headers);
+        line["response"] = json_value(result->body);
+    } else {
+        line["error"] = result.error();
+    }
+    // Bodies may hold tool output that is not valid UTF-8.
+    out_ << line.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace)
+         << '\n'
+         << std::flush;
+    return result;
+}
+
+Result<ReplayPace>
+parse_replay_pace(std::string_view spec)
+{
+    if (spec == "fast") {
+        return ReplayPace::fast;
+    }
+    if (spec == "recorded") {
+        return ReplayPace::recorded;
+    }
+    return make_error("'{}' (expected fast or recorded)", spec);
+}
+
+ReplayTransport::
+ReplayTransport(ReplayPace pace)
+: pace_(pace)
+{ }
+
+Result<ReplayTransport>
+ReplayTransport::
+load(std::filesystem::path const & path, ReplayPace pace)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (not file) {
+        return make_error("Cannot open recording {}", path.string());
+    }
+    std::string const contents(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    auto replay = parse(contents, pace);
+    if (not replay) {
+        return make_error("{}: {}", path.string(), replay.error());
+    }
+    return replay;
+}
+
+Result<ReplayTransport>
+ReplayTransport::
+parse(std::string_view recording, ReplayPace pace)
+{
+    ReplayTransport replay(pace);
+    std::size_t line_number = 0;
+    while (not recording.empty()) {
+        auto const nl = recording.find('\n');
+        auto const line = recording.substr(0, nl);
+        recording.remove_prefix(
+            nl == std::string_view::npos ? recording.size() : nl + 1);
+        ++line_number;
+        if (line.find_first_not_of(" \t\r") == std::string_view::npos) {
+            continue;
+        }
+
+        try {
+            auto const json = nlohmann::json::parse(line);
+            auto exchange = Exchange{
+                .request = HttpBody{json.at("request").get<std::string>()},
+                .response = std::nullopt,
+                .error = json.value("error", std::string{}),
+                .elapsed = std::chrono::microseconds{
+                    json.value("elapsed_us", std::int64_t{})}};
+            if (not json.contains("error")) {
+                HttpResponse response;
+                response.status =
+                    HttpStatusCode{json.at("status").get<int>()};
+                response.body =
+                    HttpBody{json.at("response").get<std::string>()};
+                auto const headers =
+                    json.value("headers", nlohmann::json::object());
+                for (auto const & [key, value] : headers.items()) {
+                    response.headers.add(
+                        HeaderName{key},
+                        HeaderValue{value.get<std::string>()});
+                }
+                exchange.response = std::move(response);
+            }
+            replay.exchanges_.push_back(std::move(exchange));
+        } catch (nlohmann::json::exception const & e) {
+            return make_error("line {}: {}", line_number, e.what());
+        } catch (atlas::ConstraintError const & e) {
+            return make_error("line {}: {}", line_number, e.what());
+        }
+    }
+    return replay;
+}
+
+void
+ReplayTransport::
+rewind()
+{
+    next_ = 0;
+    mismatches_ = 0;
+}
+
+Result<HttpResponse>
+ReplayTransport::
+do_post(HttpPath const &, HttpBody const & body, HttpHeaders const &)
+{
+    if (next_ == exchanges_.size()) {
+        return make_error(
+            "Replay has no more recorded exchanges ({} served)",
+            exchanges_.size());
+    }
+    auto const & exchange = exchanges_[next_++];
+    if (body != exchange.request) {
+        ++mismatches_;
+    }
+    if (pace_ == ReplayPace::recorded) {
+        std::this_thread::sleep_for(exchange.elapsed);
+    }
+    if (not exchange.response) {
+        return make_error("{}", exchange.error);
+    }
+    return *exchange.response;
+}
+
+std::unique_ptr<ITransport>
+make_openrouter_transport(Endpoint const & endpoint)
+{
+    return std::make_unique<HttpTransport>(endpoint);
+}
+
+Result<std::unique_ptr<ITransport>>
+make_transport(TransportOptions const & options)
+{
+    if (options.replay) {
+        if (options.record) {
+            return make_error("Cannot record a replay");
+        }
+        auto replay = ReplayTransport::load(
+            *options.replay,
+            options.replay_pace);
+        if (not replay) {
+            return make_error("{}", replay.error());
+        }
+        return std::make_unique<ReplayTransport>(std::move(*replay));
+    }
+
+    auto transport = make_openrouter_transport(options.endpoint);
+    if (options.record) {
+        auto recorder = RecordingTransport::open(
+            std::move(transport),
+            *options.record);
+        if (not recorder) {
+            return make_error("{}", recorder.error());
+        }
+        return std::unique_ptr<ITransport>(std::move(*recorder));
+    }
+    return transport;
+}
+
+} // namespace wjh::chat::client
@@ -0,0 +1,245 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_E4B07C2D9A154F3B8C6D1E0A7F92B345
+#define WJH_CHAT_E4B07C2D9A154F3B8C6D1E0A7F92B345
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/client/HttpClient.hpp"
+#include "wjh/chat/client/types.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::client {
+
+/**
+ * Where the API is served.
+ */
+struct Endpoint
+{
+    HttpScheme scheme = HttpScheme::https;
+    Hostname host{"openrouter.ai"};
+    PortNumber port{443};
+};
+
+/**
+ * Parse OPENROUTER_URL: `http://` or `https://`, a host, and an
+ * optional port (80 or 443 by default).
+ */
+[[nodiscard]]
+Result<Endpoint> parse_endpoint(std::string_view url);
+
+/**
+ * How OpenRouterClient reaches the API.
+ *
+ * The live transport is an HttpClient; a recording can stand in for it
+ * so the request, parse, and tool path runs without the network.
+ *
+ * This interface uses the Non-Virtual Interface (NVI) pattern. Derived
+ * classes must override the private virtual do_post function.
+ */
+class ITransport
+{
+public:
+    virtual ~ITransport();
+
+    /**
+     * POST a request body and return the response.
+     */
+    [[nodiscard]]
+    Result<HttpResponse> post(
+        HttpPath const & path,
+        HttpBody const & body,
+        HttpHeaders const & headers)
+    {
+        return do_post(path, body, headers);
+    }
+
+private:
+    virtual Result<HttpResponse> do_post(
+        HttpPath const & path,
+        HttpBody const & body,
+        HttpHeaders const & headers) = 0;
+};
+
+/**
+ * The live API over HTTP(S).
+ */
+class HttpTransport
+: public ITransport
+{
+public:
+    explicit HttpTransport(Endpoint const & endpoint);
+
+private:
+    Result<HttpResponse> do_post(
+        HttpPath const & path,
+        HttpBody const & body,
+        HttpHeaders const & headers) override;
+
+    HttpClient client_;
+};
+
+/**
+ * Passes requests on to another transport and appends each exchange to
+ * a file, one JSON object per line: the path, request body, status,
+ * response body, and how long the exchange took (or the error, if
+ * there was no response).  Request headers, which carry the API key,
+ * are not recorded.
+ */
+class RecordingTransport
+: public ITransport
+{
+public:
+    /**
+     * Open (appending to) the recording.
+     */
+    [[nodiscard]]
+    static Result<std::unique_ptr<RecordingTransport>> open(
+        std::unique_ptr<ITransport> inner,
+        std::filesystem::path const & path);
+
+private:
+    RecordingTransport(
+        std::unique_ptr<ITransport> inner,
+        std::ofstream out);
+
+    Result<HttpResponse> do_post(
+        HttpPath const & path,
+        HttpBody const & body,
+        HttpHeaders const & headers) override;
+
+    std::unique_ptr<ITransport> inner_;
+    std::ofstream out_;
+};
+
+/**
+ * How fast a replay serves its responses.
+ */
+enum class ReplayPace
+{
+    fast, ///< At once.
+    recorded ///< After as long as the original exchange took.
+};
+
+/**
+ * Parse TRANSPORT_REPLAY_PACE: "fast" or "recorded".
+ */
+[[nodiscard]]
+Result<ReplayPace> parse_replay_pace(std::string_view spec);
+
+/**
+ * Serves the exchanges of a recording back in order.
+ *
+ * Requests are not matched against the recording, since tool output
+ * can differ from run to run; requests whose body differs from the
+ * recorded one are counted instead.  Once every exchange has been
+ * served, further requests fail.
+ */
+class ReplayTransport
+: public ITransport
+{
+public:
+    [[nodiscard]]
+    static Result<ReplayTransport> load(
+        std::filesystem::path const & path,
+        ReplayPace pace);
+
+    /**
+     * Parse recording text in the format RecordingTransport writes.
+     */
+    [[nodiscard]]
+    static Result<ReplayTransport> parse(
+        std::string_view recording,
+        ReplayPace pace);
+
+    /**
+     * Serve the recording again from the first exchange.
+     */
+    void rewind();
+
+    [[nodiscard]]
+    std::size_t size() const
+    {
+        return exchanges_.size();
+    }
+
+    /**
+     * Exchanges not yet served.
+     */
+    [[nodiscard]]
+    std::size_t remaining() const
+    {
+        return exchanges_.size() - next_;
+    }
+
+    /**
+     * Requests, since the last rewind, that differed from the recording.
+     */
+    [[nodiscard]]
+    std::size_t mismatches() const
+    {
+        return mismatches_;
+    }
+
+private:
+    struct Exchange
+    {
+        HttpBody request{};
+        std::optional<HttpResponse> response{}; ///< Unset on error.
+        std::string error{};
+        std::chrono::microseconds elapsed{};
+    };
+
+    explicit ReplayTransport(ReplayPace pace);
+
+    Result<HttpResponse> do_post(
+        HttpPath const & path,
+        HttpBody const & body,
+        HttpHeaders const & headers) override;
+
+    ReplayPace pace_;
+    std::vector<Exchange> exchanges_;
+    std::size_t next_ = 0;
+    std::size_t mismatches_ = 0;
+};
+
+/**
+ * Where requests go: the live API, optionally recorded, or a replay.
+ */
+struct TransportOptions
+{
+    Endpoint endpoint{}; ///< OPENROUTER_URL.
+    std::optional<std::filesystem::path> record{}; ///< TRANSPORT_RECORD.
+    std::optional<std::filesystem::path> replay{}; ///< TRANSPORT_REPLAY.
+    ReplayPace replay_pace = ReplayPace::fast;
+};
+
+/**
+ * The OpenRouter API, by default at https://openrouter.ai.
+ */
+[[nodiscard]]
+std::unique_ptr<ITransport> make_openrouter_transport(
+    Endpoint const & endpoint = Endpoint{});
+
+/**
+ * Build the transport the options describe.
+ */
+[[nodiscard]]
+Result<std::unique_ptr<ITransport>> make_transport(
+    TransportOptions const & options);
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_E4B07C2D9A154F3B8C6D1E0A7F92B345
@@ -0,0 +1,405 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/WireLog.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace wjh::chat::client {
+
+namespace {
+
+constexpr auto wire_magic =
+    std::array<char, 8>{'W', 'J', 'H', 'W', 'I', 'R', 'E', '1'};
+
+struct Header
+{
+    std::array<char, 8> magic{};
+    std::uint64_t capacity = 0;
+    std::uint64_t written = 0; ///< Bytes ever copied in.
+    std::uint64_t records = 0;
+    std::uint64_t dropped = 0;
+};
+static_assert(sizeof(Header) <= WireLog::header_size);
+
+std::string
+errno_text()
+{
+    return std::system_category().message(errno);
+}
+
+// The mapping and the thread that fills it.
+class Ring
+{
+public:
+    static Result<std::unique_ptr<Ring>> open(
+        std::filesystem::path const & path,
+        std::size_t capacity)
+    {
+        if (capacity == 0) {
+            return make_error("Wire log capacity must be positive");
+        }
+        auto const fd = ::open(
+            path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            return make_error(
+                "Cannot open wire log {}: {}", path.string(), errno_text());
+        }
+        auto const size = WireLog::header_size + capacity;
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            auto error = errno_text();
+            ::close(fd);
+            return make_error(
+                "Cannot size wire log {}: {}", path.string(), error);
+        }
+        auto * const map = ::mmap(
+            nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) {
+            auto error = errno_text();
+            ::close(fd);
+            return make_error(
+                "Cannot map wire log {}: {}", path.string(), error);
+        }
+        return std::unique_ptr<Ring>(
+            new Ring(path, fd, static_cast<char *>(map), capacity));
+    }
+
+    ~Ring()
+    {
+        thread_.request_stop();
+        thread_.join();
+        ::munmap(map_, WireLog::header_size + capacity_);
+        ::close(fd_);
+    }
+
+    Ring(Ring const &) = delete;
+    Ring & operator = (Ring const &) = delete;
+
+    [[nodiscard]]
+    std::filesystem::path const & path() const
+    {
+        return path_;
+    }
+
+    void append(std::string record)
+    {
+        auto const lock = std::lock_guard{mutex_};
+        if (pending_bytes_ + record.size() > capacity_) {
+            counter(&Header::dropped).fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        pending_bytes_ += record.size();
+        pending_.push_back(std::move(record));
+        wake_.notify_one();
+    }
+
+    void flush()
+    {
+        auto lock = std::unique_lock{mutex_};
+        drained_.wait(lock, [this] { return pending_.empty() and not busy_; });
+    }
+
+private:
+    Ring(
+        std::filesystem::path path,
+        int fd,
+        char * map,
+        std::size_t capacity)
+    : path_(std::move(path))
+    , fd_(fd)
+    , map_(map)
+    , capacity_(capacity)
+    {
+        auto header = Header{};
+        header.magic = wire_magic;
+        header.capacity = capacity;
+        std::memcpy(map_, &header, sizeof(header));
+        thread_ = std::jthread(
+            [this](std::stop_token stop) { run(std::move(stop)); });
+    }
+
+    std::atomic_ref<std::uint64_t> counter(std::uint64_t Header::* field)
+    {
+        return std::atomic_ref<std::uint64_t>(
+            reinterpret_cast<Header *>(map_)->*field);
+    }
+
+    void run(std::stop_token stop)
+    {
+        auto lock = std::unique_lock{mutex_};
+        while (true) {
+            wake_.wait(lock, stop, [this] { return not pending_.empty(); });
+            if (pending_.empty()) {
+                break; // Stopped with nothing left to write.
+            }
+            auto batch = std::exchange(pending_, {});
+            pending_bytes_ = 0;
+            busy_ = true;
+            lock.unlock();
+            for (auto const & record : batch) {
+                copy(record);
+            }
+            lock.lock();
+            busy_ = false;
+            drained_.notify_all();
+        }
+    }
+
+    // Only this thread moves `written`; append() keeps records smaller
+    // than the ring.
+    void copy(std::string_view record)
+    {
+        auto written = counter(&Header::written);
+        auto const position = written.load(std::memory_order_relaxed);
+        auto * const data = map_ + WireLog::header_size;
+        auto const offset = static_cast<std::size_t>(position % capacity_);
+        auto const first = std::min(record.size(), capacity_ - offset);
+        std::memcpy(data + offset, record.data(), first);
+        std::memcpy(data, record.data() + first, record.size() - first);
+        written.store(position + record.size(), std::memory_order_release);
+        counter(&Header::records).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::filesystem::path path_;
+    int fd_;
+    char * map_;
+    std::size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable_any wake_;
+    std::condition_variable_any drained_;
+    std::vector<std::string> pending_;
+    std::size_t pending_bytes_ = 0;
+    bool busy_ = false;
+    std::jthread thread_; ///< Started last, in the constructor body.
+};
+
+struct State
+{
+    std::mutex mutex;
+    std::unique_ptr<Ring> ring{};
+    std::atomic<std::uint64_t> sequence{0};
+};
+
+State &
+state()
+{
+    static auto instance = State{};
+    return instance;
+}
+
+bool
+is_secret(std::string_view name)
+{
+    auto const equals = [name](std::string_view secret) {
+        return std::ranges::equal(name, secret, [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a))
+                == std::tolower(static_cast<unsigned char>(b));
+        });
+    };
+    return equals("authorization") or equals("proxy-authorization");
+}
+
+void
+append_headers(std::string & out, HttpHeaders const & headers)
+{
+    for (auto const & [name, value] : headers) {
+        out += name;
+        out += ": ";
+        out += is_secret(name) ? std::string_view{"[redacted]"} : value;
+        out += "\r\n";
+    }
+    out += "\r\n";
+}
+
+void
+append_record(std::string_view kind, std::string text)
+{
+    auto const now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+    auto & shared = state();
+    auto record = std::format(
+        "=== {} {} {} {}\n",
+        shared.sequence.fetch_add(1, std::memory_order_relaxed) + 1,
+        kind,
+        now.count(),
+        text.size());
+    record += text;
+    record += '\n';
+
+    auto const lock = std::lock_guard{shared.mutex};
+    if (shared.ring) {
+        shared.ring->append(std::move(record));
+    }
+}
+
+} // anonymous namespace
+
+std::atomic<bool> WireLog::enabled_{false};
+
+Result<std::filesystem::path>
+WireLog::
+open(std::filesystem::path const & path, std::size_t capacity)
+{
+    // The old ring's thread must be done with its mapping before the
+    // file is truncated, which it would be if both name the same file.
+    close();
+
+    auto ring = Ring::open(path, capacity);
+    if (not ring) {
+        return make_error("{}", ring.error());
+    }
+    auto & shared = state();
+    auto const lock = std::lock_guard{shared.mutex};
+    shared.ring = std::move(*ring);
+    shared.sequence.store(0, std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_relaxed);
+    return path;
+}
+
+void
+WireLog::
+set_enabled(bool on)
+{
+    auto & shared = state();
+    auto const lock = std::lock_guard{shared.mutex};
+    enabled_.store(on and shared.ring != nullptr, std::memory_order_relaxed);
+}
+
+void
+WireLog::
+close()
+{
+    auto old = std::unique_ptr<Ring>{};
+    auto & shared = state();
+    auto const lock = std::lock_guard{shared.mutex};
+    enabled_.store(false, std::memory_order_relaxed);
+    old = std::move(shared.ring);
+}
+
+std::optional<std::filesystem::path>
+WireLog::
+path()
+{
+    auto & shared = state();
+    auto const lock = std::lock_guard{shared.mutex};
+    if (not shared.ring) {
+        return std::nullopt;
+    }
+    return shared.ring->path();
+}
+
+void
+WireLog::
+flush()
+{
+    auto & shared = state();
+    auto const lock = std::lock_guard{shared.mutex};
+    if (shared.ring) {
+        shared.ring->flush();
+    }
+}
+
+void
+WireLog::
+log_request(
+    HttpPath const & path,
+    HttpHeaders const & headers,
+    HttpBody const & body)
+{
+    if (not enabled()) {
+        return;
+    }
+    auto const & text = json_value(body);
+    auto out = std::string{};
+    out.reserve(text.size() + 256);
+    out += std::format("POST {} HTTP/1.1\r\n", json_value(path));
+    append_headers(out, headers);
+    out += text;
+    append_record("request", std::move(out));
+}
+
+void
+WireLog::
+log_response(Result<HttpResponse> const & response)
+{
+    if (not enabled()) {
+        return;
+    }
+    if (not response) {
+        append_record("error", response.error());
+        return;
+    }
+    auto const & text = json_value(response->body);
+    auto out = std::string{};
+    out.reserve(text.size() + 256);
+    out += std::format("HTTP/1.1 {}\r\n", json_value(response->status));
+    append_headers(out, response->headers);
+    out += text;
+    append_record("response", std::move(out));
+}
+
+Result<std::string>
+WireLog::
+read(std::filesystem::path const & path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (not file) {
+        return make_error("Cannot open wire log {}", path.string());
+    }
+    auto const bytes = std::string(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+
+    auto header = Header{};
+    if (bytes.size() < header_size) {
+        return make_error("{} is not a wire log", path.string());
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != wire_magic
+        or bytes.size() != header_size + header.capacity)
+    {
+        return make_error("{} is not a wire log", path.string());
+    }
+
+    auto const data = std::string_view(bytes).substr(header_size);
+    if (header.written <= header.capacity) {
+        return std::string(data.substr(0, header.written));
+    }
+    auto const start = static_cast<std::size_t>(
+        header.written % header.capacity);
+    auto result = std::string(data.substr(start));
+    result += data.substr(0, start);
+    auto const first = result.find("\n=== ");
+    if (first == std::string::npos) {
+        return std::string{};
+    }
+    return result.substr(first + 1);
+}
+
+} // namespace wjh::chat::client
@@ -0,0 +1,108 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_59F9FA68A2A24B14AF9240FBCC7997CC
+#define WJH_CHAT_59F9FA68A2A24B14AF9240FBCC7997CC
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/client/HttpClient.hpp"
+#include "wjh/chat/client/types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace wjh::chat::client {
+
+/**
+ * Process-wide log of the bytes HttpTransport exchanges with the API,
+ * kept in a memory-mapped ring-buffer file.
+ *
+ * Logging can be switched on and off at any time.  While it is off,
+ * an exchange costs one relaxed atomic load.  While it is on, the
+ * request and response are formatted as HTTP/1.1 text and queued; a
+ * background thread copies them into the mapping, so the caller never
+ * waits on the disk.  The Authorization and Proxy-Authorization
+ * header values are replaced with "[redacted]".  When the queue holds
+ * more than the ring's capacity, new records are dropped and counted.
+ *
+ * The file is a 64-byte header followed by `capacity` bytes of data.
+ * The header holds the magic "WJHWIRE1" and then, as native 64-bit
+ * integers, the capacity, the bytes ever written, the records written,
+ * and the records dropped.  Once more than capacity bytes have been
+ * written, the oldest data starts at (written % capacity).  The pages
+ * belong to the kernel, so whatever was copied in survives a crash.
+ * Each record starts with a line
+ *
+ *     === <sequence> <request|response|error> <unix time us> <size>
+ *
+ * followed by `size` bytes and a newline.
+ */
+class WireLog
+{
+public:
+    static constexpr std::size_t header_size = 64;
+
+    [[nodiscard]]
+    static bool enabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Close any log already open, then create (or truncate) the file,
+     * map it, and start logging to it.  If this fails, no log is open.
+     */
+    static Result<std::filesystem::path> open(
+        std::filesystem::path const & path,
+        std::size_t capacity);
+
+    /**
+     * Pause or resume logging to the open file.  Without one, logging
+     * stays off.
+     */
+    static void set_enabled(bool on);
+
+    /**
+     * Write out everything queued, stop, and unmap the file.
+     */
+    static void close();
+
+    /**
+     * The open file, if any.
+     */
+    [[nodiscard]]
+    static std::optional<std::filesystem::path> path();
+
+    /**
+     * Wait until every record queued so far is in the mapping.
+     */
+    static void flush();
+
+    static void log_request(
+        HttpPath const & path,
+        HttpHeaders const & headers,
+        HttpBody const & body);
+
+    static void log_response(Result<HttpResponse> const & response);
+
+    /**
+     * The records of a log file, oldest first.  When the ring has
+     * wrapped, the partly overwritten oldest record is skipped.
+     */
+    [[nodiscard]]
+    static Result<std::string> read(std::filesystem::path const & path);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_59F9FA68A2A24B14AF9240FBCC7997CC
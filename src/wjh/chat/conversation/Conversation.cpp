@@ -6,8 +6,86 @@
 // ----------------------------------------------------------------------
 #include "wjh/chat/conversation/Conversation.hpp"
 
+#include "wjh/chat/json_convert.hpp"
+
+#include <algorithm>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace wjh::chat::conversation {
 
+namespace {
+
+constexpr std::string_view trim_note_end =
+    "run the tool again for the full output.]";
+
+// Longest prefix of text no longer than max_bytes, ending at a line
+// break if there is one, and never inside a UTF-8 sequence.
+std::string_view
+head_of(std::string_view text, std::size_t max_bytes)
+{
+    auto head = text.substr(0, max_bytes);
+    if (auto const nl = head.rfind('\n'); nl != std::string_view::npos) {
+        return head.substr(0, nl + 1);
+    }
+    while (not head.empty() and head.size() < text.size()
+           and (static_cast<unsigned char>(text[head.size()]) & 0xC0) == 0x80)
+    {
+        head.remove_suffix(1);
+    }
+    return head;
+}
+
+// Index where the last `turns` user turns start, or nullopt if the
+// history holds fewer.
+std::optional<std::size_t>
+start_of_turns(std::vector<Message> const & messages, std::size_t turns)
+{
+    auto index = messages.size();
+    std::size_t seen = 0;
+    while (index > 0 and seen < turns) {
+        --index;
+        if (messages[index].role() == Role::user) {
+            ++seen;
+        }
+    }
+    if (seen < turns) {
+        return std::nullopt;
+    }
+    return index;
+}
+
+// The cut-down text of a tool result from before the retention
+// window, or nullopt if cutting would not make it shorter.
+std::optional<std::string>
+cut(Message const & msg, std::size_t trimmed_bytes)
+{
+    std::string_view const text = json_value(msg.text());
+    if (not msg.is_tool_result() or text.size() <= trimmed_bytes
+        or text.ends_with(trim_note_end))
+    {
+        return std::nullopt;
+    }
+
+    auto const head = head_of(text, trimmed_bytes);
+    auto trimmed = std::format(
+        "{}{}[... {} of {} bytes trimmed from an earlier turn; {}",
+        head,
+        head.empty() or head.ends_with('\n') ? "" : "\n",
+        text.size() - head.size(),
+        text.size(),
+        trim_note_end);
+    if (trimmed.size() >= text.size()) {
+        return std::nullopt;
+    }
+    return trimmed;
+}
+
+} // anonymous namespace
+
 void
 Conversation::
 add_message(Message msg)
@@ -29,6 +107,60 @@ add_message(AssistantResponse text)
     add_message(Message::assistant(std::move(text)));
 }
 
+void
+Conversation::
+replace_prefix(std::size_t count, Message replacement)
+{
+    count = std::min(count, messages_.size());
+    messages_.erase(
+        messages_.begin(),
+        messages_.begin() + static_cast<std::ptrdiff_t>(count));
+    messages_.insert(messages_.begin(), std::move(replacement));
+}
+
+std::size_t
+Conversation::
+trim_tool_results(ToolRetention const & retention)
+{
+    auto const keep_from = start_of_turns(messages_, retention.full_turns);
+    if (not keep_from) {
+        return 0;
+    }
+
+    // Cutting a result changes the history every later request
+    // starts with, so the prompt cache misses from there on.  Cut in
+    // batches instead of every turn: wait until some result is another
+    // full_turns turns past the window, then cut everything outside
+    // it.  The history has at least full_turns turns, so doubling
+    // cannot overflow.
+    auto const due_from =
+        start_of_turns(messages_, 2 * retention.full_turns);
+    if (not due_from
+        or std::none_of(
+            messages_.begin(),
+            messages_.begin() + static_cast<std::ptrdiff_t>(*due_from),
+            [&retention](Message const & msg) {
+                return cut(msg, retention.trimmed_bytes).has_value();
+            }))
+    {
+        return 0;
+    }
+
+    std::size_t removed = 0;
+    for (std::size_t i = 0; i < *keep_from; ++i) {
+        auto & msg = messages_[i];
+        auto trimmed = cut(msg, retention.trimmed_bytes);
+        if (not trimmed) {
+            continue;
+        }
+        removed += json_value(msg.text()).size() - trimmed->size();
+        msg = Message::tool_result(
+            *msg.tool_call_id(),
+            MessageText{std::move(*trimmed)});
+    }
+    return removed;
+}
+
 nlohmann::json
 Conversation::
 to_json() const
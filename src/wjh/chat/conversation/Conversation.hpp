@@ -8,6 +8,7 @@
 #define WJH_CHAT_F6ECA88581C6415AB5A8A5194B14F202
 
 #include "wjh/chat/conversation/Message.hpp"
+#include "wjh/chat/conversation/ToolRetention.hpp"
 
 #include <nlohmann/json.hpp>
 
@@ -80,6 +81,12 @@ public:
      */
     void clear() { messages_.clear(); }
 
+    /**
+     * Replace the first count messages with one message, e.g. a
+     * summary of them.
+     */
+    void replace_prefix(std::size_t count, Message replacement);
+
     /**
      * Remove the last message (e.g., on send failure).
      */
@@ -90,6 +97,19 @@ public:
         }
     }
 
+    /**
+     * Cut tool results older than the retention window.
+     *
+     * Cutting invalidates the provider's cached prefix from the first
+     * changed message, so nothing is cut until some result is another
+     * full_turns turns past the window; then every result outside it
+     * is cut at once.  Results already cut are left alone, so this can
+     * run after every turn.
+     *
+     * @return Bytes removed from the history.
+     */
+    std::size_t trim_tool_results(ToolRetention const & retention);
+
     /**
      * Convert messages to JSON array for API.
      */
@@ -28,20 +28,81 @@ assistant(AssistantResponse response)
         MessageText{atlas::undress(std::move(response))}};
 }
 
+Message
+Message::
+tool_calls(std::vector<ToolCall> calls, MessageText text)
+{
+    return Message{Role::assistant, std::move(text), std::move(calls)};
+}
+
+Message
+Message::
+tool_result(ToolCallId id, MessageText output)
+{
+    return Message{Role::tool, std::move(output), {}, std::move(id)};
+}
+
 nlohmann::json
 to_json(Message const & msg)
 {
+    if (msg.is_tool_result()) {
+        return {
+            {"role", json_value(msg.role())},
+            {"tool_call_id", json_value(*msg.tool_call_id())},
+            {"content", json_value(msg.text())}};
+    }
+    if (msg.calls().empty()) {
+        return {
+            {"role", json_value(msg.role())},
+            {"content", json_value(msg.text())}};
+    }
+
+    auto calls = nlohmann::json::array();
+    for (auto const & call : msg.calls()) {
+        calls.push_back(
+            {{"id", json_value(call.id)},
+             {"type", "function"},
+             {"function",
+              {{"name", call.name}, {"arguments", call.arguments}}}});
+    }
+    auto content = json_value(msg.text()).empty()
+        ? nlohmann::json(nullptr)
+        : nlohmann::json(json_value(msg.text()));
     return {
         {"role", json_value(msg.role())},
-        {"content", json_value(msg.text())}};
+        {"content", std::move(content)},
+        {"tool_calls", std::move(calls)}};
 }
 
 Message
 parse_message(nlohmann::json const & json)
 {
-    return Message{
-        Role(json.at("role").get<std::string>()),
-        MessageText{json.at("content").get<std::string>()}};
+    auto role = Role(json.at("role").get<std::string>());
+    // Assistant messages with tool calls may carry no content at all.
+    auto text = MessageText{
+        json.contains("content") and not json["content"].is_null()
+            ? json["content"].get<std::string>()
+            : std::string{}};
+
+    if (role == Role::tool) {
+        return Message{
+            std::move(role),
+            std::move(text),
+            {},
+            ToolCallId{json.at("tool_call_id").get<std::string>()}};
+    }
+
+    std::vector<ToolCall> calls;
+    if (json.contains("tool_calls")) {
+        for (auto const & tc : json["tool_calls"]) {
+            auto const & fn = tc.at("function");
+            calls.push_back(ToolCall{
+                .id = ToolCallId{tc.at("id").get<std::string>()},
+                .name = fn.at("name").get<std::string>(),
+                .arguments = fn.at("arguments").get<std::string>()});
+        }
+    }
+    return Message{std::move(role), std::move(text), std::move(calls)};
 }
 
 } // namespace wjh::chat::conversation
@@ -12,14 +12,34 @@
 
 #include <nlohmann/json.hpp>
 
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace wjh::chat::conversation {
 
+/**
+ * A tool call requested by the assistant.
+ *
+ * Arguments are kept as the JSON text the API returned, so the call
+ * is sent back byte for byte.
+ */
+struct ToolCall
+{
+    ToolCallId id;
+    std::string name;
+    std::string arguments;
+
+    friend bool operator == (ToolCall const &, ToolCall const &) = default;
+};
+
 /**
  * A message in the conversation.
  *
- * Simplified for the starter kit: just role + text, no content blocks.
+ * Besides user and assistant text, a message can be an assistant turn
+ * that requests tool calls, or the result of one tool call.  Keeping
+ * those in the history lets later turns refer to tool output without
+ * running the tools again.
  *
  * Construction is restricted to factory methods and parse_message()
  * to prevent creation of semantically invalid messages.
@@ -39,6 +59,19 @@ public:
     [[nodiscard]]
     static Message assistant(AssistantResponse response);
 
+    /**
+     * Create an assistant message that requests tool calls, with
+     * whatever text came along with them (often none).
+     */
+    [[nodiscard]]
+    static Message tool_calls(std::vector<ToolCall> calls, MessageText text);
+
+    /**
+     * Create the result of one tool call.
+     */
+    [[nodiscard]]
+    static Message tool_result(ToolCallId id, MessageText output);
+
     [[nodiscard]]
     Role const & role() const
     {
@@ -52,7 +85,31 @@ public:
     }
 
     /**
-     * Equality: two messages are equal if role and text match.
+     * Tool calls requested by an assistant message; empty otherwise.
+     */
+    [[nodiscard]]
+    std::vector<ToolCall> const & calls() const
+    {
+        return calls_;
+    }
+
+    /**
+     * The call a tool result answers; empty for other messages.
+     */
+    [[nodiscard]]
+    std::optional<ToolCallId> const & tool_call_id() const
+    {
+        return tool_call_id_;
+    }
+
+    [[nodiscard]]
+    bool is_tool_result() const
+    {
+        return role_ == Role::tool;
+    }
+
+    /**
+     * Equality: two messages are equal if all their parts match.
      */
     Message(Message const &) = default;
     Message(Message &&) noexcept = default;
@@ -62,13 +119,21 @@ public:
     friend bool operator == (Message const &, Message const &) = default;
 
 private:
-    Message(Role r, MessageText t)
+    Message(
+        Role r,
+        MessageText t,
+        std::vector<ToolCall> calls = {},
+        std::optional<ToolCallId> id = std::nullopt)
     : role_(std::move(r))
     , text_(std::move(t))
+    , calls_(std::move(calls))
+    , tool_call_id_(std::move(id))
     { }
 
     Role role_;
     MessageText text_;
+    std::vector<ToolCall> calls_;
+    std::optional<ToolCallId> tool_call_id_;
 
     friend Message parse_message(nlohmann::json const & json);
 };
@@ -0,0 +1,52 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/conversation/ToolRetention.hpp"
+
+#include <charconv>
+
+namespace wjh::chat::conversation {
+
+namespace {
+
+bool
+parse_size(std::string_view text, std::size_t & out)
+{
+    auto const [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc{} and ptr == text.data() + text.size();
+}
+
+} // anonymous namespace
+
+Result<ToolRetention>
+parse_tool_retention(std::string_view spec)
+{
+    auto retention = ToolRetention{};
+    if (spec == "off") {
+        retention.persist = false;
+        return retention;
+    }
+    if (spec == "all") {
+        retention.full_turns = std::numeric_limits<std::size_t>::max();
+        return retention;
+    }
+
+    auto const colon = spec.find(':');
+    if (not parse_size(spec.substr(0, colon), retention.full_turns)
+        or (colon != std::string_view::npos
+            and not parse_size(
+                spec.substr(colon + 1),
+                retention.trimmed_bytes)))
+    {
+        return make_error(
+            "'{}' (expected off, all, or <turns>[:<bytes>])",
+            spec);
+    }
+    return retention;
+}
+
+} // namespace wjh::chat::conversation
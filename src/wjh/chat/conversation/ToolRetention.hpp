@@ -0,0 +1,43 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_D4A81F6C2B9E4C07A5E31D8F60B7C295
+#define WJH_CHAT_D4A81F6C2B9E4C07A5E31D8F60B7C295
+
+#include "wjh/chat/Result.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <string_view>
+
+namespace wjh::chat::conversation {
+
+/**
+ * How long tool calls and their results stay in the history.
+ *
+ * Results from the most recent full_turns user turns are kept whole.
+ * Older results are cut to their first trimmed_bytes (at a line
+ * boundary when possible) with a note saying how much was dropped.
+ * The calls themselves are always kept so the history stays valid.
+ */
+struct ToolRetention
+{
+    bool persist = true; ///< Keep tool messages across turns at all.
+    std::size_t full_turns = 4;
+    std::size_t trimmed_bytes = 512;
+};
+
+/**
+ * Parse TOOL_HISTORY: "off" drops tool messages at the end of each
+ * turn, "all" keeps every result whole, and `<turns>[:<bytes>]` sets
+ * full_turns and optionally trimmed_bytes.
+ */
+[[nodiscard]]
+Result<ToolRetention> parse_tool_retention(std::string_view spec);
+
+} // namespace wjh::chat::conversation
+
+#endif // WJH_CHAT_D4A81F6C2B9E4C07A5E31D8F60B7C295
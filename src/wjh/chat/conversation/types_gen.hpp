@@ -1,5 +1,5 @@
-#ifndef WJH_CHAT_F30B82C1BBCA952A7A02DCEB3163D592265CB3C5
-#define WJH_CHAT_F30B82C1BBCA952A7A02DCEB3163D592265CB3C5
+#ifndef WJH_CHAT_4039B28904834D1CEF0F605F59EABA4C049979D8
+#define WJH_CHAT_4039B28904834D1CEF0F605F59EABA4C049979D8
 
 // ======================================================================
 // NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE
@@ -1270,6 +1270,8 @@ public:
 
     static const Role assistant;
 
+    static const Role tool;
+
     static const Role user;
 
     Role() = delete;
@@ -1397,6 +1399,7 @@ public:
 #pragma clang diagnostic ignored "-Wglobal-constructors"
 #endif
 inline constexpr wjh::chat::conversation::Role wjh::chat::conversation::Role::assistant = wjh::chat::conversation::Role("assistant");
+inline constexpr wjh::chat::conversation::Role wjh::chat::conversation::Role::tool = wjh::chat::conversation::Role("tool");
 inline constexpr wjh::chat::conversation::Role wjh::chat::conversation::Role::user = wjh::chat::conversation::Role("user");
 #if defined(__clang__)
 #pragma clang diagnostic pop
@@ -1701,4 +1704,151 @@ public:
 } // namespace chat
 } // namespace wjh
 
-#endif // WJH_CHAT_F30B82C1BBCA952A7A02DCEB3163D592265CB3C5
+
+namespace wjh {
+namespace chat {
+namespace conversation {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat::conversation
+ * - type_name: ToolCallId
+ * - description: std::string; <=>, non_empty
+ * - default_value: ""
+ */
+class ToolCallId
+: private atlas::strong_type_tag<ToolCallId>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+    using atlas_constraint = atlas::constraints::non_empty<std::string>;
+
+    ToolCallId() = delete;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ToolCallId(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    {
+        if (not atlas::constraints::check<ToolCallId>(value)) {
+            throw atlas::ConstraintError(
+                "ToolCallId: " +
+                atlas::constraints::detail::format_value(value) +
+                " violates constraint: value must not be empty");
+        }
+    }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(ToolCallId const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(ToolCallId & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ToolCallId && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ToolCallId const &,
+        ToolCallId const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ToolCallId const & lhs,
+        ToolCallId const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ToolCallId const & lhs,
+        ToolCallId const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ToolCallId const & lhs,
+        ToolCallId const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ToolCallId const & lhs,
+        ToolCallId const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ToolCallId const &,
+        ToolCallId const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ToolCallId const & lhs,
+        ToolCallId const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ToolCallId const & lhs,
+        ToolCallId const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace conversation
+} // namespace chat
+} // namespace wjh
+
+#endif // WJH_CHAT_4039B28904834D1CEF0F605F59EABA4C049979D8
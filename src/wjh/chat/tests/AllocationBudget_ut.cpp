@@ -0,0 +1,306 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+//
+// Heap allocations per unit of work on the turn path.  The budgets are
+// about 25% above what the code needs today; a change that copies
+// strong types or JSON documents where it used to move them shows up
+// here as a failure.  When a change legitimately needs more, raise the
+// budget in the same commit and say why.
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/ChatLoop.hpp"
+#include "wjh/chat/SessionMetrics.hpp"
+#include "wjh/chat/client/OpenRouterClient.hpp"
+#include "wjh/chat/client/PerfCounters.hpp"
+#include "wjh/chat/client/RequestPrefix.hpp"
+#include "wjh/chat/client/Tracer.hpp"
+#include "wjh/chat/client/WireLog.hpp"
+#include "wjh/chat/client/Transport.hpp"
+#include "wjh/chat/conversation/Conversation.hpp"
+#include "wjh/chat/conversation/Message.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "testing/AllocationTracker.hpp"
+#include "testing/MockClient.hpp"
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+using nlohmann::json;
+using testing::AllocationScope;
+
+// Turns of a coding session: question, read_file call, its result,
+// and an answer.
+std::vector<conversation::Message>
+history(std::size_t turns)
+{
+    std::vector<conversation::Message> out;
+    for (std::size_t turn = 0; turn < turns; ++turn) {
+        auto const id =
+            conversation::ToolCallId{std::format("call_{}", turn)};
+        out.push_back(conversation::Message::user(
+            UserInput{std::format("Why does test {} fail?", turn)}));
+        out.push_back(conversation::Message::tool_calls(
+            {conversation::ToolCall{
+                .id = id,
+                .name = "read_file",
+                .arguments = R"({"file_path":"src/parser.cpp"})"}},
+            conversation::MessageText{""}));
+        out.push_back(conversation::Message::tool_result(
+            id,
+            conversation::MessageText{std::string(4096, 'x')}));
+        out.push_back(conversation::Message::assistant(
+            AssistantResponse{std::string(2048, 'y')}));
+    }
+    return out;
+}
+
+json
+to_json(std::vector<conversation::Message> const & messages)
+{
+    auto out = json::array();
+    for (auto const & message : messages) {
+        out.push_back(conversation::to_json(message));
+    }
+    return out;
+}
+
+// Answers every request with the same body.
+class FixedTransport
+: public client::ITransport
+{
+public:
+    explicit FixedTransport(std::string body)
+    : body_(std::move(body))
+    { }
+
+private:
+    Result<client::HttpResponse> do_post(
+        client::HttpPath const &,
+        client::HttpBody const &,
+        client::HttpHeaders const &) override
+    {
+        client::HttpResponse response;
+        response.status = client::HttpStatusCode{200};
+        response.body = client::HttpBody{body_};
+        return response;
+    }
+
+    std::string body_;
+};
+
+std::string
+text_reply()
+{
+    return json{
+        {"choices",
+         json::array(
+             {{{"message",
+                {{"role", "assistant"},
+                 {"content", std::string(2048, 'z')}}},
+               {"finish_reason", "stop"}}})},
+        {"usage",
+         {{"prompt_tokens", 12},
+          {"completion_tokens", 3},
+          {"total_tokens", 15}}}}.dump();
+}
+
+// The tracer, wire log, and perf counters are off, as they are by
+// default; their hooks then cost one relaxed atomic load each and
+// allocate nothing.
+void
+require_hooks_off()
+{
+    REQUIRE_FALSE(client::Tracer::enabled());
+    REQUIRE_FALSE(client::WireLog::enabled());
+    REQUIRE_FALSE(client::PerfCounters::enabled());
+}
+
+// Allocations for the second of two identical turns, so one-time
+// setup (the serialized system message, tool definitions) is not
+// counted.
+std::uint64_t
+client_turn(std::size_t turns)
+{
+    client::OpenRouterClient client(
+        client::OpenRouterClientConfig{
+            .api_key = ApiKey("test-api-key"),
+            .model = ModelId("openai/gpt-4"),
+            .max_tokens = MaxTokens(4096u),
+            .system_prompt = SystemPrompt{"Be brief."},
+            .temperature = std::nullopt},
+        std::make_unique<FixedTransport>(text_reply()));
+    conversation::Conversation conversation;
+    for (auto & message : history(turns)) {
+        conversation.add_message(std::move(message));
+    }
+    conversation.add_message(UserInput{"And now?"});
+
+    REQUIRE(client.send_message(conversation));
+    require_hooks_off();
+    AllocationScope scope;
+    auto const response = client.send_message(conversation);
+    auto const allocations = scope.counts().allocations;
+    REQUIRE(response);
+    return allocations;
+}
+
+// Allocations for a ChatLoop session of the given number of turns.
+std::uint64_t
+loop_session(int turns)
+{
+    auto mock = std::make_unique<testing::MockClient>();
+    std::string script;
+    for (int i = 0; i < turns; ++i) {
+        mock->queue_response(AssistantResponse{std::string(2048, 'q')});
+        script += "Tell me more about the parser\n";
+    }
+    std::istringstream in(script + "/exit\n");
+    std::ostringstream out;
+    ChatLoop loop(
+        Config{
+            .api_key = ApiKey{"test-key"},
+            .model = ModelId{"test-model"},
+            .max_tokens = MaxTokens{4096u},
+            .system_prompt = std::nullopt,
+            .temperature = std::nullopt,
+            .show_config = ShowConfig{false}},
+        std::move(mock),
+        in,
+        out);
+
+    require_hooks_off();
+    AllocationScope scope;
+    (void)loop.run();
+    return scope.counts().allocations;
+}
+
+TEST_SUITE("AllocationBudget")
+{
+    constexpr std::size_t turns = 100;
+    constexpr std::size_t messages = 4 * turns;
+
+    TEST_CASE("Converting the history to request JSON")
+    {
+        auto const history_messages = history(turns);
+
+        AllocationScope scope;
+        auto const body = to_json(history_messages);
+
+        CHECK(body.size() == messages);
+        CHECK(scope.counts().allocations <= 30 * messages);
+    }
+
+    TEST_CASE("Serializing a request body")
+    {
+        auto const body = to_json(history(turns));
+        client::RequestPrefix prefix(
+            json{{"model", "openai/gpt-4"}, {"max_tokens", 4096}},
+            json::array());
+        (void)prefix.build(SystemPrompt{"Be brief."}, false, body);
+
+        AllocationScope scope;
+        auto const request =
+            prefix.build(SystemPrompt{"Be brief."}, false, body);
+
+        CHECK(request.size() > turns * (4096 + 2048));
+        CHECK(scope.counts().allocations <= 7 * messages);
+    }
+
+    TEST_CASE("Adding messages to a conversation")
+    {
+        auto source = history(turns);
+
+        SUBCASE("by copy copies each message once")
+        {
+            AllocationScope scope;
+            conversation::Conversation conversation;
+            for (auto const & message : source) {
+                conversation.add_message(message);
+            }
+            CHECK(scope.counts().allocations <= 2 * messages);
+        }
+
+        SUBCASE("by move only grows the list")
+        {
+            AllocationScope scope;
+            conversation::Conversation conversation;
+            for (auto & message : source) {
+                conversation.add_message(std::move(message));
+            }
+            CHECK(scope.counts().allocations <= 16);
+        }
+    }
+
+    TEST_CASE("A client turn that gets a text reply")
+    {
+        // Request body, response parse, parse_response, and the request's
+        // latency in the turn timing.
+        auto const empty = client_turn(0);
+        CHECK(empty <= 100);
+
+        // Each message of history adds its JSON and serialization.
+        auto const ten = client_turn(10);
+        CHECK(ten - empty <= 45 * 4 * 10);
+    }
+
+    TEST_CASE("Recording session metrics for a seen tool or status")
+    {
+        MetricsRegistry registry;
+        SessionMetrics metrics(registry);
+        auto response = ChatResponse{
+            .response = AssistantResponse{"Done"},
+            .usage = std::nullopt};
+        response.timing.requests = 2;
+        response.timing.request_times = {
+            std::chrono::milliseconds(10),
+            std::chrono::milliseconds(20)};
+        response.timing.tool_calls = {
+            ToolTiming{.name = "read_file"},
+            ToolTiming{.name = "bash"}};
+        metrics.record_turn(response);
+        metrics.record_error("API error (429): slow down", {});
+
+        AllocationScope scope;
+        metrics.record_turn(response);
+        metrics.record_error("API error (429): slow down", {});
+
+        CHECK(scope.counts().allocations == 0);
+        auto const stats = registry.snapshot();
+        auto tool_calls = std::uint64_t{0};
+        auto errors = std::uint64_t{0};
+        for (auto const & c : stats.counters) {
+            tool_calls += c.name == "chat_tool_calls_total" ? c.value : 0;
+            errors += c.name == "chat_turn_errors_total" ? c.value : 0;
+        }
+        CHECK(tool_calls == 4);
+        CHECK(errors == 2);
+    }
+
+    TEST_CASE("A ChatLoop turn with MockClient")
+    {
+        // Per turn: the input line, the user and assistant messages, and
+        // the turn's entry in the /timing history.  Recording the turn in
+        // the session metrics adds nothing once its tools have been seen.
+        auto const two = loop_session(2);
+        auto const three = loop_session(3);
+
+        CHECK(three - two <= 20);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,95 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "testing/AllocationTracker.hpp"
+#include "testing/doctest.hpp"
+
+namespace {
+using testing::AllocationScope;
+
+TEST_SUITE("AllocationTracker")
+{
+    TEST_CASE("Counts new and delete on this thread")
+    {
+        AllocationScope scope;
+        auto p = std::make_unique<std::uint64_t[]>(16);
+        auto const during = scope.counts();
+        p.reset();
+        auto const after = scope.counts();
+
+        CHECK(during.allocations == 1);
+        CHECK(during.bytes == 16 * sizeof(std::uint64_t));
+        CHECK(during.deallocations == 0);
+        CHECK(after.deallocations == 1);
+    }
+
+    TEST_CASE("Counts aligned and nothrow allocations")
+    {
+        struct alignas(64) Line
+        {
+            char bytes[64];
+        };
+
+        AllocationScope scope;
+        auto line = std::make_unique<Line>();
+        auto * const raw = new (std::nothrow) int(7);
+        delete raw;
+
+        CHECK(scope.counts().allocations == 2);
+        CHECK(scope.counts().deallocations == 1);
+        CHECK(reinterpret_cast<std::uintptr_t>(line.get()) % 64 == 0);
+    }
+
+    TEST_CASE("A scope with no allocations counts nothing")
+    {
+        std::string const text = "short";
+        AllocationScope scope;
+        auto const copy = text;
+
+        CHECK(copy == text);
+        CHECK(scope.counts().allocations == 0);
+        CHECK(scope.counts().bytes == 0);
+    }
+
+    TEST_CASE("Nested scopes each count from their start")
+    {
+        AllocationScope outer;
+        std::vector<int> a(100);
+        AllocationScope inner;
+        std::vector<int> b(200);
+
+        CHECK(outer.counts().allocations == 2);
+        CHECK(inner.counts().allocations == 1);
+        CHECK(inner.counts().bytes == 200 * sizeof(int));
+    }
+
+    TEST_CASE("Other threads are not counted")
+    {
+        AllocationScope scope;
+        std::uint64_t theirs = 0;
+        // The thread object itself may allocate; only its body is
+        // counted on the new thread.
+        std::thread([&theirs] {
+            AllocationScope inner;
+            std::vector<int> v(1000);
+            theirs = inner.counts().allocations;
+        }).join();
+        auto const mine = scope.counts().allocations;
+
+        CHECK(theirs == 1);
+        CHECK(mine <= 1);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,243 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/ApprovalPolicy.hpp"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+
+ToolCall
+bash(std::string command)
+{
+    return ToolCall{
+        .name = "bash",
+        .arguments = nlohmann::json{{"command", std::move(command)}}};
+}
+
+ToolCall
+write_call(std::string path)
+{
+    return ToolCall{
+        .name = "write_file",
+        .arguments =
+            nlohmann::json{{"file_path", std::move(path)}, {"content", "x"}}};
+}
+
+ApprovalPolicy
+policy(std::string_view spec)
+{
+    auto result = ApprovalPolicy::parse(spec);
+    REQUIRE(result.has_value());
+    return *result;
+}
+
+TEST_SUITE("ApprovalPolicy")
+{
+    TEST_CASE("Parse rules separated by semicolons and newlines")
+    {
+        auto const p = policy(
+            "deny bash cmd:*rm -rf*;\n"
+            "allow write_file path:src/\n"
+            " ; ask *");
+
+        REQUIRE(p.rules().size() == 3);
+        CHECK(p.rules()[0].decision == Decision::deny);
+        CHECK(p.rules()[0].command_pattern == "*rm -rf*");
+        CHECK(p.rules()[1].tool == "write_file");
+        CHECK(p.rules()[1].path_prefix == std::filesystem::path("src/"));
+        CHECK(p.rules()[2].tool == "*");
+        CHECK(p.rules()[2].text == "ask *");
+    }
+
+    TEST_CASE("Malformed rules are rejected")
+    {
+        CHECK_FALSE(ApprovalPolicy::parse("permit bash").has_value());
+        CHECK_FALSE(ApprovalPolicy::parse("allow").has_value());
+        CHECK_FALSE(ApprovalPolicy::parse("allow bash ls*").has_value());
+        CHECK(ApprovalPolicy::parse("").has_value());
+    }
+
+    TEST_CASE("First matching rule wins")
+    {
+        auto const p = policy("deny bash cmd:*rm -rf*; allow bash");
+
+        CHECK(p.evaluate(bash("rm -rf build")).decision == Decision::deny);
+        CHECK(p.evaluate(bash("ls")).decision == Decision::allow);
+        CHECK(p.evaluate(bash("ls")).rule == "allow bash");
+    }
+
+    TEST_CASE("Defaults allow read_file and ask for everything else")
+    {
+        auto const p = ApprovalPolicy{};
+        auto const read = ToolCall{
+            .name = "read_file",
+            .arguments = nlohmann::json{{"file_path", "a.txt"}}};
+
+        CHECK(p.evaluate(read).decision == Decision::allow);
+        CHECK(p.evaluate(bash("ls")).decision == Decision::ask);
+        CHECK(p.evaluate(write_call("a.txt")).decision == Decision::ask);
+    }
+
+    TEST_CASE("Command allow rules do not cover chained commands")
+    {
+        auto const p = policy("allow bash cmd:ls*; allow bash cmd:* | wc*");
+
+        CHECK(p.evaluate(bash("ls -l")).decision == Decision::allow);
+        CHECK(p.evaluate(bash("ls; rm -rf ~")).decision == Decision::ask);
+        CHECK(p.evaluate(bash("ls $(rm x)")).decision == Decision::ask);
+        CHECK(p.evaluate(bash("ls > out")).decision == Decision::ask);
+        CHECK(p.evaluate(bash("ls | wc -l")).decision == Decision::allow);
+    }
+
+    TEST_CASE("Path prefixes match whole components")
+    {
+        auto const p = policy("allow write_file path:src/");
+
+        CHECK(p.evaluate(write_call("src/a.cpp")).decision
+              == Decision::allow);
+        CHECK(p.evaluate(write_call("./src/x/b.cpp")).decision
+              == Decision::allow);
+        CHECK(p.evaluate(write_call("srcfoo/a.cpp")).decision == Decision::ask);
+        CHECK(p.evaluate(write_call("src/../etc/passwd")).decision
+              == Decision::ask);
+    }
+
+    TEST_CASE("Path prefixes do not follow symlinks out")
+    {
+        auto const root = std::filesystem::temp_directory_path()
+            / std::format("wjh_chat_policy_{}", getpid());
+        std::filesystem::remove_all(root);
+        std::filesystem::create_directories(root / "src");
+        std::filesystem::create_directories(root / "secret");
+        std::filesystem::create_directory_symlink(
+            root / "secret", root / "src" / "link");
+        auto const p = policy(std::format(
+            "allow write_file path:{}/", (root / "src").string()));
+
+        auto const inside = (root / "src" / "a.cpp").string();
+        auto const through = (root / "src" / "link" / "key").string();
+        CHECK(p.evaluate(write_call(inside)).decision == Decision::allow);
+        CHECK(p.evaluate(write_call(through)).decision == Decision::ask);
+        std::filesystem::remove_all(root);
+    }
+
+    TEST_CASE("describe_tool_call")
+    {
+        CHECK(describe_tool_call(bash("ls")) == "bash: ls");
+        CHECK(describe_tool_call(write_call("a.txt"))
+              == "write_file: a.txt (1 bytes)");
+        CHECK(describe_tool_call(ToolCall{
+                  .name = "build",
+                  .arguments = nlohmann::json{{"preset", "debug"}}})
+              == R"(build: {"preset":"debug"})");
+    }
+}
+
+TEST_SUITE("Approver")
+{
+    TEST_CASE("Policy decisions do not prompt")
+    {
+        std::istringstream in;
+        std::ostringstream out;
+        Approver approver(
+            policy("allow bash cmd:ls*; deny write_file"),
+            in,
+            out);
+
+        auto const result = approver.review({bash("ls"), write_call("a.txt")});
+
+        REQUIRE(result.size() == 2);
+        CHECK(result[0].approved);
+        CHECK_FALSE(result[1].approved);
+        CHECK(result[1].reason
+              == "Tool call denied by policy (deny write_file)");
+        CHECK(out.str().empty());
+    }
+
+    TEST_CASE("Single pending call uses a y/n prompt")
+    {
+        std::istringstream in("y\n");
+        std::ostringstream out;
+        Approver approver(ApprovalPolicy{}, in, out);
+
+        auto const result = approver.review({bash("make")});
+
+        REQUIRE(result.size() == 1);
+        CHECK(result[0].approved);
+        CHECK(out.str() == "\n[tool] bash: make\n[y/n]> ");
+    }
+
+    TEST_CASE("Several pending calls share one prompt")
+    {
+        std::istringstream in("1 3\n");
+        std::ostringstream out;
+        Approver approver(ApprovalPolicy{}, in, out);
+
+        auto const result =
+            approver.review({bash("a"), bash("b"), bash("c")});
+
+        REQUIRE(result.size() == 3);
+        CHECK(result[0].approved);
+        CHECK_FALSE(result[1].approved);
+        CHECK(result[1].reason == "Tool call skipped by user");
+        CHECK(result[2].approved);
+        CHECK(out.str().find("3 calls need approval") != std::string::npos);
+        CHECK(out.str().find("   2. bash: b\n") != std::string::npos);
+    }
+
+    TEST_CASE("Answers other than yes deny everything pending")
+    {
+        std::istringstream in("n\n");
+        std::ostringstream out;
+        Approver approver(ApprovalPolicy{}, in, out);
+
+        auto const result = approver.review({bash("a"), bash("b")});
+
+        CHECK_FALSE(result[0].approved);
+        CHECK_FALSE(result[1].approved);
+    }
+
+    TEST_CASE("Decisions are appended to the audit log")
+    {
+        auto const log = std::filesystem::temp_directory_path()
+            / std::format("wjh_chat_audit_{}.jsonl", getpid());
+        std::filesystem::remove(log);
+
+        std::istringstream in("y\n");
+        std::ostringstream out;
+        Approver approver(policy("deny bash cmd:rm*"), in, out, log);
+        (void)approver.review({bash("rm x"), bash("ls")});
+
+        std::ifstream file(log);
+        std::string line;
+        std::vector<nlohmann::json> entries;
+        while (std::getline(file, line)) {
+            entries.push_back(nlohmann::json::parse(line));
+        }
+        std::filesystem::remove(log);
+
+        REQUIRE(entries.size() == 2);
+        CHECK(entries[0]["call"] == "bash: rm x");
+        CHECK(entries[0]["approved"] == false);
+        CHECK(entries[0]["decided_by"] == "policy");
+        CHECK(entries[0]["rule"] == "deny bash cmd:rm*");
+        CHECK(entries[1]["approved"] == true);
+        CHECK(entries[1]["decided_by"] == "user");
+        CHECK(entries[1].contains("time"));
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,231 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/BlobStore.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+using wjh::chat::json_value;
+
+// Store in a fresh directory, removed on destruction.
+struct TempStore
+{
+    std::filesystem::path dir = std::filesystem::temp_directory_path()
+        / std::format("wjh_chat_blob_test_{}", getpid());
+    BlobStore store{dir};
+
+    TempStore() { std::filesystem::remove_all(dir); }
+    ~TempStore() { std::filesystem::remove_all(dir); }
+
+    TempStore(TempStore const &) = delete;
+    TempStore & operator = (TempStore const &) = delete;
+};
+
+std::string
+numbered_lines(int n)
+{
+    std::string text;
+    for (int i = 1; i <= n; ++i) {
+        text += std::format("line {}\n", i);
+    }
+    return text;
+}
+
+OutputRequest
+request_for(BlobHandle handle)
+{
+    return OutputRequest{
+        .handle = std::move(handle),
+        .offset = 1,
+        .limit = 200,
+        .byte_offset = std::nullopt,
+        .byte_length = 8192};
+}
+
+TEST_SUITE("BlobStore")
+{
+    TEST_CASE("Handles are content addressed")
+    {
+        TempStore t;
+
+        auto const a = t.store.put("hello");
+        auto const b = t.store.put("hello");
+        auto const c = t.store.put("world");
+
+        REQUIRE(a.has_value());
+        REQUIRE(c.has_value());
+        CHECK(*a == *b);
+        CHECK(*a != *c);
+        CHECK(json_value(*a).starts_with("out-"));
+        CHECK(std::filesystem::exists(t.dir / json_value(*a)));
+    }
+
+    TEST_CASE("A handle is not reused for other content")
+    {
+        TempStore t;
+        auto const a = t.store.put("hello");
+        REQUIRE(a.has_value());
+
+        // Stand in for a digest collision.
+        std::ofstream(t.dir / json_value(*a), std::ios::trunc) << "other";
+
+        auto const again = t.store.put("hello");
+        REQUIRE_FALSE(again.has_value());
+        CHECK(again.error().find("is taken") != std::string::npos);
+    }
+
+    TEST_CASE("Read line ranges")
+    {
+        TempStore t;
+        auto const handle = t.store.put(numbered_lines(500));
+        REQUIRE(handle.has_value());
+
+        auto request = request_for(*handle);
+        request.offset = 10;
+        request.limit = 2;
+        auto const result = t.store.read(request, 16 * 1024);
+
+        REQUIRE(result.has_value());
+        CHECK(*result
+              == "    10\tline 10\n"
+                 "    11\tline 11\n"
+                 "[... 489 more lines; continue with offset 12]\n");
+    }
+
+    TEST_CASE("Line reads stop at the byte budget")
+    {
+        TempStore t;
+        auto const handle = t.store.put(numbered_lines(500));
+        REQUIRE(handle.has_value());
+
+        auto const result = t.store.read(request_for(*handle), 64);
+
+        REQUIRE(result.has_value());
+        CHECK(result->ends_with("[... truncated; continue with offset 5]\n"));
+    }
+
+    TEST_CASE("A line longer than the byte budget is cut")
+    {
+        TempStore t;
+        auto const content =
+            "short\n" + std::string(100000, 'x') + "\nafter\n";
+        auto const handle = t.store.put(content);
+        REQUIRE(handle.has_value());
+
+        auto request = request_for(*handle);
+        request.offset = 2;
+        auto const result = t.store.read(request, 1024);
+
+        REQUIRE(result.has_value());
+        CHECK(result->size() < 1024 + 128);
+        CHECK(result->starts_with("     2\txxxx"));
+        CHECK(result->ends_with(
+            "\n[... line 2 cut after 1017 of 100000 bytes; continue with "
+            "byte_offset 1023, or offset 3]\n"));
+
+        request.byte_offset = 1023;
+        request.byte_length = 100000;
+        auto const rest = t.store.read(request, 1u << 20);
+        REQUIRE(rest.has_value());
+        CHECK(*rest == std::string(100000 - 1017, 'x') + "\nafter\n");
+    }
+
+    TEST_CASE("Read byte ranges")
+    {
+        TempStore t;
+        auto const handle = t.store.put("0123456789");
+        REQUIRE(handle.has_value());
+
+        auto request = request_for(*handle);
+        request.byte_offset = 2;
+        request.byte_length = 3;
+        auto const result = t.store.read(request, 1024);
+
+        REQUIRE(result.has_value());
+        CHECK(*result
+              == "234\n[... bytes 2-5 of 10; continue with byte_offset 5]");
+
+        request.byte_offset = 10;
+        CHECK_FALSE(t.store.read(request, 1024).has_value());
+    }
+
+    TEST_CASE("Malformed handles are rejected")
+    {
+        TempStore t;
+
+        auto const result =
+            t.store.read(request_for(BlobHandle{"../../etc/passwd"}), 1024);
+        CHECK_FALSE(result.has_value());
+        CHECK_FALSE(
+            t.store.read(request_for(BlobHandle{"out-0000000000000000"}), 10)
+                .has_value());
+    }
+
+    TEST_CASE("parse_output_request")
+    {
+        auto const request = parse_output_request(nlohmann::json{
+            {"handle", "out-0123456789abcdef"},
+            {"offset", 5},
+            {"byte_offset", 100}});
+
+        REQUIRE(request.has_value());
+        CHECK(request->handle == BlobHandle{"out-0123456789abcdef"});
+        CHECK(request->offset == 5);
+        CHECK(request->limit == 200);
+        CHECK(request->byte_offset == 100u);
+
+        CHECK_FALSE(parse_output_request(nlohmann::json::object()).has_value());
+    }
+}
+
+TEST_SUITE("spill_output")
+{
+    TEST_CASE("Small output is left alone")
+    {
+        TempStore t;
+        std::string output = "short\n";
+
+        CHECK_FALSE(spill_output(output, t.store, SpillOptions{}));
+        CHECK(output == "short\n");
+    }
+
+    TEST_CASE("Large output is stored and summarized")
+    {
+        TempStore t;
+        auto const original = numbered_lines(5000);
+        auto output = original;
+
+        REQUIRE(spill_output(
+            output,
+            t.store,
+            SpillOptions{.threshold = 1024, .head_lines = 3, .tail_lines = 2}));
+
+        CHECK(output.size() < 1024);
+        CHECK(output.find("line 1\nline 2\nline 3\n") != std::string::npos);
+        CHECK(
+            output.find("[... 4995 lines omitted ...]\n")
+            != std::string::npos);
+        CHECK(output.ends_with("line 4999\nline 5000\n"));
+
+        auto const handle = t.store.put(original);
+        REQUIRE(handle.has_value());
+        CHECK(output.find(json_value(*handle)) != std::string::npos);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,163 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/BpeTokenizer.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+
+std::string
+base64(std::string_view bytes)
+{
+    constexpr std::string_view alphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    unsigned bits = 0;
+    int count = 0;
+    for (auto const c : bytes) {
+        bits = (bits << 8) | static_cast<unsigned char>(c);
+        count += 8;
+        while (count >= 6) {
+            count -= 6;
+            out += alphabet[(bits >> count) & 0x3Fu];
+        }
+    }
+    if (count > 0) {
+        out += alphabet[(bits << (6 - count)) & 0x3Fu];
+    }
+    while (out.size() % 4 != 0) {
+        out += '=';
+    }
+    return out;
+}
+
+// Every byte as ranks 0-255, then the given merges in order.
+std::string
+make_vocabulary(std::vector<std::string> const & merges)
+{
+    std::string vocab;
+    for (unsigned b = 0; b < 256; ++b) {
+        auto const byte = std::string(1, static_cast<char>(b));
+        vocab += std::format("{} {}\n", base64(byte), b);
+    }
+    auto rank = 256u;
+    for (auto const & token : merges) {
+        vocab += std::format("{} {}\n", base64(token), rank++);
+    }
+    return vocab;
+}
+
+BpeTokenizer
+make_tokenizer()
+{
+    auto tokenizer = BpeTokenizer::parse(
+        make_vocabulary({"he", "ll", "hell", " w", " wor", "or", "ld"}));
+    REQUIRE(tokenizer.has_value());
+    return std::move(*tokenizer);
+}
+
+TEST_SUITE("BpeTokenizer")
+{
+    TEST_CASE("pretokenize splits words, numbers, and whitespace")
+    {
+        auto const pieces =
+            pretokenize("Hello world's  end\n\n  x 123456 !!\n");
+        auto const expected = std::vector<std::string_view>{
+            "Hello", " world", "'s", " ", " end", "\n\n", " ", " x", " ",
+            "123", "456", " !!\n"};
+        CHECK(pieces == expected);
+    }
+
+    TEST_CASE("pretokenize keeps every byte")
+    {
+        std::string_view const text = "a\tb\r\n  c++ x=1;\n\t\tdone  ";
+        std::string joined;
+        for (auto const piece : pretokenize(text)) {
+            CHECK_FALSE(piece.empty());
+            joined += piece;
+        }
+        CHECK(joined == text);
+    }
+
+    TEST_CASE("merges apply lowest rank first")
+    {
+        auto const tokenizer = make_tokenizer();
+        CHECK(tokenizer.vocabulary_size() == 263u);
+
+        // he(256), ll(257), then hell(258); "o" stays a byte.
+        CHECK(tokenizer.encode("hello")
+              == std::vector<std::uint32_t>{258u, 'o'});
+
+        // " w"(259), "or"(261), " wor"(260), and last "ld"(262).
+        CHECK(tokenizer.encode(" world")
+              == std::vector<std::uint32_t>{260u, 262u});
+    }
+
+    TEST_CASE("a piece in the vocabulary is one token")
+    {
+        auto const tokenizer = make_tokenizer();
+        CHECK(tokenizer.encode("hell") == std::vector<std::uint32_t>{258u});
+    }
+
+    TEST_CASE("count matches encode")
+    {
+        auto const tokenizer = make_tokenizer();
+        for (std::string_view const text : {
+                 "", "hello world", "hello\n\n  hello, world!",
+                 "\xe2\x9c\x93 utf-8 \xf0\x9f\x99\x82 text"})
+        {
+            CHECK(tokenizer.count(text) == tokenizer.encode(text).size());
+        }
+    }
+
+    TEST_CASE("long runs are merged in bounded windows")
+    {
+        auto const tokenizer = make_tokenizer();
+        auto const text = std::string(100'000, 'l');
+        // Every window of 128 bytes is 64 "ll" tokens.
+        CHECK(tokenizer.count(text) == 50'000u);
+    }
+
+    TEST_CASE("malformed vocabularies are rejected")
+    {
+        auto const missing = BpeTokenizer::parse("YQ== 0\n");
+        REQUIRE_FALSE(missing.has_value());
+        CHECK(missing.error().find("no token for byte") != std::string::npos);
+
+        auto const bad = BpeTokenizer::parse(make_vocabulary({}) + "!!! 9\n");
+        REQUIRE_FALSE(bad.has_value());
+        CHECK(bad.error().find("line 257") != std::string::npos);
+    }
+
+    TEST_CASE("load reads a vocabulary file")
+    {
+        auto const path = std::filesystem::temp_directory_path()
+            / "wjh_chat_bpe_ut.tiktoken";
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << make_vocabulary({"he"});
+        }
+        auto const tokenizer = BpeTokenizer::load(path);
+        std::filesystem::remove(path);
+        REQUIRE(tokenizer.has_value());
+        CHECK(tokenizer->count("he") == 1u);
+
+        CHECK_FALSE(BpeTokenizer::load(path).has_value());
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,191 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/BuildDiagnostics.hpp"
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+
+TEST_SUITE("BuildDiagnostics")
+{
+    TEST_CASE("GCC error with notes")
+    {
+        auto const log =
+            "[1/3] Building CXX object src/a.cpp.o\n"
+            "FAILED: src/a.cpp.o\n"
+            "src/a.cpp: In function 'int main()':\n"
+            "src/a.cpp:12:5: error: 'x' was not declared in this scope\n"
+            "   12 |     x = 1;\n"
+            "      |     ^\n"
+            "src/a.hpp:3:6: note: suggested alternative: 'y'\n"
+            "ninja: build stopped: subcommand failed.\n";
+
+        auto const diags = parse_diagnostics(log);
+
+        REQUIRE(diags.size() == 1);
+        CHECK(diags[0].severity == Severity::error);
+        CHECK(diags[0].location == "src/a.cpp:12:5");
+        CHECK(diags[0].message == "'x' was not declared in this scope");
+        REQUIRE(diags[0].notes.size() == 1);
+        CHECK(diags[0].notes[0] == "src/a.hpp:3:6: suggested alternative: 'y'");
+        CHECK(diags[0].occurrences == 1);
+    }
+
+    TEST_CASE("Repeated header diagnostics are folded")
+    {
+        auto const log =
+            "inc/h.hpp:7:1: warning: unused variable 'v' [-Wunused-variable]\n"
+            "inc/h.hpp:7:1: note: declared here\n"
+            "1 warning generated.\n"
+            "inc/h.hpp:7:1: warning: unused variable 'v' [-Wunused-variable]\n"
+            "inc/h.hpp:7:1: note: declared here\n"
+            "1 warning generated.\n";
+
+        auto const diags = parse_diagnostics(log);
+
+        REQUIRE(diags.size() == 1);
+        CHECK(diags[0].severity == Severity::warning);
+        CHECK(diags[0].occurrences == 2);
+        CHECK(diags[0].notes.size() == 1);
+    }
+
+    TEST_CASE("Fatal errors, tool errors, and linker errors")
+    {
+        auto const log =
+            "src/b.cpp:1:10: fatal error: 'nope.hpp' file not found\n"
+            "/usr/bin/ld: b.o: in function `main':\n"
+            "b.cpp:(.text+0x9): undefined reference to `foo()'\n"
+            "clang++: error: linker command failed with exit code 1\n";
+
+        auto const diags = parse_diagnostics(log);
+
+        REQUIRE(diags.size() == 3);
+        CHECK(diags[0].location == "src/b.cpp:1:10");
+        CHECK(diags[0].message == "'nope.hpp' file not found");
+        CHECK(diags[1].location.empty());
+        CHECK(diags[1].message == "undefined reference to `foo()'");
+        CHECK(diags[2].location == "clang++");
+    }
+
+    TEST_CASE("CMake errors consume the indented message")
+    {
+        auto const log =
+            "CMake Error at src/CMakeLists.txt:3 (add_subdirectory):\n"
+            "  add_subdirectory given source \"nope\" which is not an\n"
+            "  existing directory.\n"
+            "\n"
+            "\n"
+            "-- Configuring incomplete, errors occurred!\n";
+
+        auto const diags = parse_diagnostics(log);
+
+        REQUIRE(diags.size() == 1);
+        CHECK(diags[0].location == "src/CMakeLists.txt:3");
+        CHECK(diags[0].message
+              == "add_subdirectory given source \"nope\" which is not an "
+                 "existing directory.");
+    }
+
+    TEST_CASE("doctest failures carry their values")
+    {
+        auto const log =
+            "src/x_ut.cpp:42: ERROR: CHECK( a == b ) is NOT correct!\n"
+            "  values: CHECK( 1 == 2 )\n";
+
+        auto const diags = parse_diagnostics(log);
+
+        REQUIRE(diags.size() == 1);
+        CHECK(diags[0].location == "src/x_ut.cpp:42");
+        REQUIRE(diags[0].notes.size() == 1);
+        CHECK(diags[0].notes[0] == "values: CHECK( 1 == 2 )");
+    }
+
+    TEST_CASE("Ordinary output is not a diagnostic")
+    {
+        auto const log =
+            "-- Build files have been written to: /tmp/b\n"
+            "[2/2] Linking CXX executable chat_ut\n"
+            "note: this is not attached to anything\n"
+            "Error: see above\n";
+
+        CHECK(parse_diagnostics(log).empty());
+    }
+
+    TEST_CASE("ctest summary with failures")
+    {
+        auto const log =
+            "1/2 Test #1: Chat Tests .......***Failed    0.10 sec\n"
+            "2/2 Test #2: Other ............   Passed    0.01 sec\n"
+            "\n"
+            "50% tests passed, 1 tests failed out of 2\n"
+            "\n"
+            "Total Test time (real) =   0.12 sec\n"
+            "\n"
+            "The following tests FAILED:\n"
+            "\t  1 - Chat Tests (Failed)\n"
+            "Errors while running CTest\n";
+
+        auto const summary = parse_test_summary(log);
+
+        REQUIRE(summary.has_value());
+        CHECK(summary->total == 2);
+        CHECK(summary->failed == 1);
+        REQUIRE(summary->failed_tests.size() == 1);
+        CHECK(summary->failed_tests[0] == "Chat Tests (Failed)");
+        CHECK(format_test_summary(*summary)
+              == "Tests: 1/2 passed\n  FAILED: Chat Tests (Failed)\n");
+    }
+
+    TEST_CASE("ctest summary absent or empty")
+    {
+        CHECK_FALSE(parse_test_summary("no tests ran here\n").has_value());
+
+        auto const none = parse_test_summary("No tests were found!!!\n");
+        REQUIRE(none.has_value());
+        CHECK(format_test_summary(*none) == "Tests: none found\n");
+    }
+
+    TEST_CASE("Formatting puts errors first and honors limits")
+    {
+        std::vector<Diagnostic> diags{
+            Diagnostic{
+                .severity = Severity::warning,
+                .location = "a.cpp:1:1",
+                .message = "w1",
+                .notes = {},
+                .occurrences = 1},
+            Diagnostic{
+                .severity = Severity::error,
+                .location = "b.cpp:2:2",
+                .message = "e1",
+                .notes = {"n1", "n2", "n3"},
+                .occurrences = 4},
+            Diagnostic{
+                .severity = Severity::error,
+                .location = "",
+                .message = "e2",
+                .notes = {},
+                .occurrences = 1}};
+
+        auto const text = format_diagnostics(
+            diags,
+            ReportLimits{.max_diagnostics = 2, .max_notes = 1});
+
+        CHECK(text
+              == "2 errors, 1 warning\n"
+                 "error: b.cpp:2:2: e1 [x4]\n"
+                 "  note: n1\n"
+                 "  ... 2 more notes\n"
+                 "error: e2\n"
+                 "... 1 more diagnostics not shown\n");
+        CHECK(format_diagnostics({}, ReportLimits{}) == "No diagnostics.\n");
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,89 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/BuildTool.hpp"
+
+#include "testing/doctest.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+
+namespace {
+using namespace wjh::chat::tools;
+
+TEST_SUITE("BuildTool")
+{
+    TEST_CASE("Omitted arguments take their defaults")
+    {
+        auto const request = parse_build_request(nlohmann::json::object());
+
+        REQUIRE(request);
+        CHECK(request->preset == BuildPreset{"debug"});
+        CHECK(not request->target);
+        CHECK(not request->test_filter);
+        CHECK(not request->configure);
+        CHECK(request->run_tests);
+        auto const defaults = ReportLimits{};
+        CHECK(request->limits.max_diagnostics == defaults.max_diagnostics);
+        CHECK(request->limits.max_notes == defaults.max_notes);
+    }
+
+    TEST_CASE("Report limits are read from the arguments")
+    {
+        auto const request = parse_build_request(nlohmann::json::parse(
+            R"({"target": "chat", "max_diagnostics": 5, "max_notes": 0})"));
+
+        REQUIRE(request);
+        CHECK(request->target == "chat");
+        CHECK(request->limits.max_diagnostics == 5u);
+        CHECK(request->limits.max_notes == 0u);
+    }
+
+    TEST_CASE("Report limits built in code are accepted")
+    {
+        auto const request =
+            parse_build_request(nlohmann::json{{"max_diagnostics", 7}});
+
+        REQUIRE(request);
+        CHECK(request->limits.max_diagnostics == 7u);
+    }
+
+    TEST_CASE("A negative report limit is rejected")
+    {
+        auto const diagnostics = parse_build_request(
+            nlohmann::json::parse(R"({"max_diagnostics": -1})"));
+        auto const notes =
+            parse_build_request(nlohmann::json{{"max_notes", -3}});
+
+        REQUIRE(not diagnostics);
+        CHECK(diagnostics.error().find("max_diagnostics")
+              != std::string::npos);
+        REQUIRE(not notes);
+        CHECK(notes.error().find("max_notes") != std::string::npos);
+    }
+
+    TEST_CASE("A report limit that is not an integer is rejected")
+    {
+        CHECK(not parse_build_request(
+            nlohmann::json::parse(R"({"max_diagnostics": 2.5})")));
+        CHECK(not parse_build_request(
+            nlohmann::json::parse(R"({"max_notes": "3"})")));
+        CHECK(not parse_build_request(
+            nlohmann::json::parse(R"({"max_notes": true})")));
+    }
+
+    TEST_CASE("Arguments of the wrong type are rejected")
+    {
+        CHECK(not parse_build_request(
+            nlohmann::json::parse(R"({"target": 3})")));
+        CHECK(not parse_build_request(
+            nlohmann::json::parse(R"({"configure": "yes"})")));
+    }
+}
+
+} // anonymous namespace
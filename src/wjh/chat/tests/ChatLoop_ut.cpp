@@ -7,9 +7,16 @@
 #define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
 #include "wjh/chat/ChatLoop.hpp"
 #include "wjh/chat/TokenUsage.hpp"
+#include "wjh/chat/json_convert.hpp"
 
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
 #include <sstream>
 
+#include <unistd.h>
+
 #include "testing/MockClient.hpp"
 #include "testing/doctest.hpp"
 
@@ -28,6 +35,15 @@ makeTestConfig()
         .show_config = ShowConfig{false}};
 }
 
+// Exposes the conversation so tests can see what was kept.
+class InspectableLoop
+: public ChatLoop
+{
+public:
+    using ChatLoop::ChatLoop;
+    using ChatLoop::conversation;
+};
+
 TEST_SUITE("ChatLoop")
 {
     TEST_CASE("Normal conversation flow")
@@ -205,6 +221,52 @@ TEST_SUITE("ChatLoop")
         CHECK(output.find("30") != std::string::npos); // prompt
         CHECK(output.find("13") != std::string::npos); // completion
         CHECK(output.find("43") != std::string::npos); // total
+        CHECK(output.find("History:    ~27 tokens (bytes / 4)")
+              != std::string::npos);
+    }
+
+    TEST_CASE("/usage shows prompt cache reads and writes")
+    {
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(ChatResponse{
+            .response = AssistantResponse{"Reply"},
+            .usage = TokenUsage{
+                .prompt_tokens = PromptTokens{2000u},
+                .completion_tokens = CompletionTokens{10u},
+                .total_tokens = TotalTokens{2010u},
+                .cached_tokens = CachedTokens{1500u},
+                .cache_write_tokens = CacheWriteTokens{400u}}});
+
+        std::istringstream in("Hello\n/usage\n/usage all\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        auto output = out.str();
+        CHECK(output.find("Cache:      1500 read (75% of prompt), 400 written")
+              != std::string::npos);
+        CHECK(output.find("2000 prompt (1500 cached)") != std::string::npos);
+    }
+
+    TEST_CASE("/usage counts replayed requests")
+    {
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(ChatResponse{
+            .response = AssistantResponse{"Reply"},
+            .usage = TokenUsage{
+                .replayed_requests = ReplayedRequests{2u}}});
+
+        std::istringstream in("Hello\n/usage\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        auto output = out.str();
+        CHECK(output.find("Replayed:   2 requests from the response cache")
+              != std::string::npos);
+        CHECK(output.find("Prompt:     0\n") != std::string::npos);
     }
 
     TEST_CASE("/usage all shows per-turn breakdown")
@@ -256,6 +318,311 @@ TEST_SUITE("ChatLoop")
               != std::string::npos);
     }
 
+    TEST_CASE("/timing with no data shows message")
+    {
+        auto mock = std::make_unique<testing::MockClient>();
+
+        std::istringstream in("/timing\n/timing all\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        CHECK(out.str().find("No timing data recorded.")
+              != std::string::npos);
+    }
+
+    TEST_CASE("/timing shows the last turn's breakdown")
+    {
+        using namespace std::chrono_literals;
+
+        auto first = ChatResponse{
+            .response = AssistantResponse{"Reply 1"},
+            .usage = std::nullopt};
+        first.timing.wait = 1500ms;
+        first.timing.requests = 1;
+        auto second = ChatResponse{
+            .response = AssistantResponse{"Reply 2"},
+            .usage = std::nullopt};
+        second.timing.wait = 2s;
+        second.timing.download = 40ms;
+        second.timing.tools = 250us;
+        second.timing.requests = 2;
+        second.timing.tool_calls.push_back(
+            ToolTiming{.name = "read_file", .elapsed = 250us});
+
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(std::move(first));
+        mock->queue_response(std::move(second));
+
+        std::istringstream in("Hello\nWorld\n/timing\n/timing all\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        auto const output = out.str();
+        CHECK(output.find("over 2 requests") != std::string::npos);
+        CHECK(output.find("Wait:       2.00 s") != std::string::npos);
+        CHECK(output.find("Download:   40.0 ms") != std::string::npos);
+        CHECK(output.find("    read_file    250 us") != std::string::npos);
+        CHECK(output.find("Per-turn timing") != std::string::npos);
+        CHECK(output.find("1.50 s") != std::string::npos);
+        CHECK(output.find("over 3 requests; waiting 3.50 s")
+              != std::string::npos);
+    }
+
+    TEST_CASE("/clear resets timing history")
+    {
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(AssistantResponse{"Reply"});
+
+        std::istringstream in("Hello\n/clear\n/timing\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        CHECK(out.str().find("No timing data recorded.")
+              != std::string::npos);
+    }
+
+    TEST_CASE("/stats reports session metrics")
+    {
+        using namespace std::chrono_literals;
+
+        auto first = ChatResponse{
+            .response = AssistantResponse{"Reply 1"},
+            .usage = TokenUsage{
+                .prompt_tokens = PromptTokens{100u},
+                .completion_tokens = CompletionTokens{50u},
+                .total_tokens = TotalTokens{150u}}};
+        first.timing.wait = 500ms;
+        first.timing.first_response = 600ms;
+        first.timing.requests = 2;
+        first.timing.retries = 1;
+        first.timing.bytes_sent = 1000;
+        first.timing.tool_calls.push_back(
+            ToolTiming{.name = "read_file", .elapsed = 250us});
+        auto second = ChatResponse{
+            .response = AssistantResponse{"Reply 2"},
+            .usage = TokenUsage{
+                .replayed_requests = ReplayedRequests{1u}}};
+
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(std::move(first));
+        mock->queue_response(std::move(second));
+        // A failed turn still sent a request.
+        auto failed = TurnTiming{};
+        failed.requests = 1;
+        failed.bytes_sent = 300;
+        failed.request_times.push_back(2s);
+        mock->queue_error("Network timeout", std::move(failed));
+
+        std::istringstream in("Hello\nWorld\nAgain\n/clear\n/stats\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        auto const output = out.str();
+        auto const has = [&output](std::string const & name, int value) {
+            auto const line = std::format("  {:<48s} {:>10d}\n", name, value);
+            return output.find(line) != std::string::npos;
+        };
+        CHECK(has("chat_turns_total", 2));
+        CHECK(has("chat_turn_errors_total{status=\"none\"}", 1));
+        CHECK(has("chat_requests_total", 3));
+        CHECK(has("chat_retries_total", 1));
+        CHECK(has("chat_sent_bytes_total", 1300));
+        CHECK(has("chat_completion_tokens_total", 50));
+        CHECK(has("chat_response_cache_hits_total", 1));
+        CHECK(has("chat_tool_calls_total{tool=\"read_file\"}", 1));
+        CHECK(output.find(std::format(
+                  "  {:<40s} {:>6d} {:>9s}",
+                  "chat_completion_tokens_per_second", 1, "100"))
+              != std::string::npos);
+        CHECK(output.find("chat_tool_duration_us{tool=\"read_file\"}")
+              != std::string::npos);
+        CHECK(output.find("250 us") != std::string::npos);
+        CHECK(output.find("600.0 ms") != std::string::npos);
+        CHECK(output.find(std::format(
+                  "  {:<40s} {:>6d}", "chat_request_duration_us", 1))
+              != std::string::npos);
+    }
+
+    TEST_CASE("STATS_FILE receives the metrics as JSON on exit")
+    {
+        auto const path = std::filesystem::temp_directory_path()
+            / std::format("wjh_chat_stats_{}.json", getpid());
+        std::filesystem::remove(path);
+
+        auto config = makeTestConfig();
+        config.stats_file = path;
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(AssistantResponse{"Reply"});
+
+        std::istringstream in("Hello\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(config, std::move(mock), in, out);
+
+        std::ifstream file(path);
+        auto const json = nlohmann::json::parse(file);
+        file.close();
+        std::filesystem::remove(path);
+
+        CHECK(result == ExitCode::success);
+        CHECK(json["counters"]["chat_turns_total"] == 1);
+        CHECK(json["gauges"]["chat_history_messages"] == 2);
+        CHECK(json["histograms"]["chat_turn_duration_us"]["count"] == 1);
+    }
+
+    TEST_CASE("TRACE_FILE receives each turn's spans on exit")
+    {
+        auto const path = std::filesystem::temp_directory_path()
+            / std::format("wjh_chat_loop_trace_{}.json", getpid());
+        std::filesystem::remove(path);
+
+        auto config = makeTestConfig();
+        config.trace_file = path;
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(AssistantResponse{"Reply 1"});
+        mock->queue_response(AssistantResponse{"Reply 2"});
+
+        std::istringstream in("Hello\nWorld\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(config, std::move(mock), in, out);
+
+        std::ifstream file(path);
+        auto const trace = nlohmann::json::parse(file);
+        file.close();
+        std::filesystem::remove(path);
+
+        CHECK(result == ExitCode::success);
+        auto turns = 0;
+        auto sends = 0;
+        for (auto const & event : trace["traceEvents"]) {
+            turns += event["name"] == "turn" ? 1 : 0;
+            sends += event["name"] == "send_message" ? 1 : 0;
+        }
+        CHECK(turns == 2);
+        CHECK(sends == 2);
+    }
+
+    TEST_CASE("/wirelog switches wire logging")
+    {
+        auto const path = std::filesystem::temp_directory_path()
+            / std::format("wjh_chat_loop_wire_{}.log", getpid());
+
+        auto mock = std::make_unique<testing::MockClient>();
+        std::istringstream in(std::format(
+            "/wirelog\n/wirelog on {}\n/wirelog off\n/wirelog\n"
+            "/wirelog on\n/exit\n",
+            path.string()));
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+        auto const exists = std::filesystem::exists(path);
+        std::filesystem::remove(path);
+
+        CHECK(result == ExitCode::success);
+        CHECK(exists);
+        auto const text = out.str();
+        auto const off = text.find("Wire logging off.");
+        auto const on = text.find("Wire logging on: " + path.string());
+        auto const paused = text.find("Wire logging paused: ");
+        auto const resumed = text.rfind("Wire logging on: " + path.string());
+        CHECK(off < on);
+        CHECK(on < paused);
+        CHECK(paused != std::string::npos);
+        CHECK(paused < resumed);
+    }
+
+    TEST_CASE("Tool calls and results are kept for later turns")
+    {
+        using conversation::Message;
+        using conversation::MessageText;
+        using conversation::ToolCallId;
+
+        auto response = ChatResponse{
+            .response = AssistantResponse{"Read it"},
+            .usage = std::nullopt,
+            .tool_messages = {
+                Message::tool_calls(
+                    {conversation::ToolCall{
+                        .id = ToolCallId{"call_1"},
+                        .name = "read_file",
+                        .arguments = "{}"}},
+                    MessageText{""}),
+                Message::tool_result(
+                    ToolCallId{"call_1"},
+                    MessageText{"data"})}};
+
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(std::move(response));
+        mock->queue_response(AssistantResponse{"Second"});
+
+        std::istringstream in("First\nAgain\n/exit\n");
+        std::ostringstream out;
+        InspectableLoop loop(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(loop.run() == ExitCode::success);
+        auto const & messages = loop.conversation().messages();
+        REQUIRE(messages.size() == 6);
+        CHECK(messages[1].calls().size() == 1);
+        CHECK(messages[2].is_tool_result());
+        CHECK(messages[2].text() == MessageText{"data"});
+        CHECK(messages[3].text() == MessageText{"Read it"});
+    }
+
+    TEST_CASE("TOOL_HISTORY=off keeps only the text")
+    {
+        auto response = ChatResponse{
+            .response = AssistantResponse{"Read it"},
+            .usage = std::nullopt,
+            .tool_messages = {conversation::Message::tool_result(
+                conversation::ToolCallId{"call_1"},
+                conversation::MessageText{"data"})}};
+
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(std::move(response));
+        mock->queue_response(AssistantResponse{"Second"});
+
+        auto config = makeTestConfig();
+        config.tool_retention.persist = false;
+        std::istringstream in("First\nAgain\n/exit\n");
+        std::ostringstream out;
+        InspectableLoop loop(config, std::move(mock), in, out);
+
+        CHECK(loop.run() == ExitCode::success);
+        CHECK(loop.conversation().messages().size() == 4);
+    }
+
+    TEST_CASE("Old turns are summarized before the next send")
+    {
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(AssistantResponse{std::string(4000, 'a')});
+        mock->queue_response(AssistantResponse{std::string(4000, 'b')});
+        mock->queue_completion(AssistantResponse{"Two long answers."});
+        mock->queue_response(AssistantResponse{"Third"});
+
+        auto config = makeTestConfig();
+        config.compaction.threshold_tokens = 1000;
+        config.compaction.keep_turns = 1;
+        std::istringstream in("One\nTwo\nThree\n/exit\n");
+        std::ostringstream out;
+        InspectableLoop loop(config, std::move(mock), in, out);
+
+        CHECK(loop.run() == ExitCode::success);
+        auto const & messages = loop.conversation().messages();
+        REQUIRE(messages.size() == 5);
+        CHECK(json_value(messages[0].text()).ends_with("Two long answers."));
+        CHECK(messages[1].text() == conversation::MessageText{"Two"});
+        CHECK(messages[3].text() == conversation::MessageText{"Three"});
+    }
+
     TEST_CASE("/help lists usage commands")
     {
         auto mock = std::make_unique<testing::MockClient>();
@@ -194,6 +194,24 @@ TEST_SUITE("CommandLine")
         CHECK(*result->max_tokens == MaxTokens{1024u});
     }
 
+    TEST_CASE("--wire-log takes a file")
+    {
+        char const * args[] = {"chat_app", "--wire-log", "wire.log"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->wire_log == std::filesystem::path("wire.log"));
+    }
+
+    TEST_CASE("Missing argument for --wire-log")
+    {
+        char const * args[] = {"chat_app", "--wire-log"};
+        auto result = parse_args(args);
+
+        REQUIRE_FALSE(result.has_value());
+        CHECK(result.error().find("--wire-log") != std::string::npos);
+    }
+
     TEST_CASE("Unknown argument")
     {
         char const * args[] = {"chat_app", "--unknown"};
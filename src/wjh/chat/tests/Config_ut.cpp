@@ -7,6 +7,7 @@
 #define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
 #include "wjh/chat/Config.hpp"
 
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
 #include <format>
@@ -242,6 +243,152 @@ TEST_SUITE("Config")
         CHECK_FALSE(result.has_value());
     }
 
+    TEST_CASE("resolve_config: tool policy from env")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard policy_guard(
+            "TOOL_POLICY", "allow bash cmd:ls*; deny write_file");
+        EnvGuard audit_guard("TOOL_AUDIT_LOG", "audit.jsonl");
+        CommandLineArgs args;
+        auto result = resolve_config(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->tool_policy.rules().size() == 2);
+        CHECK(result->tool_audit_log == std::filesystem::path("audit.jsonl"));
+    }
+
+    TEST_CASE("resolve_config: invalid TOOL_POLICY")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard policy_guard("TOOL_POLICY", "permit bash");
+        CommandLineArgs args;
+        auto result = resolve_config(args);
+
+        REQUIRE_FALSE(result.has_value());
+        CHECK(result.error().find("TOOL_POLICY") != std::string::npos);
+    }
+
+    TEST_CASE("resolve_config: response cache from env")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard dir_guard("RESPONSE_CACHE_DIR", "responses");
+        EnvGuard size_guard("RESPONSE_CACHE_MAX_BYTES", "1048576");
+        CommandLineArgs args;
+        auto result = resolve_config(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->response_cache.dir
+              == std::filesystem::path("responses"));
+        CHECK(result->response_cache.max_bytes == 1048576u);
+    }
+
+    TEST_CASE("resolve_config: invalid RESPONSE_CACHE_MAX_BYTES")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard size_guard("RESPONSE_CACHE_MAX_BYTES", "0");
+        CommandLineArgs args;
+        auto result = resolve_config(args);
+
+        REQUIRE_FALSE(result.has_value());
+        CHECK(result.error().find("RESPONSE_CACHE_MAX_BYTES")
+              != std::string::npos);
+    }
+
+    TEST_CASE("resolve_config: metrics export from env")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard file_guard("METRICS_FILE", "chat.prom");
+        EnvGuard interval_guard("METRICS_INTERVAL", "60");
+        CommandLineArgs args;
+        auto result = resolve_config(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->metrics_file == std::filesystem::path("chat.prom"));
+        CHECK(result->metrics_interval == std::chrono::seconds(60));
+    }
+
+    TEST_CASE("resolve_config: invalid METRICS_INTERVAL")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard interval_guard("METRICS_INTERVAL", "0");
+        CommandLineArgs args;
+        auto result = resolve_config(args);
+
+        REQUIRE_FALSE(result.has_value());
+        CHECK(result.error().find("METRICS_INTERVAL") != std::string::npos);
+    }
+
+    TEST_CASE("resolve_config: WIRE_LOG and WIRE_LOG_BYTES")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard log_guard("WIRE_LOG", "env.log");
+        EnvGuard bytes_guard("WIRE_LOG_BYTES", "4096");
+        CommandLineArgs args;
+        auto result = resolve_config(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->wire_log == std::filesystem::path("env.log"));
+        CHECK(result->wire_log_bytes == 4096u);
+    }
+
+    TEST_CASE("resolve_config: --wire-log overrides WIRE_LOG")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard log_guard("WIRE_LOG", "env.log");
+        EnvGuard bytes_guard("WIRE_LOG_BYTES", nullptr);
+        CommandLineArgs args;
+        args.wire_log = std::filesystem::path("cli.log");
+        auto result = resolve_config(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->wire_log == std::filesystem::path("cli.log"));
+        CHECK(result->wire_log_bytes == 64u << 20);
+    }
+
+    TEST_CASE("resolve_config: invalid WIRE_LOG_BYTES")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard bytes_guard("WIRE_LOG_BYTES", "0");
+        CommandLineArgs args;
+        auto result = resolve_config(args);
+
+        REQUIRE_FALSE(result.has_value());
+        CHECK(result.error().find("WIRE_LOG_BYTES") != std::string::npos);
+    }
+
+    TEST_CASE("resolve_config: PERF_COUNTERS")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard perf_guard("PERF_COUNTERS", "on");
+        CommandLineArgs args;
+        auto result = resolve_config(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->perf_counters);
+    }
+
+    TEST_CASE("resolve_config: invalid PERF_COUNTERS")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard perf_guard("PERF_COUNTERS", "sometimes");
+        CommandLineArgs args;
+        auto result = resolve_config(args);
+
+        REQUIRE_FALSE(result.has_value());
+        CHECK(result.error().find("PERF_COUNTERS") != std::string::npos);
+    }
+
     TEST_CASE("append_agents_file: no file leaves config "
               "unchanged")
     {
@@ -331,6 +478,39 @@ TEST_SUITE("Config")
         CHECK_FALSE(config.system_prompt.has_value());
     }
 
+    TEST_CASE("append_agents_file: line endings and "
+              "trailing blanks do not change the prompt")
+    {
+        TempDir plain;
+        plain.write_file("AGENTS.md", "# Rules\nDo X.\n");
+        TempDir noisy;
+        noisy.write_file("AGENTS.md", "# Rules  \r\nDo X.\t\r\n\r\n\n");
+        auto a = make_test_config();
+        auto b = make_test_config();
+
+        append_agents_file(a, plain.path_);
+        append_agents_file(b, noisy.path_);
+
+        REQUIRE(a.system_prompt.has_value());
+        REQUIRE(b.system_prompt.has_value());
+        CHECK(*a.system_prompt == *b.system_prompt);
+        CHECK(std::format("{}", *a.system_prompt)
+                  .find("# Rules\nDo X.\n</system-reminder>")
+              != std::string::npos);
+    }
+
+    TEST_CASE("append_agents_file: blank file leaves "
+              "config unchanged")
+    {
+        TempDir dir;
+        dir.write_file("AGENTS.md", " \r\n\t\n");
+        auto config = make_test_config();
+
+        append_agents_file(config, dir.path_);
+
+        CHECK_FALSE(config.system_prompt.has_value());
+    }
+
     TEST_CASE("append_agents_file: wrapper tags have "
               "correct structure")
     {
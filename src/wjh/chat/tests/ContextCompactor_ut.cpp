@@ -0,0 +1,171 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/ContextCompactor.hpp"
+#include "wjh/chat/TokenEstimator.hpp"
+#include "wjh/chat/json_convert.hpp"
+
+#include <format>
+#include <string>
+
+#include "testing/MockClient.hpp"
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+using conversation::Conversation;
+using conversation::Role;
+
+// A conversation of `turns` user/assistant pairs, each about 1000
+// tokens by the byte estimate.
+Conversation
+make_conversation(int turns)
+{
+    Conversation conv;
+    for (int i = 0; i < turns; ++i) {
+        conv.add_message(UserInput{
+            std::format("question {} ", i) + std::string(2000, 'q')});
+        conv.add_message(AssistantResponse{
+            std::format("answer {} ", i) + std::string(2000, 'a')});
+    }
+    return conv;
+}
+
+CompactionOptions
+make_options(std::size_t threshold, std::size_t keep_turns)
+{
+    return CompactionOptions{
+        .threshold_tokens = threshold,
+        .keep_turns = keep_turns,
+        .model = ModelId{"cheap-model"}};
+}
+
+TEST_SUITE("ContextCompactor")
+{
+    TEST_CASE("below the threshold nothing is started")
+    {
+        testing::MockClient client;
+        TokenEstimator estimator;
+        ContextCompactor compactor(make_options(100'000, 2));
+        auto conv = make_conversation(6);
+
+        CHECK_FALSE(compactor.start(conv, estimator.estimate(conv), client));
+        CHECK_FALSE(compactor.pending());
+        auto const replaced = compactor.finish(conv);
+        REQUIRE(replaced);
+        CHECK(*replaced == 0u);
+        CHECK(conv.size() == 12u);
+    }
+
+    TEST_CASE("threshold 0 disables compaction")
+    {
+        testing::MockClient client;
+        TokenEstimator estimator;
+        ContextCompactor compactor(make_options(0, 2));
+        auto conv = make_conversation(6);
+        CHECK_FALSE(compactor.start(conv, estimator.estimate(conv), client));
+    }
+
+    TEST_CASE("too few turns leaves nothing to summarize")
+    {
+        testing::MockClient client;
+        TokenEstimator estimator;
+        ContextCompactor compactor(make_options(100, 4));
+        auto conv = make_conversation(4);
+        CHECK_FALSE(compactor.start(conv, estimator.estimate(conv), client));
+    }
+
+    TEST_CASE("old turns are replaced by the summary")
+    {
+        testing::MockClient client;
+        TokenEstimator estimator;
+        client.queue_completion(AssistantResponse{"They asked 4 things."});
+        ContextCompactor compactor(make_options(1000, 2));
+        auto conv = make_conversation(6);
+
+        REQUIRE(compactor.start(conv, estimator.estimate(conv), client));
+        CHECK(compactor.pending());
+
+        // The next user turn arrives while the summary is running.
+        conv.add_message(UserInput{"next"});
+        auto const replaced = compactor.finish(conv);
+        REQUIRE(replaced);
+        CHECK(*replaced == 8u);
+        CHECK_FALSE(compactor.pending());
+
+        // Summary + the two kept turns + the new input.
+        REQUIRE(conv.size() == 6u);
+        auto const & first = conv.messages().front();
+        CHECK(first.role() == Role::user);
+        std::string_view const text = json_value(first.text());
+        CHECK(text.starts_with("[Summary of the earlier conversation"));
+        CHECK(text.ends_with("They asked 4 things."));
+        std::string_view const kept = json_value(conv.messages()[1].text());
+        CHECK(kept.starts_with("question 4 "));
+
+        REQUIRE(client.last_completion_model());
+        CHECK(*client.last_completion_model() == ModelId{"cheap-model"});
+    }
+
+    TEST_CASE("the summarizer sees a transcript of the old turns only")
+    {
+        testing::MockClient client;
+        TokenEstimator estimator;
+        client.queue_completion(AssistantResponse{"summary"});
+        ContextCompactor compactor(make_options(1000, 2));
+        auto conv = make_conversation(6);
+
+        REQUIRE(compactor.start(conv, estimator.estimate(conv), client));
+        REQUIRE(compactor.finish(conv));
+
+        auto const * request = client.last_completion_conversation();
+        REQUIRE(request != nullptr);
+        CHECK(request->system_prompt().has_value());
+        REQUIRE(request->size() == 1u);
+        std::string_view const transcript =
+            json_value(request->messages()[0].text());
+        CHECK(transcript.find("User: question 0 ") != std::string::npos);
+        CHECK(transcript.find("Assistant: answer 3 ") != std::string::npos);
+        CHECK(transcript.find("question 4 ") == std::string::npos);
+    }
+
+    TEST_CASE("a failed summary leaves the history alone")
+    {
+        testing::MockClient client;
+        TokenEstimator estimator;
+        client.queue_completion(wjh::chat::make_error("overloaded"));
+        ContextCompactor compactor(make_options(1000, 2));
+        auto conv = make_conversation(6);
+
+        REQUIRE(compactor.start(conv, estimator.estimate(conv), client));
+        auto const replaced = compactor.finish(conv);
+        REQUIRE_FALSE(replaced);
+        CHECK(replaced.error().find("overloaded") != std::string::npos);
+        CHECK(conv.size() == 12u);
+        CHECK_FALSE(compactor.pending());
+    }
+
+    TEST_CASE("a cleared history is not overwritten")
+    {
+        testing::MockClient client;
+        TokenEstimator estimator;
+        client.queue_completion(AssistantResponse{"summary"});
+        ContextCompactor compactor(make_options(1000, 2));
+        auto conv = make_conversation(6);
+
+        REQUIRE(compactor.start(conv, estimator.estimate(conv), client));
+        compactor.cancel();
+        CHECK_FALSE(compactor.pending());
+        conv.clear();
+        auto const replaced = compactor.finish(conv);
+        REQUIRE(replaced);
+        CHECK(*replaced == 0u);
+        CHECK(conv.size() == 0u);
+    }
+}
+
+} // anonymous namespace
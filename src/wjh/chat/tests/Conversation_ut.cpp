@@ -7,6 +7,11 @@
 #define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
 #include "wjh/chat/conversation/Conversation.hpp"
 
+#include "wjh/chat/json_convert.hpp"
+
+#include <limits>
+#include <string>
+
 #include "testing/doctest.hpp"
 
 namespace {
@@ -87,6 +92,98 @@ TEST_SUITE("Conversation")
         CHECK(json[1]["role"] == "assistant");
         CHECK(json[1]["content"] == "Hi there");
     }
+
+    TEST_CASE("Old tool results are trimmed")
+    {
+        auto const long_output = std::string(100, 'x') + "\n"
+            + std::string(100, 'y') + "\n" + std::string(1000, 'z');
+        auto add_turn = [&long_output](Conversation & conv, char const * id) {
+            conv.add_message(UserInput{"go"});
+            conv.add_message(Message::tool_calls(
+                {ToolCall{
+                    .id = ToolCallId{id},
+                    .name = "bash",
+                    .arguments = "{}"}},
+                MessageText{""}));
+            conv.add_message(Message::tool_result(
+                ToolCallId{id},
+                MessageText{long_output}));
+            conv.add_message(AssistantResponse{"done"});
+        };
+
+        Conversation conv;
+        add_turn(conv, "c1");
+        add_turn(conv, "c2");
+
+        auto retention = ToolRetention{};
+        retention.full_turns = 1;
+        retention.trimmed_bytes = 250;
+
+        // c1 is one turn past the window; cutting waits for a batch.
+        CHECK(conv.trim_tool_results(retention) == 0);
+
+        add_turn(conv, "c3");
+        auto const removed = conv.trim_tool_results(retention);
+
+        auto const & old = conv.messages()[2];
+        auto const & text = json_value(old.text());
+        CHECK(old.tool_call_id() == ToolCallId{"c1"});
+        CHECK(text.starts_with(
+            std::string(100, 'x') + "\n" + std::string(100, 'y')
+            + "\n[... 1000 of 1202"));
+        CHECK(json_value(conv.messages()[6].text()) == text);
+        CHECK(removed == 2 * (long_output.size() - text.size()));
+        CHECK(json_value(conv.messages()[10].text()) == long_output);
+
+        // Running again changes nothing.
+        CHECK(conv.trim_tool_results(retention) == 0);
+    }
+
+    TEST_CASE("Nothing is trimmed within the retention window")
+    {
+        Conversation conv;
+        conv.add_message(UserInput{"go"});
+        conv.add_message(Message::tool_result(
+            ToolCallId{"c1"},
+            MessageText{std::string(1000, 'x')}));
+
+        CHECK(conv.trim_tool_results(ToolRetention{}) == 0);
+    }
+
+    TEST_CASE("replace_prefix swaps the oldest messages for one")
+    {
+        Conversation conv;
+        conv.add_message(UserInput{"a"});
+        conv.add_message(AssistantResponse{"b"});
+        conv.add_message(UserInput{"c"});
+
+        conv.replace_prefix(2, Message::user(UserInput{"summary"}));
+
+        REQUIRE(conv.size() == 2);
+        CHECK(conv.messages()[0].text() == MessageText{"summary"});
+        CHECK(conv.messages()[1].text() == MessageText{"c"});
+    }
+
+    TEST_CASE("parse_tool_retention")
+    {
+        auto const off = parse_tool_retention("off");
+        REQUIRE(off.has_value());
+        CHECK_FALSE(off->persist);
+
+        auto const all = parse_tool_retention("all");
+        REQUIRE(all.has_value());
+        CHECK(all->persist);
+        CHECK(all->full_turns == std::numeric_limits<std::size_t>::max());
+
+        auto const custom = parse_tool_retention("2:1024");
+        REQUIRE(custom.has_value());
+        CHECK(custom->full_turns == 2);
+        CHECK(custom->trimmed_bytes == 1024);
+
+        CHECK(parse_tool_retention("3")->full_turns == 3);
+        CHECK_FALSE(parse_tool_retention("some").has_value());
+        CHECK_FALSE(parse_tool_retention("2:").has_value());
+    }
 }
 
 } // anonymous namespace
@@ -0,0 +1,225 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "testing/FakeOpenRouter.hpp"
+
+#include "wjh/chat/client/PromptCache.hpp"
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace std::chrono_literals;
+using nlohmann::json;
+using testing::FakeOpenRouter;
+using testing::FakeOptions;
+using testing::Latency;
+
+std::string
+request(char const * text, bool stream = false)
+{
+    return json{
+        {"model", "test/model"},
+        {"stream", stream},
+        {"messages",
+         json::array(
+             {{{"role", "system"}, {"content", "Be brief."}},
+              {{"role", "user"}, {"content", text}}})}}
+        .dump();
+}
+
+json
+body_of(testing::FakeReply const & reply)
+{
+    REQUIRE(reply.chunks.size() == 1);
+    return json::parse(reply.chunks.front());
+}
+
+std::vector<json>
+events_of(testing::FakeReply const & reply)
+{
+    std::vector<json> events;
+    for (auto const & chunk : reply.chunks) {
+        REQUIRE(chunk.starts_with("data: "));
+        REQUIRE(chunk.ends_with("\n\n"));
+        auto const data = chunk.substr(6, chunk.size() - 8);
+        if (data != "[DONE]") {
+            events.push_back(json::parse(data));
+        }
+    }
+    return events;
+}
+
+TEST_SUITE("FakeOpenRouter")
+{
+    TEST_CASE("parse_latency")
+    {
+        auto const fixed = testing::parse_latency("200ms");
+        REQUIRE(fixed.has_value());
+        CHECK(fixed->kind == Latency::Kind::fixed);
+        CHECK(fixed->first == 200ms);
+
+        auto const uniform = testing::parse_latency("uniform:50ms:1s");
+        REQUIRE(uniform.has_value());
+        CHECK(uniform->kind == Latency::Kind::uniform);
+        CHECK(uniform->first == 50ms);
+        CHECK(uniform->second == 1s);
+
+        auto const normal = testing::parse_latency("normal:200ms:500us");
+        REQUIRE(normal.has_value());
+        CHECK(normal->kind == Latency::Kind::normal);
+        CHECK(normal->second == 500us);
+
+        CHECK(testing::parse_latency("fixed:3s")->first == 3s);
+        CHECK_FALSE(testing::parse_latency("200").has_value());
+        CHECK_FALSE(testing::parse_latency("uniform:2s:1s").has_value());
+        CHECK_FALSE(testing::parse_latency("gamma:1s:1s").has_value());
+    }
+
+    TEST_CASE("Latency samples stay in range")
+    {
+        std::mt19937_64 rng(7);
+        auto const uniform = *testing::parse_latency("uniform:10ms:20ms");
+        auto const normal = *testing::parse_latency("normal:1ms:10ms");
+        for (int i = 0; i < 1000; ++i) {
+            auto const u = uniform.sample(rng);
+            CHECK((u >= 10ms and u <= 20ms));
+            CHECK(normal.sample(rng) >= 0us);
+        }
+    }
+
+    TEST_CASE("parse_faults")
+    {
+        auto const faults = testing::parse_faults("429:0.25,503:0.5");
+        REQUIRE(faults.has_value());
+        REQUIRE(faults->size() == 2);
+        CHECK((*faults)[0].status == 429);
+        CHECK((*faults)[1].probability == doctest::Approx(0.5));
+
+        CHECK_FALSE(testing::parse_faults("200:0.1").has_value());
+        CHECK_FALSE(testing::parse_faults("500").has_value());
+        CHECK_FALSE(testing::parse_faults("500:0.6,502:0.6").has_value());
+    }
+
+    TEST_CASE("parse_script")
+    {
+        auto const script = testing::parse_script(
+            "{\"content\": \"hi\"}\n"
+            "\n"
+            "{\"tool_calls\": [{\"name\": \"read_file\"}]}\n"
+            "{\"status\": 503, \"error\": \"busy\"}\n");
+        REQUIRE(script.has_value());
+        CHECK(script->size() == 3);
+
+        auto const bad = testing::parse_script(
+            "{\"content\": \"hi\"}\n{\"tool_calls\": []}\n");
+        REQUIRE_FALSE(bad.has_value());
+        CHECK(bad.error().starts_with("line 2:"));
+        CHECK_FALSE(testing::parse_script("{\"status\": 200}").has_value());
+    }
+
+    TEST_CASE("Without a script the last user message is echoed")
+    {
+        FakeOpenRouter fake(FakeOptions{});
+        auto const body = request("ping");
+
+        auto const reply = fake.respond(body);
+
+        CHECK(reply.status == 200);
+        auto const json = body_of(reply);
+        CHECK(json["model"] == "test/model");
+        CHECK(json["choices"][0]["message"]["content"] == "You said: ping");
+        CHECK(json["choices"][0]["finish_reason"] == "stop");
+        auto const usage = wjh::chat::client::parse_usage(json["usage"]);
+        CHECK(usage.prompt_tokens
+              == wjh::chat::PromptTokens{
+                  static_cast<std::uint32_t>((body.size() + 3) / 4)});
+        CHECK(fake.requests() == 1);
+    }
+
+    TEST_CASE("Scripted replies repeat in order")
+    {
+        auto options = FakeOptions{};
+        options.script = *testing::parse_script(
+            "{\"tool_calls\": [{\"name\": \"read_file\","
+            " \"arguments\": {\"path\": \"a.txt\"}}]}\n"
+            "{\"status\": 503, \"error\": \"busy\"}\n");
+        FakeOpenRouter fake(std::move(options));
+
+        auto const first = body_of(fake.respond(request("go")));
+        auto const & message = first["choices"][0]["message"];
+        CHECK(message["content"].is_null());
+        CHECK(first["choices"][0]["finish_reason"] == "tool_calls");
+        REQUIRE(message["tool_calls"].size() == 1);
+        auto const & call = message["tool_calls"][0];
+        CHECK(call["function"]["name"] == "read_file");
+        CHECK(json::parse(call["function"]["arguments"].get<std::string>())
+              == json{{"path", "a.txt"}});
+
+        auto const second = fake.respond(request("go"));
+        CHECK(second.status == 503);
+        CHECK(body_of(second)["error"]["message"] == "busy");
+
+        CHECK(fake.respond(request("go")).status == 200);
+    }
+
+    TEST_CASE("Streamed replies are server-sent events")
+    {
+        auto options = FakeOptions{};
+        options.chunk_delay = 5ms;
+        FakeOpenRouter fake(std::move(options));
+
+        auto const reply = fake.respond(request("a b", true));
+
+        CHECK(reply.content_type == "text/event-stream");
+        CHECK(reply.chunk_delay == 5ms);
+        CHECK(reply.chunks.back() == "data: [DONE]\n\n");
+        std::string text;
+        auto const events = events_of(reply);
+        for (auto const & event : events) {
+            CHECK(event["object"] == "chat.completion.chunk");
+            text += event["choices"][0]["delta"].value("content", "");
+        }
+        CHECK(text == "You said: a b");
+        CHECK(events.size() == 6);
+        CHECK(events.back()["choices"][0]["finish_reason"] == "stop");
+        CHECK(events.back().contains("usage"));
+    }
+
+    TEST_CASE("Faults replace replies at their rate")
+    {
+        auto options = FakeOptions{};
+        options.faults = *testing::parse_faults("429:1");
+        FakeOpenRouter fake(std::move(options));
+
+        auto const reply = fake.respond(request("hi"));
+
+        CHECK(reply.status == 429);
+        REQUIRE(reply.headers.size() == 1);
+        CHECK(reply.headers[0].first == "Retry-After");
+        CHECK(body_of(reply)["error"]["code"] == 429);
+    }
+
+    TEST_CASE("Invalid requests get a 400")
+    {
+        FakeOpenRouter fake(FakeOptions{});
+
+        CHECK(fake.respond("not json").status == 400);
+    }
+
+    TEST_CASE("Latency comes from the options")
+    {
+        auto options = FakeOptions{};
+        options.latency = *testing::parse_latency("uniform:1ms:2ms");
+        FakeOpenRouter fake(std::move(options));
+
+        auto const delay = fake.respond(request("hi")).delay;
+
+        CHECK((delay >= 1ms and delay <= 2ms));
+    }
+}
+
+} // anonymous namespace
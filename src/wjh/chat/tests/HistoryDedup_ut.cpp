@@ -0,0 +1,164 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/HistoryDedup.hpp"
+
+#include <string>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+using nlohmann::json;
+
+json
+assistant_call(std::string id, std::string name, json args)
+{
+    return json{
+        {"role", "assistant"},
+        {"content", nullptr},
+        {"tool_calls",
+         json::array({json{
+             {"id", std::move(id)},
+             {"type", "function"},
+             {"function",
+              {{"name", std::move(name)}, {"arguments", args.dump()}}}}})}};
+}
+
+json
+tool_result(std::string id, std::string content)
+{
+    return json{
+        {"role", "tool"},
+        {"tool_call_id", std::move(id)},
+        {"content", std::move(content)}};
+}
+
+std::string
+content_of(json const & messages, std::size_t i)
+{
+    return messages[i]["content"].get<std::string>();
+}
+
+std::string const big_a(1000, 'a');
+std::string const big_b(1000, 'b');
+
+TEST_SUITE("HistoryDedup")
+{
+    TEST_CASE("Identical results keep only the first copy")
+    {
+        auto messages = json::array({
+            assistant_call("c1", "bash", {{"command", "make"}}),
+            tool_result("c1", big_a),
+            assistant_call("c2", "bash", {{"command", "make"}}),
+            tool_result("c2", big_a)});
+
+        auto const stats = dedupe_tool_results(messages);
+
+        CHECK(stats.replaced == 1);
+        CHECK(content_of(messages, 1) == big_a);
+        CHECK(content_of(messages, 3)
+              == "[Same output as tool call c1, shown earlier.]");
+        CHECK(stats.bytes_saved == 1000 - content_of(messages, 3).size());
+    }
+
+    TEST_CASE("Different command output is kept")
+    {
+        auto messages = json::array({
+            assistant_call("c1", "bash", {{"command", "make"}}),
+            tool_result("c1", big_a),
+            assistant_call("c2", "bash", {{"command", "make"}}),
+            tool_result("c2", big_b)});
+
+        CHECK(dedupe_tool_results(messages).replaced == 0);
+        CHECK(content_of(messages, 1) == big_a);
+    }
+
+    TEST_CASE("An unchanged re-read refers to the earlier read")
+    {
+        auto messages = json::array({
+            assistant_call("r1", "read_file", {{"path", "a.cpp"}}),
+            tool_result("r1", big_a),
+            assistant_call("r2", "read_file", {{"path", "b.cpp"}}),
+            tool_result("r2", big_b),
+            assistant_call("r3", "read_file", {{"path", "a.cpp"}}),
+            tool_result("r3", big_a)});
+
+        CHECK(dedupe_tool_results(messages).replaced == 1);
+        CHECK(content_of(messages, 1) == big_a);
+        CHECK(content_of(messages, 3) == big_b);
+        CHECK(content_of(messages, 5)
+              == "[Same output as tool call r1, shown earlier.]");
+    }
+
+    TEST_CASE("A re-read with new content keeps the earlier read")
+    {
+        auto messages = json::array({
+            assistant_call("r1", "read_file", {{"path", "a.cpp"}}),
+            tool_result("r1", big_a),
+            assistant_call("r2", "read_file", {{"path", "a.cpp"}}),
+            tool_result("r2", big_a + "changed")});
+
+        CHECK(dedupe_tool_results(messages).replaced == 0);
+        CHECK(content_of(messages, 1) == big_a);
+    }
+
+    TEST_CASE("Later messages do not change earlier ones")
+    {
+        auto messages = json::array({
+            assistant_call("c1", "bash", {{"command", "make"}}),
+            tool_result("c1", big_a),
+            assistant_call("c2", "bash", {{"command", "make"}}),
+            tool_result("c2", big_a)});
+        (void)dedupe_tool_results(messages);
+        auto const sent = messages;
+
+        messages.push_back(assistant_call("c3", "bash", {{"command", "ls"}}));
+        messages.push_back(tool_result("c3", big_a));
+        CHECK(dedupe_tool_results(messages).replaced == 1);
+
+        for (std::size_t i = 0; i < sent.size(); ++i) {
+            CHECK(messages[i] == sent[i]);
+        }
+    }
+
+    TEST_CASE("Small results and non-tool messages are untouched")
+    {
+        auto messages = json::array({
+            json{{"role", "user"}, {"content", big_a}},
+            assistant_call("c1", "bash", {{"command", "ls"}}),
+            tool_result("c1", "x"),
+            json{{"role", "user"}, {"content", big_a}},
+            assistant_call("c2", "bash", {{"command", "ls"}}),
+            tool_result("c2", "x")});
+        auto const before = messages;
+
+        CHECK(dedupe_tool_results(messages).replaced == 0);
+        CHECK(messages == before);
+    }
+
+    TEST_CASE("A second pass changes nothing")
+    {
+        auto messages = json::array({
+            assistant_call("c1", "bash", {{"command", "make"}}),
+            tool_result("c1", big_a),
+            assistant_call("c2", "bash", {{"command", "make"}}),
+            tool_result("c2", big_a),
+            assistant_call("c3", "bash", {{"command", "make"}}),
+            tool_result("c3", big_a)});
+
+        CHECK(dedupe_tool_results(messages).replaced == 2);
+        auto const once = messages;
+        CHECK(dedupe_tool_results(messages).replaced == 0);
+        CHECK(messages == once);
+        CHECK(content_of(messages, 1) == big_a);
+        CHECK(content_of(messages, 5)
+              == "[Same output as tool call c1, shown earlier.]");
+    }
+}
+
+} // anonymous namespace
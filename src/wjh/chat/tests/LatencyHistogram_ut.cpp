@@ -0,0 +1,95 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/LatencyHistogram.hpp"
+
+#include <cstdint>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using wjh::chat::LatencyHistogram;
+
+TEST_SUITE("LatencyHistogram")
+{
+    TEST_CASE("An empty histogram reports zeros")
+    {
+        LatencyHistogram h;
+
+        CHECK(h.count() == 0);
+        CHECK(h.min() == 0);
+        CHECK(h.max() == 0);
+        CHECK(h.mean() == 0.0);
+        CHECK(h.percentile(0.99) == 0);
+    }
+
+    TEST_CASE("Small values are exact")
+    {
+        LatencyHistogram h;
+        for (std::uint64_t v = 1; v <= 100; ++v) {
+            h.record(v);
+        }
+
+        CHECK(h.count() == 100);
+        CHECK(h.min() == 1);
+        CHECK(h.max() == 100);
+        CHECK(h.mean() == doctest::Approx(50.5));
+        CHECK(h.percentile(0.5) == 50);
+        CHECK(h.percentile(0.9) == 90);
+        CHECK(h.percentile(0.0) == 1);
+        CHECK(h.percentile(1.0) == 100);
+    }
+
+    TEST_CASE("Large values are within 1/64")
+    {
+        LatencyHistogram h;
+        for (std::uint64_t v = 1000; v <= 1'000'000; v += 1000) {
+            h.record(v);
+        }
+
+        for (auto const q : {0.5, 0.9, 0.99, 0.999}) {
+            auto const exact = static_cast<double>(
+                static_cast<std::uint64_t>(q * 1000.0 + 0.5) * 1000);
+            auto const reported = static_cast<double>(h.percentile(q));
+            CHECK(reported >= exact);
+            CHECK(reported <= exact * (1.0 + 1.0 / 64.0));
+        }
+        CHECK(h.percentile(1.0) == 1'000'000);
+    }
+
+    TEST_CASE("The whole 64-bit range can be recorded")
+    {
+        LatencyHistogram h;
+        h.record(0);
+        h.record(UINT64_MAX);
+
+        CHECK(h.percentile(0.5) == 0);
+        CHECK(h.percentile(1.0) == UINT64_MAX);
+    }
+
+    TEST_CASE("Merged histograms count both")
+    {
+        LatencyHistogram a;
+        LatencyHistogram b;
+        a.record(10);
+        b.record(30);
+        b.record(20);
+
+        a.merge(b);
+
+        CHECK(a.count() == 3);
+        CHECK(a.min() == 10);
+        CHECK(a.max() == 30);
+        CHECK(a.percentile(0.5) == 20);
+
+        a.reset();
+        CHECK(a.count() == 0);
+        CHECK(a.percentile(0.5) == 0);
+    }
+}
+
+} // anonymous namespace
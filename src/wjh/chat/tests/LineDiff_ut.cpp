@@ -0,0 +1,169 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/LineDiff.hpp"
+
+#include <cstdio>
+#include <format>
+#include <string>
+#include <vector>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+
+using Lines = std::vector<std::string>;
+
+Lines
+numbered(int n)
+{
+    Lines lines;
+    for (int i = 1; i <= n; ++i) {
+        lines.push_back(std::format("line {}", i));
+    }
+    return lines;
+}
+
+// Apply a diff produced by unified_diff to before.
+Lines
+patch(Lines const & before, std::string const & diff)
+{
+    Lines after;
+    std::size_t next = 0;
+    std::size_t pos = 0;
+    while (pos < diff.size()) {
+        auto const nl = diff.find('\n', pos);
+        auto const line = diff.substr(pos, nl - pos);
+        pos = nl + 1;
+        if (line.starts_with("@@")) {
+            std::size_t start = 0;
+            std::size_t count = 0;
+            (void)std::sscanf(line.c_str(), "@@ -%zu,%zu", &start, &count);
+            auto const first = count == 0 ? start : start - 1;
+            while (next < first) {
+                after.push_back(before[next++]);
+            }
+        } else if (line[0] == ' ') {
+            after.push_back(before[next++]);
+        } else if (line[0] == '-') {
+            ++next;
+        } else {
+            after.push_back(line.substr(1));
+        }
+    }
+    while (next < before.size()) {
+        after.push_back(before[next++]);
+    }
+    return after;
+}
+
+TEST_SUITE("LineDiff")
+{
+    TEST_CASE("Equal input gives an empty diff")
+    {
+        auto const lines = numbered(10);
+        auto const diff = unified_diff(lines, lines);
+
+        REQUIRE(diff.has_value());
+        CHECK(diff->empty());
+    }
+
+    TEST_CASE("One changed line with context")
+    {
+        auto const before = numbered(10);
+        auto after = before;
+        after[4] = "changed";
+
+        auto const diff = unified_diff(before, after);
+
+        REQUIRE(diff.has_value());
+        CHECK(*diff
+              == "@@ -2,7 +2,7 @@\n"
+                 " line 2\n"
+                 " line 3\n"
+                 " line 4\n"
+                 "-line 5\n"
+                 "+changed\n"
+                 " line 6\n"
+                 " line 7\n"
+                 " line 8\n");
+    }
+
+    TEST_CASE("Distant changes get separate hunks")
+    {
+        auto const before = numbered(40);
+        auto after = before;
+        after.erase(after.begin() + 2);
+        after.insert(after.begin() + 30, "inserted");
+
+        auto const diff = unified_diff(before, after);
+
+        REQUIRE(diff.has_value());
+        CHECK(diff->starts_with("@@ -1,6 +1,5 @@\n"));
+        CHECK(diff->find("@@ -29,6 +28,7 @@\n") != std::string::npos);
+        CHECK(patch(before, *diff) == after);
+    }
+
+    TEST_CASE("Line numbers start at first_line")
+    {
+        auto const before = numbered(3);
+        auto after = before;
+        after.push_back("line 4");
+
+        auto const diff = unified_diff(
+            before,
+            after,
+            DiffOptions{.context = 1, .max_changes = 10, .first_line = 100});
+
+        REQUIRE(diff.has_value());
+        CHECK(*diff == "@@ -102,1 +102,2 @@\n line 3\n+line 4\n");
+    }
+
+    TEST_CASE("Insertion into an empty file")
+    {
+        auto const diff = unified_diff(Lines{}, Lines{"a", "b"});
+
+        REQUIRE(diff.has_value());
+        CHECK(*diff == "@@ -0,0 +1,2 @@\n+a\n+b\n");
+    }
+
+    TEST_CASE("Interleaved edits round-trip")
+    {
+        auto const before = numbered(200);
+        auto after = before;
+        for (std::size_t i = 0; i < after.size(); i += 17) {
+            after[i] += " (edited)";
+        }
+        after.insert(after.begin() + 50, {"x", "y", "z"});
+        after.erase(after.begin() + 120, after.begin() + 125);
+
+        auto const diff = unified_diff(before, after);
+
+        REQUIRE(diff.has_value());
+        CHECK(patch(before, *diff) == after);
+    }
+
+    TEST_CASE("Too many changes gives up")
+    {
+        auto const before = numbered(100);
+        Lines after;
+        for (auto const & line : before) {
+            after.push_back(line + "!");
+        }
+
+        CHECK_FALSE(
+            unified_diff(
+                before,
+                after,
+                DiffOptions{.context = 3, .max_changes = 50, .first_line = 1})
+                .has_value());
+        CHECK(unified_diff(before, after).has_value());
+    }
+}
+
+} // anonymous namespace
@@ -67,6 +67,58 @@ TEST_SUITE("Message")
         CHECK(parsed.role() == original.role());
         CHECK(parsed.text() == original.text());
     }
+
+    TEST_CASE("Tool calls serialize in OpenAI format")
+    {
+        auto msg = Message::tool_calls(
+            {ToolCall{
+                .id = ToolCallId{"call_1"},
+                .name = "read_file",
+                .arguments = R"({"file_path":"a.cpp"})"}},
+            MessageText{""});
+        auto json = to_json(msg);
+
+        CHECK(msg.role() == Role::assistant);
+        CHECK(json["content"].is_null());
+        REQUIRE(json["tool_calls"].size() == 1);
+        CHECK(json["tool_calls"][0]["id"] == "call_1");
+        CHECK(json["tool_calls"][0]["type"] == "function");
+        CHECK(json["tool_calls"][0]["function"]["name"] == "read_file");
+        CHECK(json["tool_calls"][0]["function"]["arguments"]
+              == R"({"file_path":"a.cpp"})");
+        CHECK(parse_message(json) == msg);
+    }
+
+    TEST_CASE("Tool results serialize with their call id")
+    {
+        auto msg =
+            Message::tool_result(ToolCallId{"call_1"}, MessageText{"ok"});
+        auto json = to_json(msg);
+
+        CHECK(msg.is_tool_result());
+        CHECK(json == nlohmann::json{
+                          {"role", "tool"},
+                          {"tool_call_id", "call_1"},
+                          {"content", "ok"}});
+        CHECK(parse_message(json) == msg);
+    }
+
+    TEST_CASE("Parse assistant tool calls without content")
+    {
+        auto const json = nlohmann::json::parse(R"({
+            "role": "assistant",
+            "tool_calls": [{
+                "id": "call_9",
+                "type": "function",
+                "function": {"name": "bash", "arguments": "{}"}}]})");
+        auto msg = parse_message(json);
+
+        CHECK(msg.text() == MessageText{""});
+        REQUIRE(msg.calls().size() == 1);
+        CHECK(msg.calls()[0].id == ToolCallId{"call_9"});
+        CHECK(msg.calls()[0].name == "bash");
+        CHECK_FALSE(msg.tool_call_id().has_value());
+    }
 }
 
 } // anonymous namespace
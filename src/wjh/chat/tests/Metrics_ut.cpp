@@ -0,0 +1,138 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/Metrics.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+
+TEST_SUITE("Metrics")
+{
+    TEST_CASE("Counters and gauges keep their values")
+    {
+        MetricsRegistry registry;
+        auto & requests = registry.counter("requests_total", "Requests");
+        auto & depth = registry.gauge("depth", "Depth");
+
+        requests.add();
+        requests.add(4);
+        depth.set(7);
+        depth.add(-2);
+
+        CHECK(requests.value() == 5);
+        CHECK(depth.value() == 5);
+    }
+
+    TEST_CASE("The same name and labels return the same metric")
+    {
+        MetricsRegistry registry;
+        auto & a = registry.counter("calls_total", "Calls", {{"tool", "a"}});
+        auto & b = registry.counter("calls_total", "Calls", {{"tool", "b"}});
+        auto & again =
+            registry.counter("calls_total", "Calls", {{"tool", "a"}});
+
+        CHECK(&a == &again);
+        CHECK(&a != &b);
+    }
+
+    TEST_CASE("Histogram snapshots keep exact extremes and sum")
+    {
+        MetricsRegistry registry;
+        auto & h = registry.histogram("latency_us", "Latency");
+        for (std::uint64_t v = 1000; v <= 100'000; v += 1000) {
+            h.record(v);
+        }
+
+        auto const s = h.snapshot();
+        CHECK(s.count() == 100);
+        CHECK(s.min() == 1000);
+        CHECK(s.max() == 100'000);
+        CHECK(s.mean() == doctest::Approx(50'500.0));
+        CHECK(s.percentile(0.5) >= 50'000);
+        CHECK(s.percentile(0.5) <= 50'000 + 50'000 / 64);
+        CHECK(s.percentile(1.0) == 100'000);
+    }
+
+    TEST_CASE("Recording from several threads loses nothing")
+    {
+        MetricsRegistry registry;
+        auto & counter = registry.counter("events_total", "Events");
+        auto & h = registry.histogram("size_bytes", "Sizes");
+
+        std::vector<std::thread> threads;
+        for (std::uint64_t t = 0; t < 4; ++t) {
+            threads.emplace_back([&counter, &h, t] {
+                for (std::uint64_t i = 1; i <= 10'000; ++i) {
+                    counter.add();
+                    h.record(t * 10'000 + i);
+                }
+            });
+        }
+        for (auto & thread : threads) {
+            thread.join();
+        }
+
+        auto const s = h.snapshot();
+        CHECK(counter.value() == 40'000);
+        CHECK(s.count() == 40'000);
+        CHECK(s.min() == 1);
+        CHECK(s.max() == 40'000);
+    }
+
+    TEST_CASE("Snapshots are ordered by name and labels")
+    {
+        MetricsRegistry registry;
+        registry.counter("b_total", "B").add(2);
+        registry.counter("a_total", "A", {{"tool", "y"}}).add(3);
+        registry.counter("a_total", "A", {{"tool", "x"}}).add(1);
+
+        auto const s = registry.snapshot();
+        REQUIRE(s.counters.size() == 3);
+        CHECK(series_name(s.counters[0].name, s.counters[0].labels)
+              == "a_total{tool=\"x\"}");
+        CHECK(s.counters[1].value == 3);
+        CHECK(s.counters[2].name == "b_total");
+        CHECK(s.counters[2].help == "B");
+    }
+
+    TEST_CASE("series_name escapes label values")
+    {
+        CHECK(series_name("m", {}) == "m");
+        CHECK(series_name("m", {{"a", "1"}, {"b", "x\"y\\z\n"}})
+              == "m{a=\"1\",b=\"x\\\"y\\\\z\\n\"}");
+    }
+
+    TEST_CASE("to_json reports every kind of metric")
+    {
+        MetricsRegistry registry;
+        registry.counter("calls_total", "Calls", {{"tool", "bash"}}).add(2);
+        registry.gauge("depth", "Depth").set(-3);
+        auto & h = registry.histogram("latency_us", "Latency");
+        h.record(10);
+        h.record(30);
+
+        auto const json = to_json(registry.snapshot());
+        CHECK(json["counters"]["calls_total{tool=\"bash\"}"] == 2);
+        CHECK(json["gauges"]["depth"] == -3);
+        auto const & latency = json["histograms"]["latency_us"];
+        CHECK(latency["count"] == 2);
+        CHECK(latency["sum"] == 40.0);
+        CHECK(latency["min"] == 10);
+        CHECK(latency["max"] == 30);
+        CHECK(latency["mean"] == 20.0);
+        CHECK(latency["p50"] == 10);
+        CHECK(latency["p999"] == 30);
+    }
+}
+
+} // anonymous namespace
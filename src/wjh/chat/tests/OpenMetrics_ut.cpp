@@ -0,0 +1,144 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/OpenMetrics.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+
+bool
+contains(std::string const & text, std::string const & line)
+{
+    return text.find(line) != std::string::npos;
+}
+
+std::string
+read_file(std::filesystem::path const & path)
+{
+    std::ifstream file(path);
+    return std::string(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+}
+
+TEST_SUITE("OpenMetrics")
+{
+    TEST_CASE("An empty registry is just the terminator")
+    {
+        MetricsRegistry registry;
+
+        CHECK(to_openmetrics(registry.snapshot()) == "# EOF\n");
+    }
+
+    TEST_CASE("Counters are grouped into families named without _total")
+    {
+        MetricsRegistry registry;
+        registry.counter("calls_total", "Tool calls", {{"tool", "a"}}).add(2);
+        registry.counter("calls_total", "Tool calls", {{"tool", "b"}}).add();
+        registry.gauge("depth", "Line one\nline two").set(-4);
+
+        auto const text = to_openmetrics(registry.snapshot());
+
+        CHECK(text
+              == "# TYPE calls counter\n"
+                 "# HELP calls Tool calls\n"
+                 "calls_total{tool=\"a\"} 2\n"
+                 "calls_total{tool=\"b\"} 1\n"
+                 "# TYPE depth gauge\n"
+                 "# HELP depth Line one\\nline two\n"
+                 "depth -4\n"
+                 "# EOF\n");
+    }
+
+    TEST_CASE("Histograms have cumulative buckets, count, and sum")
+    {
+        MetricsRegistry registry;
+        auto & h = registry.histogram(
+            "latency_us", "Latency", {{"tool", "bash"}});
+        h.record(3);
+        h.record(40);
+        h.record(999);
+        h.record(7'000'000'000'000);
+
+        auto const text = to_openmetrics(registry.snapshot());
+
+        CHECK(contains(text, "# TYPE latency_us histogram\n"));
+        CHECK(contains(text, "latency_us_bucket{tool=\"bash\",le=\"2\"} 0\n"));
+        CHECK(contains(text, "latency_us_bucket{tool=\"bash\",le=\"5\"} 1\n"));
+        CHECK(contains(text, "latency_us_bucket{tool=\"bash\",le=\"50\"} 2\n"));
+        CHECK(contains(
+            text, "latency_us_bucket{tool=\"bash\",le=\"1000\"} 3\n"));
+        CHECK(contains(
+            text, "latency_us_bucket{tool=\"bash\",le=\"5000000000\"} 3\n"));
+        CHECK(contains(
+            text, "latency_us_bucket{tool=\"bash\",le=\"+Inf\"} 4\n"));
+        CHECK(contains(text, "latency_us_count{tool=\"bash\"} 4\n"));
+        CHECK(contains(text, "latency_us_sum{tool=\"bash\"} 7000000001042\n"));
+        CHECK(text.ends_with("# EOF\n"));
+    }
+
+    TEST_CASE("The exporter writes on start and again when destroyed")
+    {
+        using namespace std::chrono_literals;
+
+        auto const path = std::filesystem::temp_directory_path()
+            / std::format("wjh_chat_metrics_{}.prom", getpid());
+        std::filesystem::remove(path);
+
+        MetricsRegistry registry;
+        auto & turns = registry.counter("turns_total", "Turns");
+        {
+            MetricsFileExporter exporter(registry, path, 1h);
+            turns.add(3);
+        }
+        auto const text = read_file(path);
+        std::filesystem::remove(path);
+
+        CHECK(contains(text, "turns_total 3\n"));
+        CHECK(text.ends_with("# EOF\n"));
+        CHECK_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+    }
+
+    TEST_CASE("The exporter rewrites the file every interval")
+    {
+        using namespace std::chrono_literals;
+
+        auto const path = std::filesystem::temp_directory_path()
+            / std::format("wjh_chat_metrics_tick_{}.prom", getpid());
+        std::filesystem::remove(path);
+
+        MetricsRegistry registry;
+        auto & turns = registry.counter("turns_total", "Turns");
+        MetricsFileExporter exporter(registry, path, 10ms);
+        turns.add(5);
+
+        auto text = std::string{};
+        for (int i = 0; i < 500 and not contains(text, "turns_total 5\n");
+             ++i)
+        {
+            std::this_thread::sleep_for(10ms);
+            text = read_file(path);
+        }
+        std::filesystem::remove(path);
+
+        CHECK(contains(text, "turns_total 5\n"));
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,113 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/OutputCompactor.hpp"
+
+#include <format>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+
+std::string
+compacted(std::string text, CompactOptions const & options = {})
+{
+    (void)compact_output(text, options);
+    return text;
+}
+
+TEST_SUITE("OutputCompactor")
+{
+    TEST_CASE("ANSI escape sequences are removed")
+    {
+        CHECK(compacted("\x1B[1;31merror:\x1B[0m bad\n") == "error: bad\n");
+        CHECK(compacted("\x1B]0;title\x07ok\x1B(B\n") == "ok\n");
+        CHECK(compacted("\x1B]8;;http://x\x1B\\link\x1B]8;;\x1B\\\n")
+              == "link\n");
+    }
+
+    TEST_CASE("Carriage returns keep what the terminal shows")
+    {
+        CHECK(compacted("[  0%]\r[ 50%]\r[100%] done\n")
+              == "[100%] done\n");
+        CHECK(compacted("abcdef\rXY\n") == "XYcdef\n");
+        CHECK(compacted("ab\bc\r\n") == "ac\n");
+    }
+
+    TEST_CASE("Runs of identical lines are folded with a count")
+    {
+        std::string text;
+        for (int i = 0; i < 10; ++i) {
+            text += "warning: deprecated option ignored\n";
+        }
+        text += "done\n";
+
+        auto const saved = compact_output(text, CompactOptions{});
+
+        CHECK(text
+              == "warning: deprecated option ignored\n"
+                 "[previous line repeated 9 more times]\n"
+                 "done\n");
+        CHECK(saved > 0);
+    }
+
+    TEST_CASE("Runs differing only in numbers keep first and last if asked")
+    {
+        std::string text = "start\n";
+        for (int i = 1; i <= 20; ++i) {
+            text += std::format(
+                "Downloading chunk {} of 20 ({} KB)\n",
+                i,
+                i * 64);
+        }
+
+        CHECK(compacted(text) == text);
+
+        auto const similar = parse_compact_options("similar");
+        REQUIRE(similar.has_value());
+        CHECK(compacted(text, *similar)
+              == "start\n"
+                 "Downloading chunk 1 of 20 (64 KB)\n"
+                 "[... 18 similar lines ...]\n"
+                 "Downloading chunk 20 of 20 (1280 KB)\n");
+    }
+
+    TEST_CASE("Short runs and blank lines are left alone")
+    {
+        auto const text = std::string("a\na\nx1\nx2\n\n\n\nend");
+
+        auto all = CompactOptions{};
+        all.fold_similar = true;
+        CHECK(compacted(text) == text);
+        CHECK(compacted(text, all) == text);
+    }
+
+    TEST_CASE("Stages can be selected")
+    {
+        auto const off = parse_compact_options("off");
+        REQUIRE(off.has_value());
+        auto const text = std::string("\x1B[0mx\nx\nx\nx\nx\n");
+        CHECK(compacted(text, *off) == text);
+
+        auto const ansi = parse_compact_options("ansi,cr");
+        REQUIRE(ansi.has_value());
+        CHECK(ansi->strip_ansi);
+        CHECK(ansi->resolve_cr);
+        CHECK_FALSE(ansi->fold_repeats);
+        CHECK(compacted(text, *ansi) == "x\nx\nx\nx\nx\n");
+
+        auto const on = parse_compact_options("on");
+        REQUIRE(on.has_value());
+        CHECK(on->fold_repeats);
+        CHECK_FALSE(on->fold_similar);
+
+        CHECK_FALSE(parse_compact_options("ansi,colors").has_value());
+    }
+}
+
+} // anonymous namespace
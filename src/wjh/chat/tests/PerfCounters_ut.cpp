@@ -0,0 +1,164 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/PerfCounters.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+
+std::uint64_t volatile sink = 0;
+
+void
+spin()
+{
+    for (std::uint64_t i = 0; i < 2'000'000; ++i) {
+        sink = sink + i;
+    }
+}
+
+PerfPhase const *
+find_phase(std::vector<PerfPhase> const & phases, std::string_view name)
+{
+    auto const found = std::ranges::find(phases, name, &PerfPhase::name);
+    return found == phases.end() ? nullptr : &*found;
+}
+
+// Counters may be unavailable (seccomp, perf_event_paranoid=3).
+bool
+start_counting()
+{
+    auto const events = PerfCounters::start();
+    if (not events) {
+        MESSAGE("perf counters unavailable: " << events.error());
+        return false;
+    }
+    CHECK(std::ranges::find(*events, PerfEvent::task_clock)
+          != events->end());
+    CHECK(PerfCounters::counted(PerfEvent::task_clock));
+    return true;
+}
+
+TEST_SUITE("PerfCounters")
+{
+    TEST_CASE("Counts add and subtract per event")
+    {
+        auto a = PerfCounts{};
+        a[PerfEvent::cycles] = 100;
+        a[PerfEvent::instructions] = 50;
+        auto b = PerfCounts{};
+        b[PerfEvent::cycles] = 30;
+        b[PerfEvent::instructions] = 80;
+
+        auto const delta = a.since(b);
+        CHECK(delta[PerfEvent::cycles] == 70);
+        CHECK(delta[PerfEvent::instructions] == 0);
+
+        a += b;
+        CHECK(a[PerfEvent::cycles] == 130);
+        CHECK(a[PerfEvent::instructions] == 130);
+        CHECK(a[PerfEvent::branch_misses] == 0);
+    }
+
+    TEST_CASE("Events have names")
+    {
+        CHECK(to_string(PerfEvent::task_clock) == "task_clock");
+        CHECK(to_string(PerfEvent::cache_misses) == "cache_misses");
+    }
+
+    TEST_CASE("Nothing is recorded while counters are off")
+    {
+        PerfCounters::stop();
+        PerfCounters::reset();
+        {
+            auto const scope = PerfScope("off");
+            spin();
+        }
+        CHECK(PerfCounters::snapshot().empty());
+    }
+
+    TEST_CASE("Scopes add up per phase and detail")
+    {
+        if (not start_counting()) {
+            return;
+        }
+        for (int i = 0; i < 3; ++i) {
+            auto const scope = PerfScope("build");
+            spin();
+        }
+        {
+            auto scope = PerfScope("tool", "read_file");
+            spin();
+            scope.stop();
+            scope.stop();
+        }
+        PerfCounters::stop();
+        {
+            auto const scope = PerfScope("build");
+        }
+        auto const phases = PerfCounters::snapshot();
+
+        REQUIRE(phases.size() == 2);
+        auto const * build = find_phase(phases, "build");
+        REQUIRE(build != nullptr);
+        CHECK(build->calls == 3);
+        CHECK(build->counts[PerfEvent::task_clock] > 0);
+        auto const * tool = find_phase(phases, "tool/read_file");
+        REQUIRE(tool != nullptr);
+        CHECK(tool->calls == 1);
+        if (PerfCounters::counted(PerfEvent::instructions)) {
+            CHECK(build->counts[PerfEvent::instructions] > 0);
+        }
+    }
+
+    TEST_CASE("Phases from other threads are merged")
+    {
+        if (not start_counting()) {
+            return;
+        }
+        auto threads = std::vector<std::jthread>{};
+        for (int i = 0; i < 2; ++i) {
+            threads.emplace_back([] {
+                auto const scope = PerfScope("parse");
+                spin();
+            });
+        }
+        threads.clear();
+        {
+            auto const scope = PerfScope("parse");
+            spin();
+        }
+        auto const phases = PerfCounters::snapshot();
+        PerfCounters::stop();
+
+        auto const * parse = find_phase(phases, "parse");
+        REQUIRE(parse != nullptr);
+        CHECK(parse->calls == 3);
+    }
+
+    TEST_CASE("Starting again drops the totals")
+    {
+        if (not start_counting()) {
+            return;
+        }
+        {
+            auto const scope = PerfScope("http");
+        }
+        REQUIRE(start_counting());
+        CHECK(PerfCounters::snapshot().empty());
+        PerfCounters::stop();
+    }
+}
+
+} // anonymous namespace
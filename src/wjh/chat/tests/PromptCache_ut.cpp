@@ -0,0 +1,200 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/PromptCache.hpp"
+
+#include <vector>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+using namespace wjh::chat::client;
+using nlohmann::json;
+
+json
+text_message(char const * role, char const * text)
+{
+    return {{"role", role}, {"content", text}};
+}
+
+json
+call_message()
+{
+    return {
+        {"role", "assistant"},
+        {"content", nullptr},
+        {"tool_calls", json::array({{{"id", "c1"}}})}};
+}
+
+bool
+is_marked(json const & message)
+{
+    auto const & content = message["content"];
+    return content.is_array()
+        and content.back().contains("cache_control");
+}
+
+TEST_SUITE("PromptCache")
+{
+    TEST_CASE("parse_prompt_cache_mode")
+    {
+        CHECK(parse_prompt_cache_mode("off") == PromptCacheMode::off);
+        CHECK(parse_prompt_cache_mode("auto") == PromptCacheMode::automatic);
+        CHECK(parse_prompt_cache_mode("on") == PromptCacheMode::on);
+        CHECK_FALSE(parse_prompt_cache_mode("yes").has_value());
+    }
+
+    TEST_CASE("auto marks only models that need breakpoints")
+    {
+        auto const automatic = PromptCacheMode::automatic;
+        CHECK(wants_cache_breakpoints(
+            automatic, ModelId{"anthropic/claude-sonnet-4"}));
+        CHECK(wants_cache_breakpoints(
+            automatic, ModelId{"google/gemini-2.5-pro"}));
+        CHECK_FALSE(wants_cache_breakpoints(
+            automatic, ModelId{"openai/gpt-4o"}));
+        CHECK(wants_cache_breakpoints(
+            PromptCacheMode::on, ModelId{"openai/gpt-4o"}));
+        CHECK_FALSE(wants_cache_breakpoints(
+            PromptCacheMode::off, ModelId{"anthropic/claude-sonnet-4"}));
+    }
+
+    TEST_CASE("first turn marks the system prompt and the new message")
+    {
+        auto messages = json::array({
+            text_message("system", "You are helpful."),
+            text_message("user", "Hello")});
+
+        CHECK(add_cache_breakpoints(messages) == 2u);
+        CHECK(is_marked(messages[0]));
+        CHECK(is_marked(messages[1]));
+        CHECK(messages[0]["content"][0]["type"] == "text");
+        CHECK(messages[0]["content"][0]["text"] == "You are helpful.");
+        CHECK(messages[0]["content"][0]["cache_control"]["type"]
+              == "ephemeral");
+    }
+
+    TEST_CASE("later turns also mark the end of the earlier history")
+    {
+        auto messages = json::array({
+            text_message("system", "sys"),
+            text_message("user", "one"),
+            text_message("assistant", "reply one"),
+            text_message("user", "two"),
+            call_message(),
+            text_message("tool", "output")});
+
+        CHECK(add_cache_breakpoints(messages) == 3u);
+        CHECK(is_marked(messages[0]));
+        CHECK_FALSE(is_marked(messages[1]));
+        CHECK(is_marked(messages[2]));
+        CHECK_FALSE(is_marked(messages[3]));
+        CHECK(messages[4]["content"].is_null());
+        CHECK(is_marked(messages[5]));
+    }
+
+    TEST_CASE("messages without text are skipped")
+    {
+        auto messages = json::array({
+            text_message("user", "one"),
+            call_message(),
+            text_message("user", "two"),
+            call_message()});
+
+        CHECK(add_cache_breakpoints(messages) == 2u);
+        CHECK(is_marked(messages[0]));
+        CHECK(is_marked(messages[2]));
+        CHECK(messages[1]["content"].is_null());
+        CHECK(messages[3]["content"].is_null());
+    }
+
+    TEST_CASE("an empty history gets no breakpoints")
+    {
+        auto messages = json::array();
+        CHECK(add_cache_breakpoints(messages) == 0u);
+    }
+
+    TEST_CASE("cache_breakpoints lists the messages that get marked")
+    {
+        auto const messages = json::array({
+            text_message("system", "sys"),
+            text_message("user", "one"),
+            text_message("assistant", "reply one"),
+            text_message("user", "two"),
+            call_message()});
+
+        CHECK(cache_breakpoints(messages)
+              == std::vector<std::size_t>{0, 2, 3});
+        CHECK(cache_breakpoints(json::array({text_message("user", "hi")}))
+              == std::vector<std::size_t>{0});
+        CHECK(cache_breakpoints(json::array()).empty());
+    }
+
+    TEST_CASE("parse_usage reads OpenAI-style cache details")
+    {
+        auto const usage = parse_usage(json::parse(R"({
+            "prompt_tokens": 1200,
+            "completion_tokens": 30,
+            "total_tokens": 1230,
+            "prompt_tokens_details": {
+                "cached_tokens": 1000,
+                "cache_write_tokens": 150
+            }
+        })"));
+        CHECK(usage.prompt_tokens == PromptTokens{1200u});
+        CHECK(usage.completion_tokens == CompletionTokens{30u});
+        CHECK(usage.total_tokens == TotalTokens{1230u});
+        CHECK(usage.cached_tokens == CachedTokens{1000u});
+        CHECK(usage.cache_write_tokens == CacheWriteTokens{150u});
+    }
+
+    TEST_CASE("parse_usage reads Anthropic-style cache counts")
+    {
+        auto const usage = parse_usage(json::parse(R"({
+            "prompt_tokens": 500,
+            "completion_tokens": 5,
+            "total_tokens": 505,
+            "cache_read_input_tokens": 300,
+            "cache_creation_input_tokens": 200
+        })"));
+        CHECK(usage.cached_tokens == CachedTokens{300u});
+        CHECK(usage.cache_write_tokens == CacheWriteTokens{200u});
+    }
+
+    TEST_CASE("parse_usage tolerates missing and null fields")
+    {
+        auto const usage = parse_usage(json::parse(R"({
+            "prompt_tokens": 10,
+            "completion_tokens": null,
+            "prompt_tokens_details": null
+        })"));
+        CHECK(usage.prompt_tokens == PromptTokens{10u});
+        CHECK(usage.completion_tokens == CompletionTokens{0u});
+        CHECK(usage.cached_tokens == CachedTokens{0u});
+    }
+
+    TEST_CASE("TokenUsage sums every field")
+    {
+        auto total = parse_usage(json::parse(R"({
+            "prompt_tokens": 100, "completion_tokens": 10,
+            "total_tokens": 110,
+            "prompt_tokens_details": {"cached_tokens": 80}})"));
+        total += parse_usage(json::parse(R"({
+            "prompt_tokens": 150, "completion_tokens": 20,
+            "total_tokens": 170,
+            "prompt_tokens_details": {"cached_tokens": 100,
+                                      "cache_write_tokens": 50}})"));
+        CHECK(total.prompt_tokens == PromptTokens{250u});
+        CHECK(total.completion_tokens == CompletionTokens{30u});
+        CHECK(total.total_tokens == TotalTokens{280u});
+        CHECK(total.cached_tokens == CachedTokens{180u});
+        CHECK(total.cache_write_tokens == CacheWriteTokens{50u});
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,116 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/ReadTracker.hpp"
+
+#include <format>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+
+FileRead
+read_of(std::vector<std::string> lines)
+{
+    auto read = FileRead{};
+    read.key = "/src/a.cpp:1:max";
+    read.display_path = "a.cpp";
+    read.first_line = 1;
+    for (auto const & line : lines) {
+        read.full_size += line.size() + 8;
+    }
+    read.lines = std::move(lines);
+    return read;
+}
+
+std::vector<std::string>
+numbered(int n)
+{
+    std::vector<std::string> lines;
+    for (int i = 1; i <= n; ++i) {
+        lines.push_back(std::format("int value_{} = {};", i, i));
+    }
+    return lines;
+}
+
+TEST_SUITE("ReadTracker")
+{
+    TEST_CASE("First read is sent in full")
+    {
+        ReadTracker reads;
+
+        CHECK_FALSE(reads.reread(read_of(numbered(100))).has_value());
+    }
+
+    TEST_CASE("Unchanged re-read")
+    {
+        ReadTracker reads;
+        (void)reads.reread(read_of(numbered(100)));
+
+        auto const reply = reads.reread(read_of(numbered(100)));
+
+        REQUIRE(reply.has_value());
+        CHECK(*reply
+              == "[Re-read of a.cpp: unchanged since it was last shown "
+                 "in full.]");
+        CHECK(is_reread_reply(*reply));
+    }
+
+    TEST_CASE("Small change gives a diff against the full copy")
+    {
+        ReadTracker reads;
+        (void)reads.reread(read_of(numbered(100)));
+
+        auto lines = numbered(100);
+        lines[49] = "int value_50 = 0;";
+        auto const first = reads.reread(read_of(lines));
+        REQUIRE(first.has_value());
+        CHECK(first->find("-int value_50 = 50;\n+int value_50 = 0;\n")
+              != std::string::npos);
+
+        // A second edit is still diffed against the full copy.
+        lines[9] = "int value_10 = 0;";
+        auto const second = reads.reread(read_of(lines));
+        REQUIRE(second.has_value());
+        CHECK(second->find("+int value_50 = 0;") != std::string::npos);
+        CHECK(second->find("+int value_10 = 0;") != std::string::npos);
+    }
+
+    TEST_CASE("Large change is sent in full and becomes the base")
+    {
+        ReadTracker reads;
+        (void)reads.reread(read_of(numbered(10)));
+
+        auto const rewritten = numbered(3);
+        CHECK_FALSE(reads.reread(read_of(rewritten)).has_value());
+
+        auto const reply = reads.reread(read_of(rewritten));
+        REQUIRE(reply.has_value());
+        CHECK(reply->find("unchanged") != std::string::npos);
+    }
+
+    TEST_CASE("Results too large to send in full are not tracked")
+    {
+        ReadTracker reads(64);
+        (void)reads.reread(read_of(numbered(100)));
+
+        CHECK_FALSE(reads.reread(read_of(numbered(100))).has_value());
+    }
+
+    TEST_CASE("Different ranges are tracked separately")
+    {
+        ReadTracker reads;
+        (void)reads.reread(read_of(numbered(100)));
+
+        auto other = read_of(numbered(100));
+        other.key = "/src/a.cpp:50:10";
+        CHECK_FALSE(reads.reread(other).has_value());
+    }
+}
+
+} // anonymous namespace
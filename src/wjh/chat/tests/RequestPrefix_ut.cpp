@@ -0,0 +1,130 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/RequestPrefix.hpp"
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+using namespace wjh::chat::client;
+using nlohmann::json;
+
+json
+settings()
+{
+    return {{"model", "test/model"}, {"max_tokens", 100}};
+}
+
+json
+tools()
+{
+    return json::array(
+        {{{"type", "function"}, {"function", {{"name", "bash"}}}}});
+}
+
+json
+text_message(char const * role, char const * text)
+{
+    return {{"role", role}, {"content", text}};
+}
+
+TEST_SUITE("RequestPrefix")
+{
+    TEST_CASE("The body is the request as JSON")
+    {
+        RequestPrefix prefix(settings(), tools());
+        auto const messages =
+            json::array({text_message("user", "hello")});
+
+        auto const body =
+            prefix.build(SystemPrompt{"Be brief."}, false, messages);
+
+        auto expected = settings();
+        expected["tools"] = tools();
+        expected["messages"] = json::array(
+            {text_message("system", "Be brief."), messages[0]});
+        CHECK(json::parse(body) == expected);
+    }
+
+    TEST_CASE("Settings and tools lead, messages come last")
+    {
+        RequestPrefix prefix(settings(), tools());
+
+        auto const body = prefix.build(
+            std::nullopt, false, json::array({text_message("user", "hi")}));
+
+        CHECK(body.starts_with(
+            R"({"max_tokens":100,"model":"test/model","tools":[)"));
+        CHECK(body.ends_with(
+            R"("messages":[{"content":"hi","role":"user"}]})"));
+    }
+
+    TEST_CASE("Empty settings and no messages")
+    {
+        RequestPrefix prefix(json::object(), json::array());
+
+        CHECK(prefix.build(std::nullopt, false, json::array())
+              == R"({"tools":[],"messages":[]})");
+    }
+
+    TEST_CASE("A growing conversation only appends bytes")
+    {
+        RequestPrefix prefix(settings(), tools());
+        auto const system = std::optional{SystemPrompt{"Be brief."}};
+        auto messages = json::array({text_message("user", "one")});
+
+        auto const first = prefix.build(system, false, messages);
+        messages.push_back(text_message("assistant", "two"));
+        messages.push_back(text_message("user", "three"));
+        auto const second = prefix.build(system, false, messages);
+
+        CHECK(common_prefix(first, second) == first.size() - 2);
+    }
+
+    TEST_CASE("The system message follows the prompt and the mark")
+    {
+        RequestPrefix prefix(settings(), tools());
+        auto const messages = json::array({text_message("user", "hi")});
+
+        auto const plain =
+            json::parse(prefix.build(SystemPrompt{"A"}, false, messages));
+        auto const marked =
+            json::parse(prefix.build(SystemPrompt{"A"}, true, messages));
+        auto const changed =
+            json::parse(prefix.build(SystemPrompt{"B"}, true, messages));
+        auto const none =
+            json::parse(prefix.build(std::nullopt, true, messages));
+
+        CHECK(plain["messages"][0] == text_message("system", "A"));
+        CHECK(marked["messages"][0]["content"][0]["text"] == "A");
+        CHECK(marked["messages"][0]["content"][0].contains("cache_control"));
+        CHECK(changed["messages"][0]["content"][0]["text"] == "B");
+        CHECK(none["messages"].size() == 1);
+        CHECK(none["messages"][0] == messages[0]);
+    }
+
+    TEST_CASE("common_prefix counts leading equal bytes")
+    {
+        CHECK(common_prefix("", "abc") == 0);
+        CHECK(common_prefix("abc", "abd") == 2);
+        CHECK(common_prefix("abc", "abc") == 3);
+        CHECK(common_prefix("abcdef", "abc") == 3);
+        CHECK(common_prefix("abc", "abcdef") == 3);
+    }
+
+    TEST_CASE("PrefixMonitor compares with the previous body")
+    {
+        PrefixMonitor monitor;
+
+        CHECK(monitor.observe("abcdef") == 0);
+        CHECK(monitor.observe("abcxyz") == 3);
+        CHECK(monitor.observe("abcxyz!") == 6);
+    }
+}
+
+} // anonymous namespace
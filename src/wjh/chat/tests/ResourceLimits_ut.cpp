@@ -0,0 +1,211 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/ProcessRunner.hpp"
+#include "wjh/chat/tools/ResourceLimits.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+
+#include <chrono>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+using namespace std::chrono_literals;
+
+TEST_SUITE("ResourceLimits")
+{
+    TEST_CASE("Defaults cover bash and build")
+    {
+        auto const limits = default_tool_limits();
+
+        CHECK(limits_for(limits, "bash").wall_time == 10min);
+        CHECK(limits_for(limits, "bash").max_output_bytes
+              == 16 * 1024 * 1024);
+        CHECK(limits_for(limits, "build").wall_time == 1h);
+        CHECK_FALSE(limits_for(limits, "read_file").wall_time.has_value());
+    }
+
+    TEST_CASE("Overrides apply on top of the base limits")
+    {
+        auto const result = parse_tool_limits(
+            "bash: wall=2m cpu=1500ms mem=2G files=64 output=none; "
+            "build: wall=none",
+            default_tool_limits());
+
+        REQUIRE(result.has_value());
+        auto const bash = limits_for(*result, "bash");
+        CHECK(bash.wall_time == 2min);
+        CHECK(bash.cpu_time == 2s);
+        CHECK(bash.address_space == std::size_t{2} << 30);
+        CHECK(bash.open_files == 64u);
+        CHECK(bash.max_output_bytes == std::numeric_limits<std::size_t>::max());
+        auto const build = limits_for(*result, "build");
+        CHECK_FALSE(build.wall_time.has_value());
+        CHECK(build.max_output_bytes == 64u * 1024 * 1024);
+    }
+
+    TEST_CASE("Malformed overrides are rejected")
+    {
+        CHECK_FALSE(parse_tool_limits("wall=2m", {}).has_value());
+        CHECK_FALSE(parse_tool_limits("bash: wall=2y", {}).has_value());
+        CHECK_FALSE(parse_tool_limits("bash: speed=9", {}).has_value());
+        CHECK_FALSE(parse_tool_limits("bash: wall", {}).has_value());
+        CHECK_FALSE(
+            parse_tool_limits("bash: mem=99999999999G", {}).has_value());
+        CHECK_FALSE(
+            parse_tool_limits("bash: output=99999999999999999999", {})
+                .has_value());
+    }
+
+    TEST_CASE("describe_limit names the limit and its value")
+    {
+        auto const limits = ResourceLimits{
+            .cpu_time = 30s,
+            .address_space = std::size_t{512} << 20,
+            .open_files = 64,
+            .wall_time = 90s,
+            .max_output_bytes = 100 * 1024};
+
+        CHECK(describe_limit(LimitHit::none, limits).empty());
+        CHECK(describe_limit(LimitHit::wall_time, limits)
+              == "[limit: wall time of 90s exceeded; process group killed]");
+        CHECK(describe_limit(LimitHit::output, limits)
+              == "[limit: output truncated at 100KB; process group killed]");
+        CHECK(describe_limit(LimitHit::address_space, limits)
+              == "[limit: memory limit of 512MB reached]");
+    }
+
+    TEST_CASE("describe_possible_limit does not claim the limit fired")
+    {
+        auto const limits = ResourceLimits{
+            .cpu_time = std::nullopt,
+            .address_space = std::size_t{512} << 20,
+            .open_files = 64,
+            .wall_time = std::nullopt,
+            .max_output_bytes = 100 * 1024};
+
+        CHECK(describe_possible_limit(LimitHit::none, limits).empty());
+        CHECK(describe_possible_limit(LimitHit::address_space, limits)
+              == "[limit: the memory limit of 512MB may have been reached]");
+        CHECK(describe_possible_limit(LimitHit::open_files, limits)
+              == "[limit: the open file limit of 64 may have been reached]");
+    }
+}
+
+TEST_SUITE("run_process")
+{
+    TEST_CASE("Captures output and exit status")
+    {
+        auto const result = run_process(ShellCommand{"echo hi; exit 3"});
+
+        REQUIRE(result.has_value());
+        CHECK(result->output == "hi\n");
+        CHECK(result->exit_status == ExitStatus{3});
+        CHECK(result->limit_hit == LimitHit::none);
+    }
+
+    TEST_CASE("Wall time kills the process group")
+    {
+        auto limits = ResourceLimits{};
+        limits.wall_time = 200ms;
+        auto const start = std::chrono::steady_clock::now();
+        auto const result =
+            run_process(ShellCommand{"sleep 30 & sleep 30"}, limits);
+
+        REQUIRE(result.has_value());
+        CHECK(result->limit_hit == LimitHit::wall_time);
+        CHECK(std::chrono::steady_clock::now() - start < 5s);
+    }
+
+    TEST_CASE("Wall time applies after the shell closes its output")
+    {
+        auto limits = ResourceLimits{};
+        limits.wall_time = 200ms;
+        auto const start = std::chrono::steady_clock::now();
+        auto const result = run_process(
+            ShellCommand{"exec >/dev/null 2>&1; sleep 30"},
+            limits);
+
+        REQUIRE(result.has_value());
+        CHECK(result->limit_hit == LimitHit::wall_time);
+        CHECK(std::chrono::steady_clock::now() - start < 5s);
+    }
+
+    TEST_CASE("A child that leaves the group does not hold up the result")
+    {
+        // Without a wall limit, the pipe it keeps open is not waited for.
+        auto const start = std::chrono::steady_clock::now();
+        auto const result = run_process(
+            ShellCommand{"setsid sleep 3 & echo done"},
+            ResourceLimits{});
+
+        REQUIRE(result.has_value());
+        CHECK(result->output == "done\n");
+        CHECK(std::chrono::steady_clock::now() - start < 2s);
+    }
+
+    TEST_CASE("Output cap truncates and stops the command")
+    {
+        auto limits = ResourceLimits{};
+        limits.max_output_bytes = 1000;
+        auto const result = run_process(ShellCommand{"yes"}, limits);
+
+        REQUIRE(result.has_value());
+        CHECK(result->output.size() == 1000);
+        CHECK(result->limit_hit == LimitHit::output);
+    }
+
+    TEST_CASE("Background children do not outlive the command")
+    {
+        auto const start = std::chrono::steady_clock::now();
+        auto const result = run_process(ShellCommand{"sleep 30 & echo done"});
+
+        REQUIRE(result.has_value());
+        CHECK(result->output == "done\n");
+        CHECK(std::chrono::steady_clock::now() - start < 5s);
+    }
+
+    TEST_CASE("Memory errors in the output are only a possible cause")
+    {
+        auto limits = ResourceLimits{};
+        limits.address_space = std::size_t{4} << 30;
+        auto const result = run_process(
+            ShellCommand{"echo \"error: no member named 'bad_alloc'\"; exit 1"},
+            limits);
+
+        REQUIRE(result.has_value());
+        CHECK(result->limit_hit == LimitHit::none);
+        CHECK(result->possible_limit == LimitHit::address_space);
+
+        auto const ok = run_process(ShellCommand{"echo bad_alloc"}, limits);
+        REQUIRE(ok.has_value());
+        CHECK(ok->possible_limit == LimitHit::none);
+    }
+
+    TEST_CASE("CPU limit is reported")
+    {
+        auto limits = ResourceLimits{};
+        limits.cpu_time = 1s;
+        auto const result =
+            run_process(ShellCommand{"while :; do :; done"}, limits);
+
+        REQUIRE(result.has_value());
+        CHECK(result->limit_hit == LimitHit::cpu_time);
+    }
+
+    TEST_CASE("stdin is not inherited")
+    {
+        auto const result = run_process(ShellCommand{"cat; echo end"});
+
+        REQUIRE(result.has_value());
+        CHECK(result->output == "end\n");
+    }
+}
+
+} // anonymous namespace
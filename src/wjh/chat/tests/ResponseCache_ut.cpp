@@ -0,0 +1,190 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/ResponseCache.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+using namespace wjh::chat::client;
+using nlohmann::json;
+
+// Fresh cache directory, removed on destruction.
+struct TempDir
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path()
+        / std::format("wjh_chat_response_test_{}", getpid());
+
+    TempDir() { std::filesystem::remove_all(path); }
+    ~TempDir() { std::filesystem::remove_all(path); }
+
+    TempDir(TempDir const &) = delete;
+    TempDir & operator = (TempDir const &) = delete;
+};
+
+json
+reply(int n)
+{
+    return {{"choices", json::array({{{"message", {{"content", n}}}}})}};
+}
+
+void
+set_age(std::filesystem::path const & path, std::chrono::hours age)
+{
+    std::filesystem::last_write_time(
+        path, std::filesystem::file_time_type::clock::now() - age);
+}
+
+TEST_SUITE("ResponseCache")
+{
+    TEST_CASE("Only an explicit temperature of zero is deterministic")
+    {
+        CHECK(is_deterministic(Temperature{0.0f}));
+        CHECK_FALSE(is_deterministic(Temperature{0.7f}));
+        CHECK_FALSE(is_deterministic(std::nullopt));
+    }
+
+    TEST_CASE("Keys depend on every byte of the body")
+    {
+        auto const a = response_key(R"({"messages":["a"]})");
+        auto const b = response_key(R"({"messages":["b"]})");
+
+        CHECK(a.digest.size() == 16);
+        CHECK(a.digest != b.digest);
+        CHECK(a.check != b.check);
+        CHECK(a.size == b.size);
+        CHECK(response_key(R"({"messages":["a"]})").digest == a.digest);
+    }
+
+    TEST_CASE("A stored response is found again")
+    {
+        TempDir dir;
+        ResponseCache cache(dir.path, 1u << 20);
+        auto const key = response_key("body");
+
+        CHECK_FALSE(cache.lookup(key).has_value());
+        CHECK(cache.store(key, reply(1)));
+
+        auto const hit = cache.lookup(key);
+        REQUIRE(hit.has_value());
+        CHECK(*hit == reply(1));
+        CHECK_FALSE(cache.lookup(response_key("other")).has_value());
+    }
+
+    TEST_CASE("Entries survive the cache object")
+    {
+        TempDir dir;
+        auto const key = response_key("body");
+        {
+            ResponseCache cache(dir.path, 1u << 20);
+            CHECK(cache.store(key, reply(1)));
+        }
+
+        ResponseCache cache(dir.path, 1u << 20);
+        CHECK(cache.lookup(key) == reply(1));
+    }
+
+    TEST_CASE("A digest collision is a miss")
+    {
+        TempDir dir;
+        ResponseCache cache(dir.path, 1u << 20);
+        auto const key = response_key("body");
+        CHECK(cache.store(key, reply(1)));
+
+        auto other = key;
+        other.check ^= 1u;
+        CHECK_FALSE(cache.lookup(other).has_value());
+        other = key;
+        other.size += 1;
+        CHECK_FALSE(cache.lookup(other).has_value());
+    }
+
+    TEST_CASE("A damaged entry is a miss")
+    {
+        TempDir dir;
+        ResponseCache cache(dir.path, 1u << 20);
+        auto const key = response_key("body");
+        CHECK(cache.store(key, reply(1)));
+
+        std::ofstream(dir.path / (key.digest + ".cbor")) << "garbage";
+
+        CHECK_FALSE(cache.lookup(key).has_value());
+    }
+
+    TEST_CASE("The least recently used entries are evicted")
+    {
+        TempDir dir;
+        auto const a = response_key("a");
+        auto const b = response_key("b");
+        auto const c = response_key("c");
+        auto const path = [&dir](ResponseKey const & key) {
+            return dir.path / (key.digest + ".cbor");
+        };
+
+        ResponseCache unbounded(dir.path, 1u << 20);
+        CHECK(unbounded.store(a, reply(1)));
+        auto const entry = std::filesystem::file_size(path(a));
+
+        // Room for two entries, not three.
+        ResponseCache cache(dir.path, entry * 2 + 8);
+        CHECK(cache.store(b, reply(2)));
+        set_age(path(a), std::chrono::hours{2});
+        set_age(path(b), std::chrono::hours{1});
+
+        // Reading a makes b the oldest.
+        CHECK(cache.lookup(a).has_value());
+        CHECK(cache.store(c, reply(3)));
+
+        CHECK(cache.lookup(a).has_value());
+        CHECK_FALSE(cache.lookup(b).has_value());
+        CHECK(cache.lookup(c).has_value());
+    }
+
+    TEST_CASE("Stores leave no temporary files")
+    {
+        TempDir dir;
+        ResponseCache cache(dir.path, 1u << 20);
+        CHECK(cache.store(response_key("a"), reply(1)));
+        CHECK(cache.store(response_key("a"), reply(2)));
+        CHECK(cache.store(response_key("b"), reply(3)));
+
+        auto files = 0;
+        auto const items = std::filesystem::directory_iterator{dir.path};
+        for (auto const & item : items) {
+            CHECK(item.path().extension() == ".cbor");
+            ++files;
+        }
+        CHECK(files == 2);
+    }
+
+    TEST_CASE("Temporary files left by a dead writer are removed")
+    {
+        TempDir dir;
+        std::filesystem::create_directories(dir.path);
+        auto const stale = dir.path / "0123456789abcdef.cbor.1.0.tmp";
+        auto const fresh = dir.path / "0123456789abcdef.cbor.2.0.tmp";
+        std::ofstream(stale) << "partial";
+        std::ofstream(fresh) << "partial";
+        set_age(stale, std::chrono::hours{1});
+
+        ResponseCache cache(dir.path, 1u << 20);
+        CHECK(cache.store(response_key("a"), reply(1)));
+
+        CHECK_FALSE(std::filesystem::exists(stale));
+        CHECK(std::filesystem::exists(fresh));
+    }
+}
+
+} // anonymous namespace
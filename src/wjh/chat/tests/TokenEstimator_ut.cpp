@@ -0,0 +1,133 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/TokenEstimator.hpp"
+
+#include <format>
+#include <memory>
+#include <string>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+using conversation::Conversation;
+using conversation::Message;
+using conversation::MessageText;
+using conversation::ToolCall;
+using conversation::ToolCallId;
+
+// Byte tokens plus "ab"; enough to tell the tokenizer from bytes / 4.
+std::shared_ptr<BpeTokenizer const>
+make_tokenizer()
+{
+    std::string vocab;
+    constexpr std::string_view alphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (unsigned b = 0; b < 256; ++b) {
+        vocab += std::format(
+            "{}{}== {}\n",
+            alphabet[b >> 2],
+            alphabet[(b & 3u) << 4],
+            b);
+    }
+    vocab += "YWI= 256\n";
+    auto tokenizer = BpeTokenizer::parse(vocab);
+    REQUIRE(tokenizer.has_value());
+    return std::make_shared<BpeTokenizer const>(std::move(*tokenizer));
+}
+
+TEST_SUITE("TokenEstimator")
+{
+    TEST_CASE("without a tokenizer text is four bytes per token")
+    {
+        TokenEstimator estimator;
+        CHECK_FALSE(estimator.has_tokenizer());
+        CHECK(estimator.count(std::string_view{}) == 0u);
+        CHECK(estimator.count(std::string_view{"abc"}) == 1u);
+        CHECK(estimator.count(std::string(4000, 'x')) == 1000u);
+    }
+
+    TEST_CASE("with a tokenizer its counts are used")
+    {
+        TokenEstimator estimator(make_tokenizer());
+        CHECK(estimator.has_tokenizer());
+        CHECK(estimator.count(std::string_view{"ababab"}) == 3u);
+        CHECK(estimator.count(std::string_view{"xyz"}) == 3u);
+    }
+
+    TEST_CASE("messages include framing, tool calls, and call ids")
+    {
+        TokenEstimator estimator;
+        auto const text = Message::user(UserInput{std::string(40, 'x')});
+        CHECK(estimator.count(text) == TokenEstimator::per_message + 10);
+
+        auto const call = Message::tool_calls(
+            {ToolCall{
+                .id = ToolCallId{"call_123"},
+                .name = "read_file",
+                .arguments = std::string(80, 'a')}},
+            MessageText{""});
+        CHECK(estimator.count(call) == TokenEstimator::per_message + 25);
+
+        auto const result = Message::tool_result(
+            ToolCallId{"call_123"},
+            MessageText{std::string(400, 'r')});
+        CHECK(estimator.count(result) == TokenEstimator::per_message + 102);
+    }
+
+    TEST_CASE("estimate covers the system prompt and every message")
+    {
+        TokenEstimator estimator;
+        Conversation conv;
+        conv.set_system_prompt(SystemPrompt{std::string(400, 's')});
+        conv.add_message(UserInput{std::string(40, 'u')});
+        conv.add_message(AssistantResponse{std::string(80, 'a')});
+
+        CHECK(estimator.estimate(conv)
+              == TokenEstimator::per_request
+                  + 3 * TokenEstimator::per_message + 100 + 10 + 20);
+    }
+
+    TEST_CASE("counts are cached only for messages still present")
+    {
+        TokenEstimator estimator;
+        Conversation conv;
+        conv.add_message(UserInput{"one"});
+        conv.add_message(AssistantResponse{"two"});
+        auto const first = estimator.estimate(conv);
+        CHECK(estimator.cached() == 2u);
+
+        conv.add_message(UserInput{"three"});
+        CHECK(estimator.estimate(conv) > first);
+        CHECK(estimator.cached() == 3u);
+
+        conv.replace_prefix(2, Message::user(UserInput{"summary"}));
+        (void)estimator.estimate(conv);
+        CHECK(estimator.cached() == 2u);
+
+        conv.clear();
+        CHECK(estimator.estimate(conv) == TokenEstimator::per_request);
+        CHECK(estimator.cached() == 0u);
+    }
+
+    TEST_CASE("switching tokenizers drops cached counts")
+    {
+        TokenEstimator estimator;
+        Conversation conv;
+        conv.add_message(UserInput{"abababab"});
+        CHECK(estimator.estimate(conv)
+              == TokenEstimator::per_request + TokenEstimator::per_message + 2);
+
+        estimator.set_tokenizer(make_tokenizer());
+        CHECK(estimator.cached() == 0u);
+        CHECK(estimator.estimate(conv)
+              == TokenEstimator::per_request + TokenEstimator::per_message + 4);
+    }
+}
+
+} // anonymous namespace
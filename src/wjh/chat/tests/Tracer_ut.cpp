@@ -0,0 +1,161 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/Tracer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using wjh::chat::client::TraceSpan;
+using wjh::chat::client::Tracer;
+
+std::filesystem::path
+trace_path(std::string_view name)
+{
+    return std::filesystem::temp_directory_path()
+        / std::format("wjh_chat_trace_{}_{}.json", name, getpid());
+}
+
+// The "X" (complete) events of a written trace.
+std::vector<nlohmann::json>
+read_spans(std::filesystem::path const & path)
+{
+    std::ifstream file(path);
+    auto const trace = nlohmann::json::parse(file);
+    file.close();
+    std::filesystem::remove(path);
+
+    std::vector<nlohmann::json> spans;
+    for (auto const & event : trace["traceEvents"]) {
+        if (event["ph"] == "X") {
+            spans.push_back(event);
+        }
+    }
+    return spans;
+}
+
+TEST_SUITE("Tracer")
+{
+    TEST_CASE("Nothing is recorded while the tracer is off")
+    {
+        Tracer::start();
+        Tracer::stop();
+        {
+            auto const span = TraceSpan("ignored");
+        }
+        Tracer::record(
+            "ignored", Tracer::clock::now(), Tracer::clock::now());
+
+        auto const path = trace_path("off");
+        auto const written = Tracer::write(path);
+
+        REQUIRE(written.has_value());
+        CHECK(*written == 0);
+        CHECK(read_spans(path).empty());
+    }
+
+    TEST_CASE("Spans are written as Chrome trace events")
+    {
+        using namespace std::chrono_literals;
+
+        Tracer::start();
+        {
+            auto const outer = TraceSpan("turn");
+            auto const inner = TraceSpan("tool", "read_file");
+            std::this_thread::sleep_for(1ms);
+        }
+        Tracer::stop();
+
+        auto const path = trace_path("spans");
+        REQUIRE(Tracer::write(path).has_value());
+        auto const spans = read_spans(path);
+
+        REQUIRE(spans.size() == 2);
+        auto const & turn = spans[0]["name"] == "turn" ? spans[0] : spans[1];
+        auto const & tool = spans[0]["name"] == "turn" ? spans[1] : spans[0];
+        CHECK(turn["name"] == "turn");
+        CHECK(tool["name"] == "tool");
+        CHECK(tool["args"]["detail"] == "read_file");
+        CHECK(turn["ts"].get<double>() <= tool["ts"].get<double>());
+        CHECK(tool["dur"].get<double>() >= 1000.0);
+        CHECK(turn["dur"].get<double>() >= tool["dur"].get<double>());
+        CHECK(turn["tid"] == tool["tid"]);
+    }
+
+    TEST_CASE("Each thread records into its own track")
+    {
+        Tracer::start();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 3; ++t) {
+            threads.emplace_back([] {
+                for (int i = 0; i < 100; ++i) {
+                    auto const span = TraceSpan("work");
+                }
+            });
+        }
+        for (auto & thread : threads) {
+            thread.join();
+        }
+        Tracer::stop();
+
+        auto const path = trace_path("threads");
+        auto const written = Tracer::write(path);
+        auto const spans = read_spans(path);
+
+        REQUIRE(written.has_value());
+        CHECK(*written == 300);
+        auto tids = std::set<int>{};
+        for (auto const & span : spans) {
+            tids.insert(span["tid"].get<int>());
+        }
+        CHECK(tids.size() == 3);
+    }
+
+    TEST_CASE("start drops spans from an earlier trace")
+    {
+        Tracer::start();
+        {
+            auto const span = TraceSpan("old");
+        }
+        Tracer::start();
+        {
+            auto const span = TraceSpan("new");
+        }
+        Tracer::stop();
+
+        auto const path = trace_path("restart");
+        REQUIRE(Tracer::write(path).has_value());
+        auto const spans = read_spans(path);
+
+        REQUIRE(spans.size() == 1);
+        CHECK(spans[0]["name"] == "new");
+    }
+
+    TEST_CASE("write reports a path it cannot open")
+    {
+        auto const written =
+            Tracer::write("/nonexistent/dir/wjh_chat_trace.json");
+
+        REQUIRE_FALSE(written.has_value());
+        CHECK(written.error().find("Cannot write trace") != std::string::npos);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,581 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/Transport.hpp"
+
+#include "wjh/chat/client/OpenRouterClient.hpp"
+#include "wjh/chat/client/Tracer.hpp"
+#include "wjh/chat/conversation/Conversation.hpp"
+#include "wjh/chat/json_convert.hpp"
+
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+using namespace wjh::chat::client;
+using nlohmann::json;
+
+// Recording file, removed on destruction.
+struct TempFile
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path()
+        / std::format("wjh_chat_transport_test_{}.jsonl", getpid());
+
+    TempFile() { std::filesystem::remove(path); }
+    ~TempFile() { std::filesystem::remove(path); }
+
+    TempFile(TempFile const &) = delete;
+    TempFile & operator = (TempFile const &) = delete;
+
+    [[nodiscard]]
+    std::string read() const
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(
+            (std::istreambuf_iterator<char>(file)),
+            std::istreambuf_iterator<char>());
+    }
+};
+
+// Answers each request with the next queued response.
+class ScriptedTransport
+: public ITransport
+{
+public:
+    explicit ScriptedTransport(std::deque<Result<HttpResponse>> responses)
+    : responses_(std::move(responses))
+    { }
+
+private:
+    Result<HttpResponse> do_post(
+        HttpPath const &,
+        HttpBody const &,
+        HttpHeaders const &) override
+    {
+        auto response = std::move(responses_.front());
+        responses_.pop_front();
+        return response;
+    }
+
+    std::deque<Result<HttpResponse>> responses_;
+};
+
+// Answers each request by calling a function with its JSON body.
+class FunctionTransport
+: public ITransport
+{
+public:
+    explicit FunctionTransport(std::function<json(json const &)> answer)
+    : answer_(std::move(answer))
+    { }
+
+private:
+    Result<HttpResponse> do_post(
+        HttpPath const &,
+        HttpBody const & body,
+        HttpHeaders const &) override;
+
+    std::function<json(json const &)> answer_;
+};
+
+HttpResponse
+ok(std::string body)
+{
+    auto response = HttpResponse{
+        .status = HttpStatusCode{200},
+        .headers = HttpHeaders{},
+        .body = HttpBody{std::move(body)}};
+    response.headers.add(
+        HeaderName{"Content-Type"},
+        HeaderValue{"application/json"});
+    return response;
+}
+
+Result<HttpResponse>
+FunctionTransport::
+do_post(HttpPath const &, HttpBody const & body, HttpHeaders const &)
+{
+    return ok(answer_(json::parse(json_value(body))).dump());
+}
+
+json
+tool_call_reply(char const * name, json const & arguments)
+{
+    return {
+        {"choices",
+         json::array(
+             {{{"message",
+                {{"role", "assistant"},
+                 {"content", nullptr},
+                 {"tool_calls",
+                  json::array(
+                      {{{"id", "call_1"},
+                        {"type", "function"},
+                        {"function",
+                         {{"name", name},
+                          {"arguments", arguments.dump()}}}}})}}},
+               {"finish_reason", "tool_calls"}}})}};
+}
+
+HttpHeaders
+auth()
+{
+    return HttpHeaders{
+        {HeaderName{"Authorization"}, HeaderValue{"Bearer sk-secret"}}};
+}
+
+std::string
+exchange(
+    char const * request,
+    json const & response,
+    std::int64_t elapsed_us = 0)
+{
+    return json{
+        {"path", "/api/v1/chat/completions"},
+        {"request", request},
+        {"status", 200},
+        {"response", response.dump()},
+        {"elapsed_us", elapsed_us}}.dump() + "\n";
+}
+
+json
+text_reply(char const * text)
+{
+    return {
+        {"choices",
+         json::array(
+             {{{"message", {{"role", "assistant"}, {"content", text}}},
+               {"finish_reason", "stop"}}})},
+        {"usage",
+         {{"prompt_tokens", 12},
+          {"completion_tokens", 3},
+          {"total_tokens", 15}}}};
+}
+
+OpenRouterClientConfig
+client_config()
+{
+    return OpenRouterClientConfig{
+        .api_key = ApiKey("test-api-key"),
+        .model = ModelId("openai/gpt-4"),
+        .max_tokens = MaxTokens(4096u),
+        .system_prompt = std::nullopt,
+        .temperature = std::nullopt};
+}
+
+TEST_SUITE("Transport")
+{
+    TEST_CASE("parse_endpoint")
+    {
+        auto const https = parse_endpoint("https://openrouter.ai");
+        REQUIRE(https.has_value());
+        CHECK(https->scheme == HttpScheme::https);
+        CHECK(https->host == Hostname{"openrouter.ai"});
+        CHECK(https->port == PortNumber{443});
+
+        auto const local = parse_endpoint("http://127.0.0.1:8080/");
+        REQUIRE(local.has_value());
+        CHECK(local->scheme == HttpScheme::http);
+        CHECK(local->host == Hostname{"127.0.0.1"});
+        CHECK(local->port == PortNumber{8080});
+
+        CHECK(parse_endpoint("http://localhost")->port == PortNumber{80});
+        CHECK_FALSE(parse_endpoint("ftp://localhost").has_value());
+        CHECK_FALSE(parse_endpoint("http://").has_value());
+        CHECK_FALSE(parse_endpoint("http://host:0").has_value());
+        CHECK_FALSE(parse_endpoint("http://host:99999").has_value());
+        CHECK_FALSE(parse_endpoint("http://host/api/v1").has_value());
+    }
+
+    TEST_CASE("parse_replay_pace")
+    {
+        CHECK(parse_replay_pace("fast") == ReplayPace::fast);
+        CHECK(parse_replay_pace("recorded") == ReplayPace::recorded);
+        CHECK_FALSE(parse_replay_pace("slow").has_value());
+    }
+
+    TEST_CASE("A recording replays the same exchanges")
+    {
+        TempFile file;
+        {
+            auto recorder = RecordingTransport::open(
+                std::make_unique<ScriptedTransport>(
+                    std::deque<Result<HttpResponse>>{
+                        ok(R"({"n":1})"),
+                        make_error("HTTP request failed: timeout")}),
+                file.path);
+            REQUIRE(recorder.has_value());
+
+            auto const first = (*recorder)->post(
+                HttpPath{"/api/v1/chat/completions"},
+                HttpBody{"first"},
+                auth());
+            REQUIRE(first.has_value());
+            CHECK(first->body == HttpBody{R"({"n":1})"});
+            CHECK_FALSE((*recorder)
+                            ->post(
+                                HttpPath{"/api/v1/chat/completions"},
+                                HttpBody{"second"},
+                                auth())
+                            .has_value());
+        }
+
+        CHECK(file.read().find("sk-secret") == std::string::npos);
+
+        auto replay = ReplayTransport::load(file.path, ReplayPace::fast);
+        REQUIRE(replay.has_value());
+        CHECK(replay->size() == 2);
+
+        auto const first = replay->post(
+            HttpPath{"/api/v1/chat/completions"},
+            HttpBody{"first"},
+            HttpHeaders{});
+        REQUIRE(first.has_value());
+        CHECK(first->status == HttpStatusCode{200});
+        CHECK(first->body == HttpBody{R"({"n":1})"});
+        CHECK(first->headers.begin()->second == "application/json");
+
+        auto const second = replay->post(
+            HttpPath{"/api/v1/chat/completions"},
+            HttpBody{"second"},
+            HttpHeaders{});
+        REQUIRE_FALSE(second.has_value());
+        CHECK(second.error() == "HTTP request failed: timeout");
+        CHECK(replay->mismatches() == 0);
+        CHECK(replay->remaining() == 0);
+    }
+
+    TEST_CASE("Replay counts differing requests and runs out")
+    {
+        auto replay = ReplayTransport::parse(
+            exchange("one", text_reply("a")), ReplayPace::fast);
+        REQUIRE(replay.has_value());
+
+        auto const post = [&replay](char const * body) {
+            return replay->post(
+                HttpPath{"/api/v1/chat/completions"},
+                HttpBody{body},
+                HttpHeaders{});
+        };
+
+        CHECK(post("other").has_value());
+        CHECK(replay->mismatches() == 1);
+        auto const exhausted = post("one");
+        REQUIRE_FALSE(exhausted.has_value());
+        CHECK(exhausted.error().find("no more recorded exchanges")
+              != std::string::npos);
+
+        replay->rewind();
+        CHECK(replay->mismatches() == 0);
+        CHECK(post("one").has_value());
+        CHECK(replay->mismatches() == 0);
+    }
+
+    TEST_CASE("Recorded pace waits as long as the original exchange")
+    {
+        auto replay = ReplayTransport::parse(
+            exchange("one", text_reply("a"), 20'000),
+            ReplayPace::recorded);
+        REQUIRE(replay.has_value());
+
+        auto const start = std::chrono::steady_clock::now();
+        CHECK(replay
+                  ->post(
+                      HttpPath{"/api/v1/chat/completions"},
+                      HttpBody{"one"},
+                      HttpHeaders{})
+                  .has_value());
+        CHECK(std::chrono::steady_clock::now() - start
+              >= std::chrono::milliseconds{20});
+    }
+
+    TEST_CASE("Malformed recordings are rejected with the line")
+    {
+        auto const replay = ReplayTransport::parse(
+            exchange("one", text_reply("a")) + "\n{\"request\": 1}\n",
+            ReplayPace::fast);
+
+        REQUIRE_FALSE(replay.has_value());
+        CHECK(replay.error().starts_with("line 3:"));
+    }
+
+    TEST_CASE("make_transport")
+    {
+        TempFile file;
+
+        CHECK_FALSE(make_transport(TransportOptions{
+                        .record = file.path,
+                        .replay = file.path})
+                        .has_value());
+        CHECK_FALSE(
+            make_transport(TransportOptions{.replay = file.path})
+                .has_value());
+
+        std::ofstream(file.path) << exchange("one", text_reply("a"));
+        CHECK(make_transport(TransportOptions{.replay = file.path})
+                  .has_value());
+    }
+
+    TEST_CASE("OpenRouterClient runs a turn over a replay")
+    {
+        auto replay = ReplayTransport::parse(
+            exchange("ignored", text_reply("Hello from the replay")),
+            ReplayPace::fast);
+        REQUIRE(replay.has_value());
+        OpenRouterClient client(
+            client_config(),
+            std::make_unique<ReplayTransport>(std::move(*replay)));
+        conversation::Conversation conv;
+        conv.add_message(UserInput{"Hi"});
+
+        auto const response = client.send_message(conv);
+
+        REQUIRE(response.has_value());
+        CHECK(response->response == AssistantResponse{"Hello from the replay"});
+        REQUIRE(response->usage.has_value());
+        CHECK(response->usage->prompt_tokens == PromptTokens{12u});
+        CHECK_FALSE(client.send_message(conv).has_value());
+    }
+
+    TEST_CASE("OpenRouterClient reports where a turn's time went")
+    {
+        auto const call = json{
+            {"choices",
+             json::array(
+                 {{{"message",
+                    {{"role", "assistant"},
+                     {"content", nullptr},
+                     {"tool_calls",
+                      json::array(
+                          {{{"id", "call_1"},
+                            {"type", "function"},
+                            {"function",
+                             {{"name", "read_file"},
+                              {"arguments",
+                               R"({"file_path":"/nonexistent"})"}}}}})}}},
+                   {"finish_reason", "tool_calls"}}})}};
+        std::deque<Result<HttpResponse>> responses;
+        responses.push_back(ok(call.dump()));
+        responses.push_back(ok(text_reply("Done").dump()));
+        OpenRouterClient client(
+            client_config(),
+            std::make_unique<ScriptedTransport>(std::move(responses)));
+        conversation::Conversation conv;
+        conv.add_message(UserInput{"Read it"});
+
+        auto const response = client.send_message(conv);
+
+        REQUIRE(response.has_value());
+        auto const & timing = response->timing;
+        CHECK(timing.requests == 2);
+        REQUIRE(timing.tool_calls.size() == 1);
+        CHECK(timing.tool_calls[0].name == "read_file");
+        CHECK(timing.tools == timing.tool_calls[0].elapsed);
+        CHECK(timing.parse > TurnTiming::Duration{});
+        // No HTTP timestamps: everything before the body is wait.
+        CHECK(timing.download == TurnTiming::Duration{});
+        CHECK(timing.request_times.size() == 2);
+        CHECK(timing.retries == 0);
+        CHECK(timing.bytes_sent > 0);
+        CHECK(timing.bytes_received
+              == call.dump().size() + text_reply("Done").dump().size());
+        CHECK(timing.first_response > TurnTiming::Duration{});
+    }
+
+    TEST_CASE("OpenRouterClient keeps the timing of a failed turn")
+    {
+        auto const call = tool_call_reply(
+            "read_file", {{"file_path", "/nonexistent"}});
+        std::deque<Result<HttpResponse>> responses;
+        responses.push_back(ok(call.dump()));
+        responses.push_back(make_error("Connection reset"));
+        responses.push_back(ok(text_reply("Done").dump()));
+        OpenRouterClient client(
+            client_config(),
+            std::make_unique<ScriptedTransport>(std::move(responses)));
+        conversation::Conversation conv;
+        conv.add_message(UserInput{"Read it"});
+
+        REQUIRE_FALSE(client.send_message(conv).has_value());
+        auto const failed = client.failed_timing();
+        CHECK(failed.requests == 2);
+        CHECK(failed.request_times.size() == 2);
+        CHECK(failed.bytes_received == call.dump().size());
+        CHECK(failed.tool_calls.size() == 1);
+
+        REQUIRE(client.send_message(conv).has_value());
+        CHECK(client.failed_timing().requests == 0);
+    }
+
+    TEST_CASE("OpenRouterClient pages through a spilled output")
+    {
+        auto const path = std::filesystem::temp_directory_path()
+            / std::format("wjh_chat_spill_page_{}.txt", getpid());
+        {
+            std::ofstream file(path);
+            for (int i = 1; i <= 400; ++i) {
+                file << std::format("line {} of a long listing\n", i);
+            }
+        }
+
+        // read_file, then read_output on the handle it was spilled to.
+        auto results = std::vector<std::string>{};
+        auto const answer = [&results, &path](json const & request) {
+            auto const & last = request["messages"].back();
+            if (last["role"] != "tool") {
+                return tool_call_reply(
+                    "read_file", {{"file_path", path.string()}});
+            }
+            auto const result = last["content"].get<std::string>();
+            results.push_back(result);
+            if (results.size() > 1) {
+                return text_reply("Done");
+            }
+            auto const at = result.find("out-");
+            REQUIRE(at != std::string::npos);
+            return tool_call_reply(
+                "read_output",
+                {{"handle", result.substr(at, 20)},
+                 {"offset", 100},
+                 {"limit", 50}});
+        };
+        auto const blobs = std::filesystem::temp_directory_path()
+            / std::format("wjh_chat_spill_blobs_{}", getpid());
+        auto config = client_config();
+        config.tool_output_spill.threshold = 1000;
+        config.blob_dir = blobs;
+        OpenRouterClient client(
+            config,
+            std::make_unique<FunctionTransport>(answer));
+        conversation::Conversation conv;
+        conv.add_message(UserInput{"Read it"});
+
+        auto const response = client.send_message(conv);
+        std::filesystem::remove(path);
+        CHECK_FALSE(std::filesystem::is_empty(blobs));
+        std::filesystem::remove_all(blobs);
+
+        REQUIRE(response.has_value());
+        REQUIRE(results.size() == 2);
+        CHECK(results[0].find("[Output too large") != std::string::npos);
+        CHECK(results[1].find("[Output too large") == std::string::npos);
+        CHECK(results[1].find("line 100 of a long listing")
+              != std::string::npos);
+        CHECK(results[1].find("line 149 of a long listing")
+              != std::string::npos);
+    }
+
+    TEST_CASE("OpenRouterClient marks each request of a turn afresh")
+    {
+        // The tool result of the second request moves the breakpoint
+        // off the user message the first request marked.
+        auto requests = std::vector<json>{};
+        auto const answer = [&requests](json const & request) {
+            requests.push_back(request["messages"]);
+            if (requests.size() == 1) {
+                return tool_call_reply(
+                    "read_file", {{"file_path", "/nonexistent"}});
+            }
+            return text_reply("Done");
+        };
+        auto config = client_config();
+        config.system_prompt = SystemPrompt{"Be brief."};
+        config.prompt_cache = PromptCacheMode::on;
+        OpenRouterClient client(
+            config,
+            std::make_unique<FunctionTransport>(answer));
+        conversation::Conversation conv;
+        conv.add_message(UserInput{"Read it"});
+
+        REQUIRE(client.send_message(conv).has_value());
+        REQUIRE(requests.size() == 2);
+        auto const marked = [](json const & message) {
+            auto const & content = message["content"];
+            return content.is_array()
+                and content.back().contains("cache_control");
+        };
+        CHECK(marked(requests[0][0]));
+        CHECK(marked(requests[0][1]));
+        REQUIRE(requests[1].size() == 4);
+        CHECK(marked(requests[1][0]));
+        CHECK(requests[1][1]["content"] == "Read it");
+        CHECK(marked(requests[1][3]));
+    }
+
+    TEST_CASE("OpenRouterClient traces each phase of a turn")
+    {
+        auto const call = json{
+            {"choices",
+             json::array(
+                 {{{"message",
+                    {{"role", "assistant"},
+                     {"content", nullptr},
+                     {"tool_calls",
+                      json::array(
+                          {{{"id", "call_1"},
+                            {"type", "function"},
+                            {"function",
+                             {{"name", "read_file"},
+                              {"arguments",
+                               R"({"file_path":"/nonexistent"})"}}}}})}}},
+                   {"finish_reason", "tool_calls"}}})}};
+        std::deque<Result<HttpResponse>> responses;
+        responses.push_back(ok(call.dump()));
+        responses.push_back(ok(text_reply("Done").dump()));
+        OpenRouterClient client(
+            client_config(),
+            std::make_unique<ScriptedTransport>(std::move(responses)));
+        conversation::Conversation conv;
+        conv.add_message(UserInput{"Read it"});
+
+        auto const path = std::filesystem::temp_directory_path()
+            / std::format("wjh_chat_client_trace_{}.json", getpid());
+        Tracer::start();
+        auto const response = client.send_message(conv);
+        Tracer::stop();
+        REQUIRE(Tracer::write(path).has_value());
+        std::ifstream file(path);
+        auto const trace = json::parse(file);
+        file.close();
+        std::filesystem::remove(path);
+
+        REQUIRE(response.has_value());
+        auto names = std::map<std::string, int>{};
+        auto tool = std::string{};
+        for (auto const & event : trace["traceEvents"]) {
+            if (event["ph"] == "X") {
+                ++names[event["name"].get<std::string>()];
+            }
+            if (event["name"] == "tool") {
+                tool = event["args"]["detail"].get<std::string>();
+            }
+        }
+        CHECK(names["build"] == 1);
+        CHECK(names["serialize"] == 2);
+        CHECK(names["http.wait"] == 2);
+        CHECK(names["parse.json"] == 2);
+        CHECK(names["parse"] == 2);
+        CHECK(names["approve"] == 1);
+        CHECK(names["tool"] == 1);
+        CHECK(tool == "read_file");
+    }
+}
+
+} // anonymous namespace
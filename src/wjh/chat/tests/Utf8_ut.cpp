@@ -0,0 +1,87 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/Utf8.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+
+std::string
+sanitized(std::string text, Utf8Options options = {})
+{
+    (void)sanitize_utf8(text, options);
+    return text;
+}
+
+TEST_SUITE("Utf8")
+{
+    TEST_CASE("Well-formed text is valid and unchanged")
+    {
+        auto const text = std::string(100, 'a') + "caf\xC3\xA9 \xE2\x82\xAC "
+            "\xF0\x9F\x98\x80" + std::string(40, 'z');
+
+        CHECK(is_valid_utf8(text));
+        auto copy = text;
+        auto const repair = sanitize_utf8(copy);
+        CHECK(copy == text);
+        CHECK(repair.replaced == 0);
+        CHECK(repair.stripped == 0);
+    }
+
+    TEST_CASE("Ill-formed sequences are rejected")
+    {
+        CHECK_FALSE(is_valid_utf8("\xC0\xAF")); // overlong
+        CHECK_FALSE(is_valid_utf8("\xED\xA0\x80")); // surrogate
+        CHECK_FALSE(is_valid_utf8("\xF4\x90\x80\x80")); // above U+10FFFF
+        CHECK_FALSE(is_valid_utf8("abc\xE2\x82")); // truncated
+        CHECK_FALSE(is_valid_utf8(std::string(33, 'x') + "\xFF"));
+    }
+
+    TEST_CASE("Each maximal ill-formed subpart becomes one U+FFFD")
+    {
+        CHECK(sanitized("a\xFF" "b") == "a\xEF\xBF\xBD" "b");
+        CHECK(sanitized("\xE2\x82" "x") == "\xEF\xBF\xBD" "x");
+        CHECK(sanitized("\xF0\x80\x80")
+              == "\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD");
+        CHECK(sanitized("\xC3\xA9\x80") == "\xC3\xA9\xEF\xBF\xBD");
+
+        std::string text = "ok\xFE\xFE";
+        auto const repair = sanitize_utf8(text);
+        CHECK(repair.replaced == 2);
+        CHECK(is_valid_utf8(text));
+    }
+
+    TEST_CASE("Repaired output serializes as JSON")
+    {
+        auto text = std::string(1000, 'x')
+            + std::string("\x89PNG\r\n\x1A\n\x00\xFF", 10)
+            + std::string(1000, 'y');
+        CHECK_THROWS(nlohmann::json(text).dump());
+
+        (void)sanitize_utf8(text);
+        CHECK_NOTHROW(nlohmann::json(text).dump());
+    }
+
+    TEST_CASE("Control characters are stripped only when asked")
+    {
+        auto const text = std::string("a\tb\r\nc\x1B[0m\x7F" "d\xC2\x85" "e");
+
+        CHECK(sanitized(text) == text);
+
+        auto stripped = text;
+        auto const repair =
+            sanitize_utf8(stripped, Utf8Options{.strip_control = true});
+        CHECK(stripped == "a\tb\r\nc[0mde");
+        CHECK(repair.stripped == 3);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,201 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/WireLog.hpp"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+using wjh::chat::Result;
+using wjh::chat::make_error;
+
+std::filesystem::path
+log_path(std::string_view name)
+{
+    return std::filesystem::temp_directory_path()
+        / std::format("wjh_chat_wire_{}_{}.log", name, getpid());
+}
+
+HttpHeaders
+request_headers()
+{
+    auto headers = HttpHeaders{};
+    headers.add(
+        HeaderName{"Authorization"},
+        HeaderValue{"Bearer sk-or-secret"});
+    headers.add(
+        HeaderName{"Content-Type"},
+        HeaderValue{"application/json"});
+    return headers;
+}
+
+HttpResponse
+ok_response(std::string body)
+{
+    auto response = HttpResponse{
+        .status = HttpStatusCode{200},
+        .headers = HttpHeaders{},
+        .body = HttpBody{std::move(body)}};
+    response.headers.add(
+        HeaderName{"Content-Type"},
+        HeaderValue{"application/json"});
+    return response;
+}
+
+bool
+has(std::string_view text, std::string_view part)
+{
+    return text.find(part) != std::string_view::npos;
+}
+
+// Close the log and return what it holds.
+std::string
+close_and_read(std::filesystem::path const & path)
+{
+    WireLog::close();
+    auto text = WireLog::read(path);
+    REQUIRE(text.has_value());
+    std::filesystem::remove(path);
+    return *text;
+}
+
+TEST_SUITE("WireLog")
+{
+    TEST_CASE("Requests and responses are logged with secrets redacted")
+    {
+        auto const path = log_path("exchange");
+        REQUIRE(WireLog::open(path, 1 << 16).has_value());
+        CHECK(WireLog::enabled());
+        CHECK(WireLog::path() == path);
+
+        WireLog::log_request(
+            HttpPath{"/api/v1/chat/completions"},
+            request_headers(),
+            HttpBody{R"({"model":"m"})"});
+        WireLog::log_response(ok_response(R"({"id":"r1"})"));
+        auto const text = close_and_read(path);
+
+        CHECK_FALSE(WireLog::enabled());
+        CHECK_FALSE(WireLog::path().has_value());
+        CHECK(text.starts_with("=== 1 request "));
+        CHECK(has(text, "POST /api/v1/chat/completions HTTP/1.1\r\n"));
+        CHECK(has(text, "Authorization: [redacted]\r\n"));
+        CHECK_FALSE(has(text, "sk-or-secret"));
+        CHECK(has(text, "\r\n\r\n{\"model\":\"m\"}\n"));
+        CHECK(has(text, "\n=== 2 response "));
+        CHECK(has(text, "HTTP/1.1 200\r\n"));
+        CHECK(has(text, "{\"id\":\"r1\"}\n"));
+    }
+
+    TEST_CASE("Transport errors are logged")
+    {
+        auto const path = log_path("error");
+        REQUIRE(WireLog::open(path, 1 << 16).has_value());
+        WireLog::log_response(
+            Result<HttpResponse>{make_error("Connection reset")});
+        auto const text = close_and_read(path);
+
+        CHECK(text.starts_with("=== 1 error "));
+        CHECK(has(text, " 16\nConnection reset\n"));
+    }
+
+    TEST_CASE("Nothing is logged while paused")
+    {
+        auto const path = log_path("paused");
+        REQUIRE(WireLog::open(path, 1 << 16).has_value());
+        WireLog::set_enabled(false);
+        CHECK_FALSE(WireLog::enabled());
+        WireLog::log_response(ok_response("hidden"));
+        WireLog::set_enabled(true);
+        WireLog::log_response(ok_response("shown"));
+        auto const text = close_and_read(path);
+
+        CHECK_FALSE(has(text, "hidden"));
+        CHECK(has(text, "shown"));
+    }
+
+    TEST_CASE("Logging cannot be enabled without a file")
+    {
+        WireLog::close();
+        WireLog::set_enabled(true);
+        CHECK_FALSE(WireLog::enabled());
+        WireLog::log_response(ok_response("nowhere"));
+    }
+
+    TEST_CASE("A full ring keeps the newest records")
+    {
+        auto const path = log_path("wrap");
+        REQUIRE(WireLog::open(path, 512).has_value());
+        for (int i = 0; i < 40; ++i) {
+            WireLog::log_response(ok_response(std::format("body-{:03d}", i)));
+            WireLog::flush();
+        }
+        auto const text = close_and_read(path);
+
+        CHECK(text.starts_with("=== "));
+        CHECK(text.size() <= 512);
+        CHECK(text.ends_with("body-039\n"));
+        CHECK_FALSE(has(text, "body-000"));
+    }
+
+    TEST_CASE("A record larger than the ring is dropped")
+    {
+        auto const path = log_path("drop");
+        REQUIRE(WireLog::open(path, 256).has_value());
+        WireLog::log_response(ok_response(std::string(1000, 'x')));
+        WireLog::log_response(ok_response("small"));
+        auto const text = close_and_read(path);
+
+        CHECK_FALSE(has(text, "xxxx"));
+        CHECK(has(text, "small"));
+    }
+
+    TEST_CASE("Reopening the open file starts it over")
+    {
+        auto const path = log_path("reopen");
+        REQUIRE(WireLog::open(path, 1 << 16).has_value());
+        for (int i = 0; i < 100; ++i) {
+            WireLog::log_response(ok_response(std::format("old-{:03d}", i)));
+        }
+        REQUIRE(WireLog::open(path, 1 << 12).has_value());
+        WireLog::log_response(ok_response("new"));
+        auto const text = close_and_read(path);
+
+        CHECK(text.starts_with("=== 1 response "));
+        CHECK(has(text, "new"));
+        CHECK_FALSE(has(text, "old-"));
+    }
+
+    TEST_CASE("Reading rejects other files")
+    {
+        auto const path = log_path("other");
+        std::ofstream(path) << "not a wire log\n";
+        CHECK_FALSE(WireLog::read(path).has_value());
+        std::filesystem::remove(path);
+        CHECK_FALSE(WireLog::read(path).has_value());
+    }
+
+    TEST_CASE("Opening an unwritable path fails")
+    {
+        auto const path = log_path("missing") / "wire.log";
+        auto const opened = WireLog::open(path, 1024);
+        REQUIRE_FALSE(opened.has_value());
+        CHECK(has(opened.error(), "Cannot open wire log"));
+        CHECK_FALSE(WireLog::enabled());
+    }
+}
+
+} // anonymous namespace
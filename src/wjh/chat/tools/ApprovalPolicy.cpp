@@ -0,0 +1,392 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/ApprovalPolicy.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iterator>
+
+#include <fnmatch.h>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+constexpr auto npos = std::string_view::npos;
+
+std::string_view
+trim(std::string_view s)
+{
+    auto const first = s.find_first_not_of(" \t\r\n");
+    if (first == npos) {
+        return {};
+    }
+    auto const last = s.find_last_not_of(" \t\r\n");
+    return s.substr(first, last - first + 1);
+}
+
+// Splits off the first whitespace-delimited word of s.
+std::string_view
+next_word(std::string_view & s)
+{
+    s = trim(s);
+    auto const end = s.find_first_of(" \t");
+    auto const word = s.substr(0, end);
+    s = end == npos ? std::string_view{} : trim(s.substr(end));
+    return word;
+}
+
+std::optional<Decision>
+parse_decision(std::string_view word)
+{
+    if (word == "allow") {
+        return Decision::allow;
+    }
+    if (word == "deny") {
+        return Decision::deny;
+    }
+    if (word == "ask") {
+        return Decision::ask;
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string>
+string_argument(ToolCall const & call, char const * key)
+{
+    auto const it = call.arguments.find(key);
+    if (it == call.arguments.end() or not it->is_string()) {
+        return std::nullopt;
+    }
+    return it->get<std::string>();
+}
+
+bool
+has_shell_metachar(std::string_view s)
+{
+    return s.find_first_of(";&|`<>\n") != npos
+        or s.find("$(") != npos;
+}
+
+// Absolute, with the symlinks of its existing part resolved; empty if
+// it cannot be resolved.
+std::filesystem::path
+resolved(std::filesystem::path const & path)
+{
+    std::error_code ec;
+    auto const absolute = std::filesystem::absolute(path, ec);
+    if (ec) {
+        return {};
+    }
+    auto result = std::filesystem::weakly_canonical(absolute, ec);
+    return ec ? std::filesystem::path{} : result;
+}
+
+bool
+path_within(
+    std::filesystem::path const & path,
+    std::filesystem::path const & prefix)
+{
+    // Resolve symlinks, so a link under the prefix cannot lead out.
+    auto const p = resolved(path);
+    auto const base = resolved(prefix);
+    if (p.empty() or base.empty()) {
+        return false;
+    }
+    auto const [pi, bi] =
+        std::mismatch(p.begin(), p.end(), base.begin(), base.end());
+    // A trailing separator leaves an empty final component.
+    return bi == base.end() or (std::next(bi) == base.end() and bi->empty());
+}
+
+bool
+matches(PolicyRule const & rule, ToolCall const & call)
+{
+    if (rule.tool != "*" and rule.tool != call.name) {
+        return false;
+    }
+
+    if (rule.path_prefix) {
+        auto const path = string_argument(call, "file_path");
+        return path and path_within(*path, *rule.path_prefix);
+    }
+
+    if (rule.command_pattern) {
+        auto const command = string_argument(call, "command");
+        if (not command
+            or fnmatch(rule.command_pattern->c_str(), command->c_str(), 0)
+                != 0)
+        {
+            return false;
+        }
+        return rule.decision != Decision::allow
+            or not has_shell_metachar(*command)
+            or has_shell_metachar(*rule.command_pattern);
+    }
+
+    return true;
+}
+
+// Numbers in a reply such as "1 3" or "1,3"; 1-based.
+std::vector<std::size_t>
+parse_selection(std::string_view answer)
+{
+    std::vector<std::size_t> result;
+    while (not answer.empty()) {
+        auto const start = answer.find_first_of("0123456789");
+        if (start == npos) {
+            break;
+        }
+        answer.remove_prefix(start);
+        std::size_t n = 0;
+        auto [ptr, ec] =
+            std::from_chars(answer.data(), answer.data() + answer.size(), n);
+        result.push_back(n);
+        answer.remove_prefix(static_cast<std::size_t>(ptr - answer.data()));
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+// ------------------------------------------------------------------
+// ApprovalPolicy
+// ------------------------------------------------------------------
+
+Result<ApprovalPolicy>
+ApprovalPolicy::
+parse(std::string_view spec)
+{
+    ApprovalPolicy policy;
+
+    while (not spec.empty()) {
+        auto const end = spec.find_first_of(";\n");
+        auto const text = trim(spec.substr(0, end));
+        spec = end == npos ? std::string_view{} : spec.substr(end + 1);
+        if (text.empty()) {
+            continue;
+        }
+
+        auto rest = text;
+        auto const action = next_word(rest);
+        auto const decision = parse_decision(action);
+        if (not decision) {
+            return make_error(
+                "unknown action '{}' in rule '{}' "
+                "(expected allow, deny, or ask)",
+                action,
+                text);
+        }
+
+        auto const tool = next_word(rest);
+        if (tool.empty()) {
+            return make_error("missing tool name in rule '{}'", text);
+        }
+
+        auto rule = PolicyRule{
+            .decision = *decision,
+            .tool = std::string(tool),
+            .path_prefix = std::nullopt,
+            .command_pattern = std::nullopt,
+            .text = std::string(text)};
+
+        if (rest.starts_with("path:")) {
+            rule.path_prefix = std::filesystem::path(trim(rest.substr(5)));
+        } else if (rest.starts_with("cmd:")) {
+            rule.command_pattern = std::string(trim(rest.substr(4)));
+        } else if (not rest.empty()) {
+            return make_error(
+                "expected path:<prefix> or cmd:<glob> in rule '{}'",
+                text);
+        }
+
+        policy.rules_.push_back(std::move(rule));
+    }
+
+    return policy;
+}
+
+PolicyVerdict
+ApprovalPolicy::
+evaluate(ToolCall const & call) const
+{
+    for (auto const & rule : rules_) {
+        if (matches(rule, call)) {
+            return PolicyVerdict{.decision = rule.decision, .rule = rule.text};
+        }
+    }
+
+    if (call.name == "read_file" or call.name == "read_output") {
+        return PolicyVerdict{
+            .decision = Decision::allow,
+            .rule = std::format("default: allow {}", call.name)};
+    }
+    return PolicyVerdict{.decision = Decision::ask, .rule = "default: ask *"};
+}
+
+std::string
+describe_tool_call(ToolCall const & call)
+{
+    auto const path = string_argument(call, "file_path");
+    if (auto const command = string_argument(call, "command")) {
+        return std::format("{}: {}", call.name, *command);
+    }
+    if (call.name == "write_file" and path) {
+        auto const content = string_argument(call, "content");
+        return std::format(
+            "write_file: {} ({} bytes)",
+            *path,
+            content ? content->size() : std::size_t{0});
+    }
+    if (call.name == "edit_file" and path) {
+        return std::format(
+            "edit_file: {}\n--- old ---\n{}\n--- new ---\n{}",
+            *path,
+            string_argument(call, "old_string").value_or(""),
+            string_argument(call, "new_string").value_or(""));
+    }
+    if (path) {
+        return std::format("{}: {}", call.name, *path);
+    }
+    return std::format(
+        "{}: {}",
+        call.name,
+        call.arguments.dump(
+            -1, ' ', false, nlohmann::json::error_handler_t::replace));
+}
+
+// ------------------------------------------------------------------
+// Approver
+// ------------------------------------------------------------------
+
+Approver::
+Approver(
+    ApprovalPolicy policy,
+    std::istream & in,
+    std::ostream & out,
+    std::optional<std::filesystem::path> audit_log)
+: policy_(std::move(policy))
+, in_(in)
+, out_(out)
+, audit_log_(std::move(audit_log))
+{ }
+
+std::vector<Approval>
+Approver::
+review(std::vector<ToolCall> const & calls)
+{
+    std::vector<Approval> result(calls.size());
+    std::vector<std::size_t> pending;
+
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        auto const verdict = policy_.evaluate(calls[i]);
+        switch (verdict.decision) {
+        case Decision::allow:
+            result[i] = Approval{.approved = true, .reason = {}};
+            audit(calls[i], result[i], "policy", verdict.rule);
+            break;
+        case Decision::deny:
+            result[i] = Approval{
+                .approved = false,
+                .reason = std::format(
+                    "Tool call denied by policy ({})",
+                    verdict.rule)};
+            audit(calls[i], result[i], "policy", verdict.rule);
+            break;
+        case Decision::ask:
+            pending.push_back(i);
+            break;
+        }
+    }
+
+    if (pending.empty()) {
+        return result;
+    }
+
+    if (pending.size() == 1) {
+        out_ << "\n[tool] " << describe_tool_call(calls[pending[0]])
+             << "\n[y/n]> " << std::flush;
+    } else {
+        out_ << "\n[tool] " << pending.size() << " calls need approval:\n";
+        for (std::size_t n = 0; n < pending.size(); ++n) {
+            auto description = describe_tool_call(calls[pending[n]]);
+            for (auto pos = description.find('\n'); pos != npos;
+                 pos = description.find('\n', pos + 1))
+            {
+                description.insert(pos + 1, "     ");
+            }
+            out_ << std::format("  {:>2}. {}\n", n + 1, description);
+        }
+        out_ << "[y]es to all, [n]o to all, or numbers to approve"
+                " (e.g. 1 3)> "
+             << std::flush;
+    }
+
+    std::string answer;
+    std::getline(in_, answer);
+    auto const reply = trim(answer);
+
+    std::vector<bool> approved(pending.size(), false);
+    if (reply.starts_with('y') or reply.starts_with('Y')) {
+        approved.assign(pending.size(), true);
+    } else if (pending.size() > 1) {
+        for (auto const n : parse_selection(reply)) {
+            if (n >= 1 and n <= pending.size()) {
+                approved[n - 1] = true;
+            }
+        }
+    }
+
+    for (std::size_t n = 0; n < pending.size(); ++n) {
+        auto const i = pending[n];
+        result[i] = approved[n]
+            ? Approval{.approved = true, .reason = {}}
+            : Approval{
+                  .approved = false,
+                  .reason = "Tool call skipped by user"};
+        audit(calls[i], result[i], "user", {});
+    }
+
+    return result;
+}
+
+void
+Approver::
+audit(
+    ToolCall const & call,
+    Approval const & approval,
+    std::string_view decided_by,
+    std::string_view rule)
+{
+    if (not audit_log_) {
+        return;
+    }
+
+    auto description = describe_tool_call(call);
+    description.erase(std::min(description.find('\n'), description.size()));
+
+    auto const entry = nlohmann::json{
+        {"time",
+         std::format(
+             "{:%FT%TZ}",
+             std::chrono::floor<std::chrono::seconds>(
+                 std::chrono::system_clock::now()))},
+        {"tool", call.name},
+        {"call", description},
+        {"approved", approval.approved},
+        {"decided_by", decided_by},
+        {"rule", rule}};
+
+    std::ofstream out(*audit_log_, std::ios::app);
+    out << entry.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace)
+        << '\n';
+}
+
+} // namespace wjh::chat::tools
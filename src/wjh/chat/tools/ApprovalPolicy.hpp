@@ -0,0 +1,159 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_D4E61A0B3C7F48259B6E0A1C8D3F5B72
+#define WJH_CHAT_D4E61A0B3C7F48259B6E0A1C8D3F5B72
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/tools/ToolCall.hpp"
+
+#include <filesystem>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+/**
+ * What a policy says to do with a tool call.
+ */
+enum class Decision
+{
+    allow, ///< Run without asking.
+    deny, ///< Refuse without asking.
+    ask ///< Ask the user.
+};
+
+/**
+ * One allow/deny/ask rule.
+ *
+ * A rule matches a call when the tool name matches and, if present,
+ * the path prefix or command pattern matches the call's subject.
+ */
+struct PolicyRule
+{
+    Decision decision = Decision::ask;
+    std::string tool; ///< Tool name, or "*" for any tool.
+    std::optional<std::filesystem::path> path_prefix;
+    std::optional<std::string> command_pattern; ///< Shell-style glob.
+    std::string text; ///< The rule as written.
+};
+
+/**
+ * Result of evaluating a policy against one call.
+ */
+struct PolicyVerdict
+{
+    Decision decision = Decision::ask;
+    std::string rule; ///< Text of the matching rule.
+};
+
+/**
+ * Ordered allow/deny/ask rules for tool calls; the first match wins.
+ *
+ * Rules are written as `<allow|deny|ask> <tool|*> [path:<prefix> |
+ * cmd:<glob>]` and separated by semicolons or newlines, e.g.
+ *
+ *     deny bash cmd:*rm -rf*; allow bash cmd:ls*;
+ *     allow write_file path:src/; ask *
+ *
+ * Calls no rule matches fall through to the built-in defaults, which
+ * keep the historical behavior: read_file and read_output (which only
+ * reads stored tool results) are allowed, everything else asks.
+ *
+ * An allow rule with a command pattern never auto-approves a command
+ * that chains or redirects (`;`, `&`, `|`, backquote, `$(`, `<`, `>`,
+ * newline) unless the pattern itself contains such a character, so
+ * `allow bash cmd:ls*` does not allow `ls; rm -rf ~`.
+ */
+class ApprovalPolicy
+{
+public:
+    /**
+     * Parse a rule list.
+     */
+    [[nodiscard]]
+    static Result<ApprovalPolicy> parse(std::string_view spec);
+
+    /**
+     * Find the first rule matching the call.
+     */
+    [[nodiscard]]
+    PolicyVerdict evaluate(ToolCall const & call) const;
+
+    /**
+     * User-configured rules, in evaluation order.
+     */
+    [[nodiscard]]
+    std::vector<PolicyRule> const & rules() const
+    {
+        return rules_;
+    }
+
+private:
+    std::vector<PolicyRule> rules_;
+};
+
+/**
+ * Human-readable description of a call for approval prompts.
+ */
+[[nodiscard]]
+std::string describe_tool_call(ToolCall const & call);
+
+/**
+ * Outcome of reviewing one call.
+ */
+struct Approval
+{
+    bool approved = false;
+    std::string reason; ///< Tool result to send back when not approved.
+};
+
+/**
+ * Applies an ApprovalPolicy to all tool calls of one assistant
+ * message, asking the user once for whatever the policy leaves open,
+ * and records every decision in an optional JSON-lines audit log.
+ */
+class Approver
+{
+public:
+    Approver(
+        ApprovalPolicy policy,
+        std::istream & in,
+        std::ostream & out,
+        std::optional<std::filesystem::path> audit_log = std::nullopt);
+
+    /**
+     * Decide every call.
+     *
+     * The user is prompted at most once: "y" approves all listed
+     * calls, "n" (or anything else) denies them, and a list of numbers
+     * approves just those.
+     *
+     * @return One Approval per call, in order.
+     */
+    [[nodiscard]]
+    std::vector<Approval> review(std::vector<ToolCall> const & calls);
+
+private:
+    void audit(
+        ToolCall const & call,
+        Approval const & approval,
+        std::string_view decided_by,
+        std::string_view rule);
+
+    ApprovalPolicy policy_;
+    std::istream & in_;
+    std::ostream & out_;
+    std::optional<std::filesystem::path> audit_log_;
+};
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_D4E61A0B3C7F48259B6E0A1C8D3F5B72
@@ -0,0 +1,297 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/BlobStore.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+#include "wjh/chat/tools/ContentHash.hpp"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <unistd.h>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+constexpr std::string_view handle_prefix = "out-";
+
+// Longest line shown in a spill summary.
+constexpr std::size_t max_summary_line = 200;
+
+std::vector<std::string_view>
+split_lines(std::string_view text)
+{
+    std::vector<std::string_view> lines;
+    while (not text.empty()) {
+        auto const nl = text.find('\n');
+        lines.push_back(text.substr(0, nl));
+        text = nl == std::string_view::npos
+            ? std::string_view{}
+            : text.substr(nl + 1);
+    }
+    return lines;
+}
+
+bool
+same_content(std::filesystem::path const & path, std::string_view content)
+{
+    std::error_code ec;
+    auto const size = std::filesystem::file_size(path, ec);
+    if (ec or size != content.size()) {
+        return false;
+    }
+    std::ifstream file(path, std::ios::binary);
+    std::string stored(content.size(), '\0');
+    file.read(stored.data(), static_cast<std::streamsize>(stored.size()));
+    return file and stored == content;
+}
+
+void
+append_line(std::string & out, std::string_view line)
+{
+    if (line.size() > max_summary_line) {
+        out.append(line.substr(0, max_summary_line));
+        out += " [...]";
+    } else {
+        out.append(line);
+    }
+    out += '\n';
+}
+
+} // anonymous namespace
+
+Result<OutputRequest>
+parse_output_request(nlohmann::json const & args)
+{
+    try {
+        auto request = OutputRequest{
+            .handle = BlobHandle{args.at("handle").get<std::string>()},
+            .offset = args.value("offset", std::size_t{1}),
+            .limit = args.value("limit", std::size_t{200}),
+            .byte_offset = std::nullopt,
+            .byte_length = args.value("byte_length", std::size_t{8192})};
+        if (args.contains("byte_offset")) {
+            request.byte_offset = args["byte_offset"].get<std::size_t>();
+        }
+        return request;
+    } catch (nlohmann::json::exception const & e) {
+        return make_error("Invalid read_output arguments: {}", e.what());
+    } catch (atlas::ConstraintError const & e) {
+        return make_error("Invalid read_output arguments: {}", e.what());
+    }
+}
+
+BlobStore::
+BlobStore(std::filesystem::path dir)
+: dir_(std::move(dir))
+{ }
+
+Result<BlobHandle>
+BlobStore::
+put(std::string_view content)
+{
+    auto handle = BlobHandle{
+        std::string(handle_prefix) + content_digest(content)};
+    auto const path = dir_ / json_value(handle);
+
+    // The handle is a 64-bit digest, so an existing file is reused only
+    // if it holds the same bytes.
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec)) {
+        if (same_content(path, content)) {
+            return handle;
+        }
+        return make_error("Output handle {} is taken", handle);
+    }
+
+    std::filesystem::create_directories(dir_, ec);
+    if (ec) {
+        return make_error("Cannot create {}: {}", dir_.string(), ec.message());
+    }
+
+    // Write under a temporary name so a partial file is never found.
+    auto const tmp = path.string() + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        if (not out) {
+            std::filesystem::remove(tmp, ec);
+            return make_error("Cannot write {}", tmp);
+        }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        return make_error("Cannot write {}: {}", path.string(), ec.message());
+    }
+    return handle;
+}
+
+Result<std::filesystem::path>
+BlobStore::
+path_of(BlobHandle const & handle) const
+{
+    std::string_view const name = json_value(handle);
+    auto const digest =
+        name.substr(std::min(name.size(), handle_prefix.size()));
+    auto const is_hex = [](char c) {
+        return (c >= '0' and c <= '9') or (c >= 'a' and c <= 'f');
+    };
+    if (not name.starts_with(handle_prefix) or digest.size() != 16
+        or not std::ranges::all_of(digest, is_hex))
+    {
+        return make_error("Unknown output handle: {}", name);
+    }
+    return dir_ / name;
+}
+
+Result<std::string>
+BlobStore::
+read(OutputRequest const & request, std::size_t max_bytes) const
+{
+    auto const path = path_of(request.handle);
+    if (not path) {
+        return make_error("{}", path.error());
+    }
+
+    std::ifstream file(*path, std::ios::binary);
+    if (not file) {
+        return make_error("Unknown output handle: {}", request.handle);
+    }
+    std::string const content(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+
+    if (request.byte_offset) {
+        auto const offset = *request.byte_offset;
+        if (offset >= content.size()) {
+            return make_error(
+                "byte_offset {} is past the end ({} bytes)",
+                offset,
+                content.size());
+        }
+        auto const length = std::min(
+            {request.byte_length, max_bytes, content.size() - offset});
+        auto result = content.substr(offset, length);
+        if (offset + length < content.size()) {
+            result += std::format(
+                "\n[... bytes {}-{} of {}; continue with byte_offset {}]",
+                offset,
+                offset + length,
+                content.size(),
+                offset + length);
+        }
+        return result;
+    }
+
+    auto const lines = split_lines(content);
+    auto const first = std::max(request.offset, std::size_t{1});
+    if (first > lines.size()) {
+        return make_error(
+            "offset {} is past the end ({} lines)",
+            first,
+            lines.size());
+    }
+
+    std::string result;
+    auto const last = std::min(lines.size(), first - 1 + request.limit);
+    for (auto n = first; n <= last; ++n) {
+        auto const line = std::format("{:>6}\t{}\n", n, lines[n - 1]);
+        if (result.size() + line.size() <= max_bytes) {
+            result += line;
+            continue;
+        }
+        if (not result.empty()) {
+            result += std::format(
+                "[... truncated; continue with offset {}]\n",
+                n);
+            return result;
+        }
+
+        // A single line longer than the page: cut it, and say where in
+        // the bytes the rest starts.
+        auto const text = lines[n - 1];
+        auto const start =
+            static_cast<std::size_t>(text.data() - content.data());
+        result = std::format("{:>6}\t", n);
+        auto const room = max_bytes - std::min(max_bytes, result.size());
+        auto const keep = std::min(text.size(), room);
+        result.append(text.substr(0, keep));
+        result += std::format(
+            "\n[... line {} cut after {} of {} bytes; continue with "
+            "byte_offset {}{}]\n",
+            n,
+            keep,
+            text.size(),
+            start + keep,
+            n < lines.size() ? std::format(", or offset {}", n + 1) : "");
+        return result;
+    }
+    if (last < lines.size()) {
+        result += std::format(
+            "[... {} more lines; continue with offset {}]\n",
+            lines.size() - last,
+            last + 1);
+    }
+    return result;
+}
+
+bool
+spill_output(
+    std::string & output,
+    BlobStore & store,
+    SpillOptions const & options)
+{
+    if (options.threshold == 0 or output.size() <= options.threshold) {
+        return false;
+    }
+
+    auto const handle = store.put(output);
+    if (not handle) {
+        return false;
+    }
+
+    auto const lines = split_lines(output);
+    auto const head = std::min(options.head_lines, lines.size());
+    auto const tail = std::min(options.tail_lines, lines.size() - head);
+
+    auto summary = std::format(
+        "[Output too large: {} bytes, {} lines, stored as {}. "
+        "Showing the first {} and last {} lines; use read_output "
+        "with this handle to page through the rest.]\n",
+        output.size(),
+        lines.size(),
+        *handle,
+        head,
+        tail);
+    for (std::size_t i = 0; i < head; ++i) {
+        append_line(summary, lines[i]);
+    }
+    if (head + tail < lines.size()) {
+        summary += std::format(
+            "[... {} lines omitted ...]\n",
+            lines.size() - head - tail);
+    }
+    for (auto i = lines.size() - tail; i < lines.size(); ++i) {
+        append_line(summary, lines[i]);
+    }
+
+    output = std::move(summary);
+    return true;
+}
+
+std::filesystem::path
+default_blob_dir()
+{
+    return std::filesystem::temp_directory_path()
+        / std::format("wjh_chat_outputs_{}", getpid());
+}
+
+} // namespace wjh::chat::tools
@@ -0,0 +1,120 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_A2F7C90E5B1D4E68934C0B8D7E6A1F52
+#define WJH_CHAT_A2F7C90E5B1D4E68934C0B8D7E6A1F52
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/tools/types.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::tools {
+
+/**
+ * When and how much of a large tool result goes into the message.
+ */
+struct SpillOptions
+{
+    std::size_t threshold = 16 * 1024; ///< Spill above this; 0 = never.
+    std::size_t head_lines = 40;
+    std::size_t tail_lines = 20;
+};
+
+/**
+ * Arguments of one `read_output` tool call.
+ *
+ * Without a byte offset, lines [offset, offset + limit) are returned
+ * with line numbers, like read_file.
+ */
+struct OutputRequest
+{
+    BlobHandle handle;
+    std::size_t offset = 1; ///< First line, 1-based.
+    std::size_t limit = 200; ///< Maximum lines.
+    std::optional<std::size_t> byte_offset;
+    std::size_t byte_length = 8192;
+};
+
+/**
+ * Parse `read_output` tool arguments.
+ */
+[[nodiscard]]
+Result<OutputRequest> parse_output_request(nlohmann::json const & args);
+
+/**
+ * Content-addressed store for tool outputs of one session.
+ *
+ * Each output is written once to a file named by the hash of its
+ * content, so storing the same output twice yields the same handle.
+ * Storing different output whose hash names an existing file fails
+ * rather than hand out the other output.
+ */
+class BlobStore
+{
+public:
+    /**
+     * @param dir Directory for stored outputs (created on demand).
+     */
+    explicit BlobStore(std::filesystem::path dir);
+
+    /**
+     * Store content and return its handle.
+     */
+    [[nodiscard]]
+    Result<BlobHandle> put(std::string_view content);
+
+    /**
+     * Read the requested range of a stored output, returning at most
+     * max_bytes of text and saying where to continue if cut short.  A
+     * line longer than max_bytes is cut, pointing at the byte_offset
+     * of the rest.
+     */
+    [[nodiscard]]
+    Result<std::string> read(
+        OutputRequest const & request,
+        std::size_t max_bytes) const;
+
+    [[nodiscard]]
+    std::filesystem::path const & dir() const
+    {
+        return dir_;
+    }
+
+private:
+    [[nodiscard]]
+    Result<std::filesystem::path> path_of(BlobHandle const & handle) const;
+
+    std::filesystem::path dir_;
+};
+
+/**
+ * If output is larger than the threshold, store it and replace it
+ * with its first and last lines plus the handle to page through the
+ * rest with read_output.  Leaves output alone if storing fails.
+ *
+ * @return Whether output was replaced.
+ */
+bool spill_output(
+    std::string & output,
+    BlobStore & store,
+    SpillOptions const & options);
+
+/**
+ * Per-process store directory under the system temp directory.
+ */
+[[nodiscard]]
+std::filesystem::path default_blob_dir();
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_A2F7C90E5B1D4E68934C0B8D7E6A1F52
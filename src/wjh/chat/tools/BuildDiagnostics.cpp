@@ -0,0 +1,431 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/BuildDiagnostics.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <unordered_map>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+constexpr auto npos = std::string_view::npos;
+
+std::string_view
+trim(std::string_view s)
+{
+    auto const first = s.find_first_not_of(" \t\r");
+    if (first == npos) {
+        return {};
+    }
+    auto const last = s.find_last_not_of(" \t\r");
+    return s.substr(first, last - first + 1);
+}
+
+std::vector<std::string_view>
+split_lines(std::string_view text)
+{
+    std::vector<std::string_view> lines;
+    while (not text.empty()) {
+        auto const eol = text.find('\n');
+        auto line = text.substr(0, eol);
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+        lines.push_back(line);
+        if (eol == npos) {
+            break;
+        }
+        text.remove_prefix(eol + 1);
+    }
+    return lines;
+}
+
+bool
+is_digits(std::string_view s)
+{
+    return not s.empty()
+        and std::ranges::all_of(s, [](char c) { return c >= '0' and c <= '9'; });
+}
+
+std::optional<std::size_t>
+parse_count(std::string_view s)
+{
+    std::size_t value = 0;
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (ec != std::errc{} or ptr == s.data()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// "path:line" or "path:line:col"
+bool
+is_source_location(std::string_view s)
+{
+    auto const colon = s.rfind(':');
+    if (colon == npos or not is_digits(s.substr(colon + 1))) {
+        return false;
+    }
+    auto head = s.substr(0, colon);
+    auto const colon2 = head.rfind(':');
+    if (colon2 != npos and is_digits(head.substr(colon2 + 1))) {
+        head = head.substr(0, colon2);
+    }
+    return not head.empty();
+}
+
+// "clang++", "collect2", "/usr/bin/ld", "ld.lld", ...
+bool
+is_tool_name(std::string_view s)
+{
+    return not s.empty() and s.find_first_of(" \t:") == npos;
+}
+
+struct Marker
+{
+    std::string_view text;
+    std::optional<Severity> severity; ///< nullopt for notes.
+};
+
+constexpr std::array<Marker, 6> markers{{
+    {": fatal error: ", Severity::error},
+    {": error: ", Severity::error},
+    {": ERROR: ", Severity::error}, // doctest
+    {": warning: ", Severity::warning},
+    {": WARNING: ", Severity::warning}, // doctest
+    {": note: ", std::nullopt},
+}};
+
+struct DiagnosticLine
+{
+    std::optional<Severity> severity;
+    std::string_view location;
+    std::string_view message;
+};
+
+std::optional<DiagnosticLine>
+split_diagnostic_line(std::string_view line)
+{
+    auto best = npos;
+    Marker const * found = nullptr;
+    for (auto const & marker : markers) {
+        auto const pos = line.find(marker.text);
+        if (pos < best) {
+            best = pos;
+            found = &marker;
+        }
+    }
+    if (found == nullptr) {
+        return std::nullopt;
+    }
+
+    auto const location = line.substr(0, best);
+    if (not is_source_location(location) and not is_tool_name(location)) {
+        return std::nullopt;
+    }
+    return DiagnosticLine{
+        .severity = found->severity,
+        .location = location,
+        .message = trim(line.substr(best + found->text.size()))};
+}
+
+/**
+ * Accumulates diagnostics, folding duplicates and attaching notes to
+ * the diagnostic they follow.
+ */
+class Collector
+{
+public:
+    void add(
+        Severity severity,
+        std::string_view location,
+        std::string_view message)
+    {
+        auto key = std::format(
+            "{}\x1f{}\x1f{}",
+            severity == Severity::error ? 'E' : 'W',
+            location,
+            message);
+        auto [it, inserted] =
+            index_.try_emplace(std::move(key), diagnostics_.size());
+        if (inserted) {
+            diagnostics_.push_back(Diagnostic{
+                .severity = severity,
+                .location = std::string(location),
+                .message = std::string(message),
+                .notes = {},
+                .occurrences = 1});
+            attach_ = it->second;
+        } else {
+            // Notes after a repeat are repeats too.
+            ++diagnostics_[it->second].occurrences;
+            attach_.reset();
+        }
+    }
+
+    void add_note(std::string_view location, std::string_view message)
+    {
+        if (not attach_) {
+            return;
+        }
+        auto & notes = diagnostics_[*attach_].notes;
+        if (location.empty()) {
+            notes.emplace_back(message);
+        } else {
+            notes.push_back(std::format("{}: {}", location, message));
+        }
+    }
+
+    void detach() { attach_.reset(); }
+
+    [[nodiscard]]
+    std::vector<Diagnostic> take() &&
+    {
+        return std::move(diagnostics_);
+    }
+
+private:
+    std::vector<Diagnostic> diagnostics_;
+    std::unordered_map<std::string, std::size_t> index_;
+    std::optional<std::size_t> attach_;
+};
+
+// Consumes a "CMake Error at file:line (cmd):" block whose message
+// is the following indented paragraph.  Returns the index of the
+// first line after the block.
+std::size_t
+parse_cmake_message(
+    std::vector<std::string_view> const & lines,
+    std::size_t i,
+    Collector & collector)
+{
+    auto const line = lines[i];
+    auto const severity = line.starts_with("CMake Error")
+        ? Severity::error
+        : Severity::warning;
+
+    std::string_view location;
+    std::string message;
+    if (auto const at = line.find(" at "); at != npos) {
+        location = line.substr(at + 4);
+        location = location.substr(0, location.find(" ("));
+        if (location.ends_with(':')) {
+            location.remove_suffix(1);
+        }
+    } else if (auto const colon = line.find(": "); colon != npos) {
+        message = trim(line.substr(colon + 2));
+    }
+
+    ++i;
+    for (; i < lines.size(); ++i) {
+        if (not lines[i].empty() and not lines[i].starts_with("  ")) {
+            break;
+        }
+        if (auto const text = trim(lines[i]); not text.empty()) {
+            if (not message.empty()) {
+                message += ' ';
+            }
+            message += text;
+        }
+    }
+
+    collector.add(severity, location, message);
+    return i;
+}
+
+} // anonymous namespace
+
+std::vector<Diagnostic>
+parse_diagnostics(std::string_view log)
+{
+    Collector collector;
+    auto const lines = split_lines(log);
+
+    for (std::size_t i = 0; i < lines.size();) {
+        auto const line = lines[i];
+
+        if (line.starts_with("CMake Error") or line.starts_with("CMake Warning"))
+        {
+            i = parse_cmake_message(lines, i, collector);
+            continue;
+        }
+        ++i;
+
+        if (auto const pos = line.find("undefined reference to ");
+            pos != npos)
+        {
+            collector.add(Severity::error, {}, trim(line.substr(pos)));
+            continue;
+        }
+        if (auto const pos = line.find("multiple definition of ");
+            pos != npos)
+        {
+            collector.add(Severity::error, {}, trim(line.substr(pos)));
+            continue;
+        }
+
+        // doctest prints the expanded operands on the next line.
+        if (line.starts_with("  values: ")) {
+            collector.add_note({}, trim(line));
+            continue;
+        }
+
+        auto const parsed = split_diagnostic_line(line);
+        if (not parsed) {
+            continue;
+        }
+        if (parsed->severity) {
+            collector.add(*parsed->severity, parsed->location, parsed->message);
+        } else {
+            collector.add_note(parsed->location, parsed->message);
+        }
+    }
+
+    return std::move(collector).take();
+}
+
+std::optional<TestSummary>
+parse_test_summary(std::string_view log)
+{
+    std::optional<TestSummary> summary;
+    std::vector<std::string> failed_tests;
+    bool in_failed_list = false;
+
+    for (auto const line : split_lines(log)) {
+        if (in_failed_list) {
+            // "\t  3 - Chat Tests (Failed)"
+            auto const text = trim(line);
+            auto const dash = text.find(" - ");
+            if (dash != npos and is_digits(text.substr(0, dash))) {
+                failed_tests.emplace_back(text.substr(dash + 3));
+                continue;
+            }
+            in_failed_list = false;
+        }
+
+        if (line.starts_with("The following tests FAILED:")) {
+            in_failed_list = true;
+            continue;
+        }
+
+        if (line.starts_with("No tests were found")) {
+            summary = TestSummary{};
+            continue;
+        }
+
+        // "90% tests passed, 1 tests failed out of 10"
+        static constexpr std::string_view passed = "% tests passed, ";
+        static constexpr std::string_view out_of = " tests failed out of ";
+        auto const p = line.find(passed);
+        if (p == npos) {
+            continue;
+        }
+        auto const rest = line.substr(p + passed.size());
+        auto const o = rest.find(out_of);
+        if (o == npos) {
+            continue;
+        }
+        auto const failed = parse_count(rest.substr(0, o));
+        auto const total = parse_count(rest.substr(o + out_of.size()));
+        if (failed and total) {
+            summary = TestSummary{
+                .total = *total,
+                .failed = *failed,
+                .failed_tests = {}};
+        }
+    }
+
+    if (summary) {
+        summary->failed_tests = std::move(failed_tests);
+    }
+    return summary;
+}
+
+std::string
+format_diagnostics(
+    std::vector<Diagnostic> const & diagnostics,
+    ReportLimits const & limits)
+{
+    if (diagnostics.empty()) {
+        return "No diagnostics.\n";
+    }
+
+    auto const errors = static_cast<std::size_t>(std::ranges::count(
+        diagnostics, Severity::error, &Diagnostic::severity));
+    auto const warnings = diagnostics.size() - errors;
+    auto result = std::format(
+        "{} error{}, {} warning{}\n",
+        errors,
+        errors == 1 ? "" : "s",
+        warnings,
+        warnings == 1 ? "" : "s");
+
+    std::size_t shown = 0;
+    for (auto const severity : {Severity::error, Severity::warning}) {
+        for (auto const & d : diagnostics) {
+            if (d.severity != severity or shown == limits.max_diagnostics) {
+                continue;
+            }
+            ++shown;
+
+            result += severity == Severity::error ? "error: " : "warning: ";
+            if (not d.location.empty()) {
+                result += d.location;
+                result += ": ";
+            }
+            result += d.message;
+            if (d.occurrences > 1) {
+                result += std::format(" [x{}]", d.occurrences);
+            }
+            result += '\n';
+
+            auto const notes = std::min(d.notes.size(), limits.max_notes);
+            for (std::size_t i = 0; i < notes; ++i) {
+                result += "  note: ";
+                result += d.notes[i];
+                result += '\n';
+            }
+            if (d.notes.size() > notes) {
+                result += std::format(
+                    "  ... {} more notes\n",
+                    d.notes.size() - notes);
+            }
+        }
+    }
+
+    if (shown < diagnostics.size()) {
+        result += std::format(
+            "... {} more diagnostics not shown\n",
+            diagnostics.size() - shown);
+    }
+    return result;
+}
+
+std::string
+format_test_summary(TestSummary const & summary)
+{
+    if (summary.total == 0) {
+        return "Tests: none found\n";
+    }
+
+    auto result = std::format(
+        "Tests: {}/{} passed\n",
+        summary.total - summary.failed,
+        summary.total);
+    for (auto const & name : summary.failed_tests) {
+        result += "  FAILED: ";
+        result += name;
+        result += '\n';
+    }
+    return result;
+}
+
+} // namespace wjh::chat::tools
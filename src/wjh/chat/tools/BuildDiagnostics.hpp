@@ -0,0 +1,99 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_3C1F0E8A5B7D4E2F9A6B8C0D1E2F3A4B
+#define WJH_CHAT_3C1F0E8A5B7D4E2F9A6B8C0D1E2F3A4B
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+/**
+ * Severity of a top-level build diagnostic.
+ *
+ * Notes are not diagnostics in their own right; they are attached to
+ * the error or warning that precedes them.
+ */
+enum class Severity
+{
+    warning,
+    error
+};
+
+/**
+ * One deduplicated compiler, linker, CMake, or test diagnostic.
+ */
+struct Diagnostic
+{
+    Severity severity = Severity::error;
+    std::string location; ///< "file:line[:col]", tool name, or empty.
+    std::string message;
+    std::vector<std::string> notes; ///< "location: message" of each note.
+    std::size_t occurrences = 1; ///< Times seen (e.g., once per TU).
+
+    friend bool operator == (Diagnostic const &, Diagnostic const &) = default;
+};
+
+/**
+ * Outcome of a ctest run, as reported in its summary.
+ */
+struct TestSummary
+{
+    std::size_t total = 0;
+    std::size_t failed = 0;
+    std::vector<std::string> failed_tests;
+};
+
+/**
+ * How much of a parsed build to show the model.
+ */
+struct ReportLimits
+{
+    std::size_t max_diagnostics = 20;
+    std::size_t max_notes = 3;
+};
+
+/**
+ * Extract diagnostics from GCC, Clang, linker, CMake, and doctest
+ * output.
+ *
+ * Diagnostics are returned in first-seen order; repeats (the same
+ * header error reported by every TU that includes it) are folded into
+ * a single entry with an occurrence count.
+ */
+[[nodiscard]]
+std::vector<Diagnostic> parse_diagnostics(std::string_view log);
+
+/**
+ * Extract the summary from ctest output.
+ *
+ * @return The summary, or nullopt if the log contains no ctest summary.
+ */
+[[nodiscard]]
+std::optional<TestSummary> parse_test_summary(std::string_view log);
+
+/**
+ * Render diagnostics compactly: errors first, then warnings, each
+ * with at most limits.max_notes notes.
+ */
+[[nodiscard]]
+std::string format_diagnostics(
+    std::vector<Diagnostic> const & diagnostics,
+    ReportLimits const & limits);
+
+/**
+ * Render a test summary as a short pass/fail line plus failed names.
+ */
+[[nodiscard]]
+std::string format_test_summary(TestSummary const & summary);
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_3C1F0E8A5B7D4E2F9A6B8C0D1E2F3A4B
@@ -0,0 +1,221 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/BuildTool.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+#include "wjh/chat/tools/ProcessRunner.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <string_view>
+
+#include <unistd.h>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+bool
+succeeded(Result<ProcessResult> const & result)
+{
+    return result and result->exit_status == ExitStatus{0};
+}
+
+// What `cmake --build --preset` prints when the preset's binary
+// directory has not been configured yet.
+bool
+needs_configure(Result<ProcessResult> const & result)
+{
+    return result
+        and (result->output.find("could not load cache") != std::string::npos
+             or result->output.find("is not a directory") != std::string::npos);
+}
+
+// A report limit must be a whole number no less than zero; reading a
+// negative number straight into a size_t would wrap it to a huge value
+// and switch the limit off.
+Result<std::size_t>
+limit_argument(
+    nlohmann::json const & args,
+    char const * key,
+    std::size_t fallback)
+{
+    auto const found = args.find(key);
+    if (found == args.end()) {
+        return fallback;
+    }
+    if (not found->is_number_integer()
+        or (not found->is_number_unsigned()
+            and found->get<std::int64_t>() < 0))
+    {
+        return make_error("{} must be a non-negative integer", key);
+    }
+    return found->get<std::size_t>();
+}
+
+} // anonymous namespace
+
+Result<BuildRequest>
+parse_build_request(nlohmann::json const & args)
+{
+    try {
+        auto preset = BuildPreset{args.value("preset", std::string{"debug"})};
+
+        std::optional<std::string> target;
+        if (args.contains("target")) {
+            target = args["target"].get<std::string>();
+        }
+
+        std::optional<std::string> test_filter;
+        if (args.contains("test_filter")) {
+            test_filter = args["test_filter"].get<std::string>();
+        }
+
+        auto limits = ReportLimits{};
+        auto const max_diagnostics = limit_argument(
+            args,
+            "max_diagnostics",
+            limits.max_diagnostics);
+        if (not max_diagnostics) {
+            return make_error(
+                "Invalid build arguments: {}",
+                max_diagnostics.error());
+        }
+        auto const max_notes =
+            limit_argument(args, "max_notes", limits.max_notes);
+        if (not max_notes) {
+            return make_error("Invalid build arguments: {}", max_notes.error());
+        }
+        limits.max_diagnostics = *max_diagnostics;
+        limits.max_notes = *max_notes;
+
+        return BuildRequest{
+            .preset = std::move(preset),
+            .target = std::move(target),
+            .test_filter = std::move(test_filter),
+            .configure = args.value("configure", false),
+            .run_tests = args.value("run_tests", true),
+            .limits = limits};
+    } catch (nlohmann::json::exception const & e) {
+        return make_error("Invalid build arguments: {}", e.what());
+    } catch (atlas::ConstraintError const & e) {
+        return make_error("Invalid build arguments: {}", e.what());
+    }
+}
+
+BuildTool::
+BuildTool(std::filesystem::path log_dir, ResourceLimits limits)
+: log_dir_(std::move(log_dir))
+, limits_(std::move(limits))
+{ }
+
+std::string
+BuildTool::
+run(BuildRequest const & request)
+{
+    std::string log;
+    std::string limit_note;
+    auto run_phase = [this, &log, &limit_note](std::string command) {
+        log += std::format("$ {}\n", command);
+        auto result = run_process(ShellCommand{std::move(command)}, limits_);
+        if (result) {
+            log += result->output;
+            if (result->limit_hit != LimitHit::none) {
+                limit_note = describe_limit(result->limit_hit, limits_);
+                log += std::format("\n{}\n", limit_note);
+            } else if (result->possible_limit != LimitHit::none) {
+                limit_note =
+                    describe_possible_limit(result->possible_limit, limits_);
+                log += std::format("\n{}\n", limit_note);
+            }
+            log += std::format(
+                "[exit code: {}]\n",
+                json_value(result->exit_status));
+        } else {
+            log += std::format("Error: {}\n", result.error());
+        }
+        return result;
+    };
+
+    auto const preset = shell_quote(json_value(request.preset));
+    auto const configure_cmd = "cmake --preset " + preset;
+    auto build_cmd = "cmake --build --preset " + preset;
+    if (request.target) {
+        build_cmd += " --target " + shell_quote(*request.target);
+    }
+
+    std::string_view failed_phase;
+    if (request.configure and not succeeded(run_phase(configure_cmd))) {
+        failed_phase = "Configure";
+    }
+
+    if (failed_phase.empty()) {
+        auto build = run_phase(build_cmd);
+        if (not request.configure and needs_configure(build)) {
+            if (succeeded(run_phase(configure_cmd))) {
+                build = run_phase(build_cmd);
+            } else {
+                failed_phase = "Configure";
+            }
+        }
+        if (failed_phase.empty() and not succeeded(build)) {
+            failed_phase = "Build";
+        }
+    }
+
+    std::optional<TestSummary> tests;
+    if (failed_phase.empty() and request.run_tests) {
+        auto test_cmd = "ctest --preset " + preset + " --output-on-failure";
+        if (request.test_filter) {
+            test_cmd += " -R " + shell_quote(*request.test_filter);
+        }
+        auto test = run_phase(test_cmd);
+        if (test) {
+            tests = parse_test_summary(test->output);
+        }
+        if (not succeeded(test)) {
+            failed_phase = "Test";
+        }
+    }
+
+    auto summary = failed_phase.empty()
+        ? std::format("Build succeeded (preset {})\n", request.preset)
+        : std::format("{} FAILED (preset {})\n", failed_phase, request.preset);
+    if (not limit_note.empty()) {
+        summary += limit_note + "\n";
+    }
+    summary += format_diagnostics(parse_diagnostics(log), request.limits);
+    if (tests) {
+        summary += format_test_summary(*tests);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(log_dir_, ec);
+    auto const path = log_dir_ / std::format("build-{}.log", ++runs_);
+    std::ofstream out(path);
+    out << log;
+    if (ec or not out) {
+        summary += "Full log could not be saved.\n";
+    } else {
+        summary += std::format(
+            "Full log ({} lines): {} (page with read_file offset/limit)\n",
+            std::ranges::count(log, '\n'),
+            path.string());
+    }
+    return summary;
+}
+
+std::filesystem::path
+default_build_log_dir()
+{
+    return std::filesystem::temp_directory_path()
+        / std::format("wjh_chat_build_logs_{}", getpid());
+}
+
+} // namespace wjh::chat::tools
@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_8F2B6D14C39A4E7B8D05A1F6C2E9B370
+#define WJH_CHAT_8F2B6D14C39A4E7B8D05A1F6C2E9B370
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/tools/BuildDiagnostics.hpp"
+#include "wjh/chat/tools/ResourceLimits.hpp"
+#include "wjh/chat/tools/types.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace wjh::chat::tools {
+
+/**
+ * Arguments of one `build` tool call.
+ */
+struct BuildRequest
+{
+    BuildPreset preset;
+    std::optional<std::string> target;
+    std::optional<std::string> test_filter; ///< ctest -R regex.
+    bool configure = false; ///< Run `cmake --preset` first.
+    bool run_tests = true;
+    ReportLimits limits;
+};
+
+/**
+ * Parse `build` tool arguments, applying defaults for omitted fields.
+ */
+[[nodiscard]]
+Result<BuildRequest> parse_build_request(nlohmann::json const & args);
+
+/**
+ * Builds and tests the project through its CMake presets and reports
+ * a compact summary instead of the raw compiler output.
+ *
+ * The full log of every run is kept on disk; the summary names the
+ * file so the model can page through it with read_file.
+ */
+class BuildTool
+{
+public:
+    /**
+     * @param log_dir Directory for full build logs (created on demand).
+     * @param limits Limits applied to each cmake/ctest invocation.
+     */
+    explicit BuildTool(
+        std::filesystem::path log_dir,
+        ResourceLimits limits = {});
+
+    /**
+     * Configure (if asked or needed), build, and optionally test.
+     *
+     * @return Summary text for the tool result message.
+     */
+    [[nodiscard]]
+    std::string run(BuildRequest const & request);
+
+    [[nodiscard]]
+    std::filesystem::path const & log_dir() const
+    {
+        return log_dir_;
+    }
+
+private:
+    std::filesystem::path log_dir_;
+    ResourceLimits limits_;
+    unsigned runs_ = 0;
+};
+
+/**
+ * Per-process log directory under the system temp directory.
+ */
+[[nodiscard]]
+std::filesystem::path default_build_log_dir();
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_8F2B6D14C39A4E7B8D05A1F6C2E9B370
@@ -0,0 +1,47 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_6E0B3D8F41A7429C85D2F9E1C4B7A063
+#define WJH_CHAT_6E0B3D8F41A7429C85D2F9E1C4B7A063
+
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::tools {
+
+/**
+ * 64-bit FNV-1a hash of text.
+ *
+ * Stable across runs and platforms, so it can name files on disk; not
+ * meant to resist deliberate collisions.  Passing the hash of earlier
+ * text as `hash` continues it, giving the hash of the concatenation.
+ */
+[[nodiscard]]
+constexpr std::uint64_t
+content_hash(std::string_view text, std::uint64_t hash = 0xcbf29ce484222325u)
+{
+    for (auto const c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3u;
+    }
+    return hash;
+}
+
+/**
+ * content_hash as 16 lowercase hex digits.
+ */
+[[nodiscard]]
+inline std::string
+content_digest(std::string_view text)
+{
+    return std::format("{:016x}", content_hash(text));
+}
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_6E0B3D8F41A7429C85D2F9E1C4B7A063
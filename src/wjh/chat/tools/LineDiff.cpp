@@ -0,0 +1,218 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/LineDiff.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+enum class Op : std::uint8_t
+{
+    keep,
+    remove,
+    add
+};
+
+using Lines = std::span<std::string const>;
+
+// Shortest edit script from a to b, or nullopt if it needs more than
+// max_d edits.  Keeps one copy of the V array per step for the
+// backtrack, so memory is O(max_d^2).
+std::optional<std::vector<Op>>
+edit_script(Lines a, Lines b, std::size_t max_d)
+{
+    auto const n = static_cast<std::ptrdiff_t>(a.size());
+    auto const m = static_cast<std::ptrdiff_t>(b.size());
+    auto const limit = static_cast<std::ptrdiff_t>(
+        std::min(max_d, a.size() + b.size()));
+
+    // v[k + offset] is the furthest x reached on diagonal k.
+    auto const offset = limit + 1;
+    std::vector<std::ptrdiff_t> v(static_cast<std::size_t>(2 * limit + 3));
+    auto const at = [offset](std::vector<std::ptrdiff_t> & vec,
+                             std::ptrdiff_t k) -> std::ptrdiff_t & {
+        return vec[static_cast<std::size_t>(k + offset)];
+    };
+    std::vector<std::vector<std::ptrdiff_t>> trace;
+
+    auto const from_above = [&at](
+                                std::vector<std::ptrdiff_t> & vec,
+                                std::ptrdiff_t k,
+                                std::ptrdiff_t d) {
+        return k == -d or (k != d and at(vec, k - 1) < at(vec, k + 1));
+    };
+
+    for (std::ptrdiff_t d = 0; d <= limit; ++d) {
+        trace.push_back(v);
+        for (auto k = -d; k <= d; k += 2) {
+            auto x = from_above(v, k, d) ? at(v, k + 1) : at(v, k - 1) + 1;
+            auto y = x - k;
+            while (x < n and y < m
+                   and a[static_cast<std::size_t>(x)]
+                       == b[static_cast<std::size_t>(y)])
+            {
+                ++x;
+                ++y;
+            }
+            at(v, k) = x;
+            if (x < n or y < m) {
+                continue;
+            }
+
+            // Walk back through the saved steps.
+            std::vector<Op> ops;
+            for (auto step = d; step >= 0; --step) {
+                auto & prev = trace[static_cast<std::size_t>(step)];
+                auto const kk = x - y;
+                auto const prev_k = from_above(prev, kk, step) ? kk + 1
+                                                               : kk - 1;
+                auto const prev_x = at(prev, prev_k);
+                auto const prev_y = prev_x - prev_k;
+                while (x > prev_x and y > prev_y) {
+                    ops.push_back(Op::keep);
+                    --x;
+                    --y;
+                }
+                if (step > 0) {
+                    ops.push_back(x == prev_x ? Op::add : Op::remove);
+                }
+                x = prev_x;
+                y = prev_y;
+            }
+            std::ranges::reverse(ops);
+            return ops;
+        }
+    }
+    return std::nullopt;
+}
+
+// Lines of before (or after) that an operation accounts for.
+std::size_t
+uses_before(Op op)
+{
+    return op == Op::add ? 0u : 1u;
+}
+
+std::size_t
+uses_after(Op op)
+{
+    return op == Op::remove ? 0u : 1u;
+}
+
+struct Hunk
+{
+    std::size_t first_op;
+    std::size_t last_op; ///< One past the end.
+};
+
+} // anonymous namespace
+
+std::optional<std::string>
+unified_diff(Lines before, Lines after, DiffOptions const & options)
+{
+    // Common prefix and suffix never need the quadratic search.
+    std::size_t prefix = 0;
+    while (prefix < before.size() and prefix < after.size()
+           and before[prefix] == after[prefix])
+    {
+        ++prefix;
+    }
+    std::size_t suffix = 0;
+    while (suffix < before.size() - prefix
+           and suffix < after.size() - prefix
+           and before[before.size() - 1 - suffix]
+               == after[after.size() - 1 - suffix])
+    {
+        ++suffix;
+    }
+    if (prefix == before.size() and prefix == after.size()) {
+        return std::string{};
+    }
+
+    auto middle = edit_script(
+        before.subspan(prefix, before.size() - prefix - suffix),
+        after.subspan(prefix, after.size() - prefix - suffix),
+        options.max_changes);
+    if (not middle) {
+        return std::nullopt;
+    }
+
+    std::vector<Op> ops(prefix, Op::keep);
+    ops.insert(ops.end(), middle->begin(), middle->end());
+    ops.insert(ops.end(), suffix, Op::keep);
+
+    // Group changes whose context would overlap into one hunk.
+    std::vector<Hunk> hunks;
+    for (std::size_t i = 0; i < ops.size(); ++i) {
+        if (ops[i] == Op::keep) {
+            continue;
+        }
+        auto const first = i > options.context ? i - options.context : 0;
+        auto j = i;
+        while (j < ops.size() and ops[j] != Op::keep) {
+            ++j;
+        }
+        auto const last = std::min(ops.size(), j + options.context);
+        if (not hunks.empty() and first <= hunks.back().last_op) {
+            hunks.back().last_op = last;
+        } else {
+            hunks.push_back(Hunk{.first_op = first, .last_op = last});
+        }
+        i = j - 1;
+    }
+
+    std::string out;
+    std::size_t op = 0;
+    std::size_t a = 0;
+    std::size_t b = 0;
+    for (auto const & hunk : hunks) {
+        for (; op < hunk.first_op; ++op) {
+            a += uses_before(ops[op]);
+            b += uses_after(ops[op]);
+        }
+        std::size_t a_count = 0;
+        std::size_t b_count = 0;
+        for (auto i = hunk.first_op; i < hunk.last_op; ++i) {
+            a_count += uses_before(ops[i]);
+            b_count += uses_after(ops[i]);
+        }
+        // An empty side names the line before the change, as diff -u
+        // does.
+        out += std::format(
+            "@@ -{},{} +{},{} @@\n",
+            a + options.first_line - (a_count == 0 ? 1u : 0u),
+            a_count,
+            b + options.first_line - (b_count == 0 ? 1u : 0u),
+            b_count);
+        for (; op < hunk.last_op; ++op) {
+            switch (ops[op]) {
+            case Op::keep:
+                out += ' ';
+                out += before[a++];
+                ++b;
+                break;
+            case Op::remove:
+                out += '-';
+                out += before[a++];
+                break;
+            case Op::add:
+                out += '+';
+                out += after[b++];
+                break;
+            }
+            out += '\n';
+        }
+    }
+    return out;
+}
+
+} // namespace wjh::chat::tools
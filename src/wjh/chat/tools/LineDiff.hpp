@@ -0,0 +1,45 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_95C1E8A04F7B4D3A8E62B0D9C71F5A28
+#define WJH_CHAT_95C1E8A04F7B4D3A8E62B0D9C71F5A28
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace wjh::chat::tools {
+
+/**
+ * Shape of a unified diff.
+ */
+struct DiffOptions
+{
+    std::size_t context = 3; ///< Unchanged lines around each change.
+    std::size_t max_changes = 400; ///< Give up above this many edits.
+    std::size_t first_line = 1; ///< Number of the first line of both.
+};
+
+/**
+ * Unified diff (hunks only, no file header) turning before into after.
+ *
+ * Uses Myers' algorithm after trimming the common prefix and suffix,
+ * so the cost grows with the number of changed lines rather than with
+ * the file size.
+ *
+ * @return Empty if the sequences are equal, std::nullopt if more than
+ * max_changes lines were added or removed.
+ */
+[[nodiscard]]
+std::optional<std::string> unified_diff(
+    std::span<std::string const> before,
+    std::span<std::string const> after,
+    DiffOptions const & options = {});
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_95C1E8A04F7B4D3A8E62B0D9C71F5A28
@@ -0,0 +1,290 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/OutputCompactor.hpp"
+
+#include <algorithm>
+#include <format>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+constexpr auto npos = std::string_view::npos;
+
+bool
+in_range(char c, char lo, char hi)
+{
+    return c >= lo and c <= hi;
+}
+
+// Removes CSI (colors, cursor motion), OSC (titles, hyperlinks), and
+// the short ESC sequences terminals use for charset selection.
+std::string
+strip_ansi(std::string_view in)
+{
+    std::string out;
+    out.reserve(in.size());
+
+    std::size_t i = 0;
+    while (i < in.size()) {
+        auto const esc = in.find('\x1B', i);
+        if (esc == npos) {
+            out.append(in.substr(i));
+            break;
+        }
+        out.append(in.substr(i, esc - i));
+        i = esc + 1;
+        if (i == in.size()) {
+            break;
+        }
+
+        auto const kind = in[i++];
+        if (kind == '[') {
+            while (i < in.size() and in_range(in[i], '\x20', '\x3F')) {
+                ++i;
+            }
+            if (i < in.size() and in_range(in[i], '\x40', '\x7E')) {
+                ++i;
+            }
+        } else if (kind == ']') {
+            while (i < in.size()) {
+                if (in[i] == '\a') {
+                    ++i;
+                    break;
+                }
+                if (in[i] == '\x1B' and i + 1 < in.size()
+                    and in[i + 1] == '\\')
+                {
+                    i += 2;
+                    break;
+                }
+                ++i;
+            }
+        } else if (in_range(kind, '(', '+') and i < in.size()) {
+            ++i;
+        }
+    }
+    return out;
+}
+
+// What a terminal shows for a line redrawn with \r and \b.
+std::string
+resolve_overwrites(std::string_view line)
+{
+    std::string out;
+    std::size_t col = 0;
+    for (auto const c : line) {
+        if (c == '\r') {
+            col = 0;
+        } else if (c == '\b') {
+            if (col > 0) {
+                --col;
+            }
+        } else if (col < out.size()) {
+            out[col++] = c;
+        } else {
+            out += c;
+            ++col;
+        }
+    }
+    return out;
+}
+
+// The line with every run of digits replaced by '#'.
+std::string
+similarity_key(std::string_view line)
+{
+    std::string key;
+    key.reserve(line.size());
+    for (std::size_t i = 0; i < line.size(); ++i) {
+        if (in_range(line[i], '0', '9')) {
+            if (key.empty() or key.back() != '#') {
+                key += '#';
+            }
+        } else {
+            key += line[i];
+        }
+    }
+    return key;
+}
+
+bool
+blank(std::string_view line)
+{
+    return line.find_first_not_of(" \t") == npos;
+}
+
+// Bytes taken by lines [first, last) including their newlines.
+std::size_t
+total_size(
+    std::vector<std::string> const & lines,
+    std::size_t first,
+    std::size_t last)
+{
+    std::size_t n = 0;
+    for (auto i = first; i < last; ++i) {
+        n += lines[i].size() + 1;
+    }
+    return n;
+}
+
+std::vector<std::string>
+fold_runs(std::vector<std::string> lines, CompactOptions const & options)
+{
+    std::vector<std::string> keys;
+    if (options.fold_similar) {
+        keys.reserve(lines.size());
+        for (auto const & line : lines) {
+            keys.push_back(similarity_key(line));
+        }
+    }
+
+    std::vector<std::string> out;
+    out.reserve(lines.size());
+
+    std::size_t i = 0;
+    while (i < lines.size()) {
+        if (blank(lines[i])) {
+            out.push_back(std::move(lines[i++]));
+            continue;
+        }
+
+        auto j = i + 1;
+        while (j < lines.size() and lines[j] == lines[i]) {
+            ++j;
+        }
+        if (options.fold_repeats and j - i >= options.min_repeats) {
+            auto note = std::format(
+                "[previous line repeated {} more times]",
+                j - i - 1);
+            auto const folded = lines[i].size() + note.size() + 2;
+            if (folded < total_size(lines, i, j)) {
+                out.push_back(std::move(lines[i]));
+                out.push_back(std::move(note));
+                i = j;
+                continue;
+            }
+        }
+
+        if (options.fold_similar) {
+            j = i + 1;
+            while (j < lines.size() and keys[j] == keys[i]) {
+                ++j;
+            }
+            if (j - i >= options.min_similar) {
+                auto note =
+                    std::format("[... {} similar lines ...]", j - i - 2);
+                auto const folded =
+                    lines[i].size() + note.size() + lines[j - 1].size() + 3;
+                if (folded < total_size(lines, i, j)) {
+                    out.push_back(std::move(lines[i]));
+                    out.push_back(std::move(note));
+                    out.push_back(std::move(lines[j - 1]));
+                    i = j;
+                    continue;
+                }
+            }
+        }
+
+        out.push_back(std::move(lines[i++]));
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+Result<CompactOptions>
+parse_compact_options(std::string_view spec)
+{
+    if (spec == "on" or spec == "true" or spec == "1") {
+        return CompactOptions{};
+    }
+
+    auto options = CompactOptions{
+        .strip_ansi = false,
+        .resolve_cr = false,
+        .fold_repeats = false,
+        .fold_similar = false,
+        .min_repeats = CompactOptions{}.min_repeats,
+        .min_similar = CompactOptions{}.min_similar};
+    if (spec == "off" or spec == "false" or spec == "0") {
+        return options;
+    }
+
+    while (not spec.empty()) {
+        auto const comma = spec.find(',');
+        auto const stage = spec.substr(0, comma);
+        spec = comma == npos ? std::string_view{} : spec.substr(comma + 1);
+
+        if (stage == "ansi") {
+            options.strip_ansi = true;
+        } else if (stage == "cr") {
+            options.resolve_cr = true;
+        } else if (stage == "repeats") {
+            options.fold_repeats = true;
+        } else if (stage == "similar") {
+            options.fold_similar = true;
+        } else {
+            return make_error(
+                "unknown stage '{}' (expected on, off, or a list of "
+                "ansi, cr, repeats, similar)",
+                stage);
+        }
+    }
+    return options;
+}
+
+std::size_t
+compact_output(std::string & text, CompactOptions const & options)
+{
+    auto const before = text.size();
+
+    if (options.strip_ansi and text.find('\x1B') != std::string::npos) {
+        text = strip_ansi(text);
+    }
+
+    if (not options.resolve_cr and not options.fold_repeats
+        and not options.fold_similar)
+    {
+        return before - text.size();
+    }
+
+    std::vector<std::string> lines;
+    std::string_view rest = text;
+    while (not rest.empty()) {
+        auto const nl = rest.find('\n');
+        auto const line = rest.substr(0, nl);
+        rest = nl == npos ? std::string_view{} : rest.substr(nl + 1);
+        lines.push_back(
+            options.resolve_cr and line.find_first_of("\r\b") != npos
+                ? resolve_overwrites(line)
+                : std::string(line));
+    }
+    auto const trailing_newline = not text.empty() and text.back() == '\n';
+
+    if (options.fold_repeats or options.fold_similar) {
+        lines = fold_runs(std::move(lines), options);
+    }
+
+    std::string out;
+    out.reserve(text.size());
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        if (i > 0) {
+            out += '\n';
+        }
+        out += lines[i];
+    }
+    if (trailing_newline) {
+        out += '\n';
+    }
+
+    text = std::move(out);
+    return before - std::min(before, text.size());
+}
+
+} // namespace wjh::chat::tools
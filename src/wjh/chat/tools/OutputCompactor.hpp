@@ -0,0 +1,57 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_3F8D21A6C4E74B9DA05C7E1B2D6F9A84
+#define WJH_CHAT_3F8D21A6C4E74B9DA05C7E1B2D6F9A84
+
+#include "wjh/chat/Result.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::tools {
+
+/**
+ * Which compaction stages to run on command output.
+ *
+ * Folding similar lines drops the lines between the first and last of
+ * a run, which cannot be read back, so it runs only when asked for.
+ */
+struct CompactOptions
+{
+    bool strip_ansi = true; ///< Remove terminal escape sequences.
+    bool resolve_cr = true; ///< Apply carriage-return/backspace overwrites.
+    bool fold_repeats = true; ///< Fold runs of identical lines.
+    bool fold_similar = false; ///< Fold runs differing only in numbers.
+    std::size_t min_repeats = 3; ///< Shortest identical run folded.
+    std::size_t min_similar = 5; ///< Shortest similar run folded.
+};
+
+/**
+ * Parse TOOL_COMPACT: "off" disables everything, "on" enables the
+ * default stages (all but similar), and a comma-separated list (ansi,
+ * cr, repeats, similar) enables just those stages.
+ */
+[[nodiscard]]
+Result<CompactOptions> parse_compact_options(std::string_view spec);
+
+/**
+ * Compact command output in place for the model.
+ *
+ * What a terminal would show is kept: escape sequences are removed,
+ * progress lines redrawn with carriage returns collapse to their final
+ * state, a run of identical lines becomes one line plus a count, and,
+ * with fold_similar, a run of lines that differ only in their digits
+ * keeps its first and last line.
+ *
+ * @return Number of bytes removed.
+ */
+std::size_t compact_output(std::string & text, CompactOptions const & options);
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_3F8D21A6C4E74B9DA05C7E1B2D6F9A84
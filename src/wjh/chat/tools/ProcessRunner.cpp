@@ -0,0 +1,287 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/ProcessRunner.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <optional>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+// How long output is still read once the shell has exited.
+constexpr auto drain_grace = std::chrono::milliseconds{500};
+
+// Runs in the forked child: only async-signal-safe calls from here on.
+[[noreturn]] void
+exec_child(char const * command, int out_fd, ResourceLimits const & limits)
+{
+    setpgid(0, 0);
+
+    if (auto const devnull = open("/dev/null", O_RDONLY); devnull >= 0) {
+        dup2(devnull, STDIN_FILENO);
+        close(devnull);
+    }
+    dup2(out_fd, STDOUT_FILENO);
+    dup2(out_fd, STDERR_FILENO);
+
+    // The hard CPU limit sits one second above the soft one, so a
+    // process that ignores SIGXCPU is killed shortly after.
+    if (limits.cpu_time) {
+        auto const secs = static_cast<rlim_t>(limits.cpu_time->count());
+        rlimit const rl{secs, secs + 1};
+        setrlimit(RLIMIT_CPU, &rl);
+    }
+    if (limits.address_space) {
+        auto const bytes = static_cast<rlim_t>(*limits.address_space);
+        rlimit const rl{bytes, bytes};
+        setrlimit(RLIMIT_AS, &rl);
+    }
+    if (limits.open_files) {
+        auto const files = static_cast<rlim_t>(*limits.open_files);
+        rlimit const rl{files, files};
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+
+    execl("/bin/sh", "sh", "-c", command, static_cast<char *>(nullptr));
+    _exit(127);
+}
+
+bool
+mentions(std::string const & output, std::string_view text)
+{
+    return output.find(text) != std::string::npos;
+}
+
+// Attribute a failed run to an rlimit, from what the kernel reports:
+// SIGXCPU or the child's CPU time.
+LimitHit
+classify_failure(
+    ProcessResult const & result,
+    std::chrono::microseconds cpu_used,
+    ResourceLimits const & limits)
+{
+    auto const status = json_value(result.exit_status);
+    if (status == 0) {
+        return LimitHit::none;
+    }
+    if (limits.cpu_time
+        and (status == 128 + SIGXCPU or cpu_used >= *limits.cpu_time))
+    {
+        return LimitHit::cpu_time;
+    }
+    return LimitHit::none;
+}
+
+// The kernel does not say which limit made an allocation or open()
+// fail, so a memory or file limit can only be guessed at from the
+// messages such failures typically produce.
+LimitHit
+suspect_limit(ProcessResult const & result, ResourceLimits const & limits)
+{
+    if (json_value(result.exit_status) == 0) {
+        return LimitHit::none;
+    }
+    if (limits.address_space
+        and (mentions(result.output, "Cannot allocate memory")
+             or mentions(result.output, "bad_alloc")
+             or mentions(result.output, "out of memory")
+             or mentions(result.output, "MemoryError")))
+    {
+        return LimitHit::address_space;
+    }
+    if (limits.open_files
+        and mentions(result.output, "Too many open files"))
+    {
+        return LimitHit::open_files;
+    }
+    return LimitHit::none;
+}
+
+std::chrono::microseconds
+cpu_time_of(rusage const & usage)
+{
+    auto const to_us = [](timeval const & tv) {
+        return std::chrono::seconds{tv.tv_sec}
+            + std::chrono::microseconds{tv.tv_usec};
+    };
+    return to_us(usage.ru_utime) + to_us(usage.ru_stime);
+}
+
+} // anonymous namespace
+
+Result<ProcessResult>
+run_process(ShellCommand const & command, ResourceLimits const & limits)
+{
+    using clock = std::chrono::steady_clock;
+
+    std::array<int, 2> fds{};
+    if (pipe2(fds.data(), O_CLOEXEC) != 0) {
+        return make_error("failed to execute command");
+    }
+
+    auto const & cmd = json_value(command);
+    auto const pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return make_error("failed to execute command");
+    }
+    if (pid == 0) {
+        exec_child(cmd.c_str(), fds[1], limits);
+    }
+
+    // Also set the group from the parent so killpg cannot race the
+    // child's own setpgid.
+    setpgid(pid, pid);
+    close(fds[1]);
+
+    auto const kill_group = [pid] { killpg(pid, SIGKILL); };
+    auto const deadline = limits.wall_time
+        ? std::optional{clock::now() + *limits.wall_time}
+        : std::nullopt;
+
+    ProcessResult result;
+    int status = 0;
+    rusage usage{};
+    bool exited = false;
+    std::array<char, 4096> buffer;
+
+    // Set once the shell is reaped: anything still holding the pipe
+    // then left the process group, so it is not waited for long.
+    auto drain_until = std::optional<clock::time_point>{};
+
+    for (;;) {
+        // Wake up periodically until the shell exits so that
+        // background children it leaves behind can be reaped.
+        auto timeout = 100;
+        if (drain_until) {
+            auto const left = std::chrono::ceil<std::chrono::milliseconds>(
+                *drain_until - clock::now());
+            if (left.count() <= 0) {
+                break;
+            }
+            timeout = static_cast<int>(left.count());
+        }
+        if (deadline) {
+            auto const remaining =
+                std::chrono::ceil<std::chrono::milliseconds>(
+                    *deadline - clock::now());
+            if (remaining.count() <= 0) {
+                kill_group();
+                result.limit_hit = LimitHit::wall_time;
+                break;
+            }
+            auto const ms = static_cast<int>(
+                std::min<std::chrono::milliseconds::rep>(
+                    remaining.count(),
+                    60'000));
+            timeout = std::min(timeout, ms);
+        }
+
+        pollfd pfd{.fd = fds[0], .events = POLLIN, .revents = 0};
+        auto const ready = poll(&pfd, 1, timeout);
+        if (ready < 0 and errno != EINTR) {
+            kill_group();
+            break;
+        }
+
+        if (ready > 0) {
+            auto const n = read(fds[0], buffer.data(), buffer.size());
+            if (n < 0 and errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            auto const size = static_cast<std::size_t>(n);
+            auto const room = limits.max_output_bytes - result.output.size();
+            if (size > room) {
+                result.output.append(buffer.data(), room);
+                result.limit_hit = LimitHit::output;
+                kill_group();
+                break;
+            }
+            result.output.append(buffer.data(), size);
+        }
+
+        if (not exited and wait4(pid, &status, WNOHANG, &usage) == pid) {
+            exited = true;
+            // Anything still in the group would hold the pipe open.
+            kill_group();
+            drain_until = clock::now() + drain_grace;
+        }
+    }
+    close(fds[0]);
+
+    // The shell can outlive its end of the pipe (`exec >/dev/null`),
+    // so the deadline still applies while waiting for it.
+    auto pause = std::chrono::milliseconds{1};
+    while (not exited) {
+        auto const waited = wait4(pid, &status, WNOHANG, &usage);
+        if (waited == pid) {
+            exited = true;
+            break;
+        }
+        if (waited < 0 and errno != EINTR) {
+            return make_error("failed to wait for command");
+        }
+        if (deadline and clock::now() >= *deadline
+            and result.limit_hit != LimitHit::wall_time)
+        {
+            kill_group();
+            result.limit_hit = LimitHit::wall_time;
+        }
+        std::this_thread::sleep_for(pause);
+        pause = std::min(pause * 2, std::chrono::milliseconds{50});
+    }
+    kill_group();
+
+    if (WIFSIGNALED(status)) {
+        result.exit_status = ExitStatus{128 + WTERMSIG(status)};
+    } else {
+        result.exit_status = ExitStatus{WEXITSTATUS(status)};
+    }
+    if (result.limit_hit == LimitHit::none) {
+        result.limit_hit =
+            classify_failure(result, cpu_time_of(usage), limits);
+    }
+    if (result.limit_hit == LimitHit::none) {
+        result.possible_limit = suspect_limit(result, limits);
+    }
+    return result;
+}
+
+std::string
+shell_quote(std::string_view word)
+{
+    std::string result = "'";
+    for (auto c : word) {
+        if (c == '\'') {
+            result += "'\\''";
+        } else {
+            result += c;
+        }
+    }
+    result += '\'';
+    return result;
+}
+
+} // namespace wjh::chat::tools
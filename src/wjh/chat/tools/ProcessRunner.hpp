@@ -0,0 +1,61 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_A60D079A30FD40EBB5568BE2435E29DD
+#define WJH_CHAT_A60D079A30FD40EBB5568BE2435E29DD
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/tools/ResourceLimits.hpp"
+#include "wjh/chat/tools/types.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::tools {
+
+/**
+ * Captured result of running a child process.
+ */
+struct ProcessResult
+{
+    std::string output; ///< Combined stdout and stderr.
+    ExitStatus exit_status{0};
+    LimitHit limit_hit = LimitHit::none; ///< Limit that ended the run.
+
+    /**
+     * A memory or open-file limit the output of a failed run suggests
+     * was reached.  The kernel does not confirm it: the output may
+     * just mention, say, std::bad_alloc.
+     */
+    LimitHit possible_limit = LimitHit::none;
+};
+
+/**
+ * Run a command through /bin/sh, capturing stdout and stderr.
+ *
+ * The child runs in its own process group with stdin on /dev/null and
+ * the rlimits from limits applied.  If the wall time or output cap is
+ * exceeded the whole group is killed; once the shell exits, anything
+ * it left running in the group is killed too, and output from a child
+ * that left the group is read for at most half a second more.
+ *
+ * @return The captured output, exit status, and the limit that fired,
+ *         or an error if the process could not be started.
+ */
+[[nodiscard]]
+Result<ProcessResult> run_process(
+    ShellCommand const & command,
+    ResourceLimits const & limits = {});
+
+/**
+ * Quote a string so /bin/sh treats it as a single literal word.
+ */
+[[nodiscard]]
+std::string shell_quote(std::string_view word);
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_A60D079A30FD40EBB5568BE2435E29DD
@@ -0,0 +1,70 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/ReadTracker.hpp"
+
+#include <format>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+constexpr std::string_view reply_prefix = "[Re-read of ";
+
+} // anonymous namespace
+
+ReadTracker::
+ReadTracker(std::size_t max_base_bytes)
+: max_base_bytes_(max_base_bytes)
+{ }
+
+std::optional<std::string>
+ReadTracker::
+reread(FileRead const & read)
+{
+    if (max_base_bytes_ != 0 and read.full_size > max_base_bytes_) {
+        delivered_.erase(read.key);
+        return std::nullopt;
+    }
+
+    auto const base = delivered_.find(read.key);
+    if (base == delivered_.end()) {
+        delivered_.emplace(read.key, read.lines);
+        return std::nullopt;
+    }
+
+    auto options = DiffOptions{};
+    options.first_line = read.first_line;
+    auto const diff = unified_diff(base->second, read.lines, options);
+    if (diff and diff->empty()) {
+        return std::format(
+            "{}{}: unchanged since it was last shown in full.]",
+            reply_prefix,
+            read.display_path);
+    }
+
+    auto reply = diff
+        ? std::format(
+              "{}{}: changed since it was last shown in full. Unified "
+              "diff against that copy:]\n{}",
+              reply_prefix,
+              read.display_path,
+              *diff)
+        : std::string{};
+    if (reply.empty() or 2 * reply.size() >= read.full_size) {
+        base->second = read.lines;
+        return std::nullopt;
+    }
+    return reply;
+}
+
+bool
+is_reread_reply(std::string_view result)
+{
+    return result.starts_with(reply_prefix);
+}
+
+} // namespace wjh::chat::tools
@@ -0,0 +1,76 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_0B7E4C29D81F4A65B3C9E27A5D1F8C46
+#define WJH_CHAT_0B7E4C29D81F4A65B3C9E27A5D1F8C46
+
+#include "wjh/chat/tools/LineDiff.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+/**
+ * Lines returned by one read_file call.
+ */
+struct FileRead
+{
+    std::string key; ///< Identifies the file and range read.
+    std::string display_path;
+    std::size_t first_line = 1;
+    std::vector<std::string> lines{};
+    std::size_t full_size = 0; ///< Bytes of the full formatted result.
+};
+
+/**
+ * Remembers the last version of each file range sent in full, so a
+ * re-read of a slightly changed file can be answered with a diff.
+ *
+ * Diffs are always taken against the last full copy, never against an
+ * earlier diff, so each reply stands on its own next to that copy.
+ * A tracker must live no longer than the message history it describes.
+ */
+class ReadTracker
+{
+public:
+    /**
+     * @param max_base_bytes Results larger than this are not sent in
+     * full (they are spilled), so they cannot serve as a base; 0 means
+     * no limit.
+     */
+    explicit ReadTracker(std::size_t max_base_bytes = 0);
+
+    /**
+     * Text to send instead of the full result, or std::nullopt to send
+     * the full result, which then becomes the new base.
+     *
+     * A diff is used only when it is less than half the size of the
+     * full result.
+     */
+    [[nodiscard]]
+    std::optional<std::string> reread(FileRead const & read);
+
+private:
+    std::size_t max_base_bytes_;
+    std::map<std::string, std::vector<std::string>, std::less<>> delivered_;
+};
+
+/**
+ * Whether a tool result is a ReadTracker reply, which only makes sense
+ * next to the full copy it refers to.
+ */
+[[nodiscard]]
+bool is_reread_reply(std::string_view result);
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_0B7E4C29D81F4A65B3C9E27A5D1F8C46
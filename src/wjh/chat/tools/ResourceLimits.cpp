@@ -0,0 +1,301 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/ResourceLimits.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <limits>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr auto npos = std::string_view::npos;
+
+std::string_view
+trim(std::string_view s)
+{
+    auto const first = s.find_first_not_of(" \t\r\n");
+    if (first == npos) {
+        return {};
+    }
+    auto const last = s.find_last_not_of(" \t\r\n");
+    return s.substr(first, last - first + 1);
+}
+
+std::string
+format_duration(std::chrono::milliseconds d)
+{
+    auto const ms = d.count();
+    if (ms > 0 and ms % 3'600'000 == 0) {
+        return std::format("{}h", ms / 3'600'000);
+    }
+    if (ms > 0 and ms % 60'000 == 0) {
+        return std::format("{}m", ms / 60'000);
+    }
+    if (ms % 1000 == 0) {
+        return std::format("{}s", ms / 1000);
+    }
+    return std::format("{}ms", ms);
+}
+
+std::string
+format_bytes(std::size_t n)
+{
+    constexpr std::size_t k = 1024;
+    if (n > 0 and n % (k * k * k) == 0) {
+        return std::format("{}GB", n / (k * k * k));
+    }
+    if (n > 0 and n % (k * k) == 0) {
+        return std::format("{}MB", n / (k * k));
+    }
+    if (n > 0 and n % k == 0) {
+        return std::format("{}KB", n / k);
+    }
+    return std::format("{} bytes", n);
+}
+
+// Splits a value such as "10m" or "2G" into its number and suffix.
+std::optional<std::pair<std::uint64_t, std::string_view>>
+split_number(std::string_view value)
+{
+    std::uint64_t n = 0;
+    auto const [ptr, ec] =
+        std::from_chars(value.data(), value.data() + value.size(), n);
+    if (ec != std::errc{} or ptr == value.data()) {
+        return std::nullopt;
+    }
+    return std::pair{
+        n,
+        value.substr(static_cast<std::size_t>(ptr - value.data()))};
+}
+
+std::optional<std::chrono::milliseconds>
+parse_duration(std::string_view value)
+{
+    auto const parsed = split_number(value);
+    if (not parsed) {
+        return std::nullopt;
+    }
+    auto const [n, suffix] = *parsed;
+    auto const count = static_cast<std::chrono::milliseconds::rep>(n);
+    if (suffix.empty() or suffix == "s") {
+        return std::chrono::seconds{count};
+    }
+    if (suffix == "m") {
+        return std::chrono::minutes{count};
+    }
+    if (suffix == "h") {
+        return std::chrono::hours{count};
+    }
+    if (suffix == "ms") {
+        return std::chrono::milliseconds{count};
+    }
+    return std::nullopt;
+}
+
+std::optional<std::size_t>
+parse_size(std::string_view value)
+{
+    auto const parsed = split_number(value);
+    if (not parsed) {
+        return std::nullopt;
+    }
+    auto [n, suffix] = *parsed;
+    if (suffix.ends_with('B') or suffix.ends_with('b')) {
+        suffix.remove_suffix(1);
+    }
+    auto multiplier = std::uint64_t{1};
+    if (suffix == "K" or suffix == "k") {
+        multiplier = std::uint64_t{1} << 10;
+    } else if (suffix == "M" or suffix == "m") {
+        multiplier = std::uint64_t{1} << 20;
+    } else if (suffix == "G" or suffix == "g") {
+        multiplier = std::uint64_t{1} << 30;
+    } else if (not suffix.empty()) {
+        return std::nullopt;
+    }
+    if (n > std::numeric_limits<std::size_t>::max() / multiplier) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(n * multiplier);
+}
+
+// Applies one key=value setting; false if the key or value is invalid.
+bool
+apply_setting(
+    ResourceLimits & limits,
+    std::string_view key,
+    std::string_view value)
+{
+    auto const none = value == "none";
+
+    if (key == "wall" or key == "cpu") {
+        auto const d = parse_duration(value);
+        if (not d and not none) {
+            return false;
+        }
+        if (key == "wall") {
+            limits.wall_time = d;
+        } else if (none) {
+            limits.cpu_time.reset();
+        } else {
+            // RLIMIT_CPU has one-second granularity.
+            limits.cpu_time =
+                std::max(std::chrono::ceil<std::chrono::seconds>(*d), 1s);
+        }
+        return true;
+    }
+
+    auto const n = parse_size(value);
+    if (not n and not none) {
+        return false;
+    }
+    if (key == "mem") {
+        limits.address_space = n;
+    } else if (key == "files") {
+        limits.open_files = n;
+    } else if (key == "output") {
+        limits.max_output_bytes =
+            n.value_or(std::numeric_limits<std::size_t>::max());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+std::string
+describe_limit(LimitHit hit, ResourceLimits const & limits)
+{
+    switch (hit) {
+    case LimitHit::none:
+        return {};
+    case LimitHit::cpu_time:
+        return std::format(
+            "[limit: CPU time of {} exceeded; process killed]",
+            format_duration(limits.cpu_time.value_or(0s)));
+    case LimitHit::address_space:
+        return std::format(
+            "[limit: memory limit of {} reached]",
+            format_bytes(limits.address_space.value_or(0)));
+    case LimitHit::open_files:
+        return std::format(
+            "[limit: open file limit of {} reached]",
+            limits.open_files.value_or(0));
+    case LimitHit::wall_time:
+        return std::format(
+            "[limit: wall time of {} exceeded; process group killed]",
+            format_duration(limits.wall_time.value_or(0ms)));
+    case LimitHit::output:
+        return std::format(
+            "[limit: output truncated at {}; process group killed]",
+            format_bytes(limits.max_output_bytes));
+    }
+    return {};
+}
+
+std::string
+describe_possible_limit(LimitHit hit, ResourceLimits const & limits)
+{
+    if (hit == LimitHit::address_space) {
+        return std::format(
+            "[limit: the memory limit of {} may have been reached]",
+            format_bytes(limits.address_space.value_or(0)));
+    }
+    if (hit == LimitHit::open_files) {
+        return std::format(
+            "[limit: the open file limit of {} may have been reached]",
+            limits.open_files.value_or(0));
+    }
+    return describe_limit(hit, limits);
+}
+
+ToolLimits
+default_tool_limits()
+{
+    return ToolLimits{
+        {"bash",
+         ResourceLimits{
+             .cpu_time = std::nullopt,
+             .address_space = std::nullopt,
+             .open_files = std::nullopt,
+             .wall_time = 10min,
+             .max_output_bytes = 16 * 1024 * 1024}},
+        {"build",
+         ResourceLimits{
+             .cpu_time = std::nullopt,
+             .address_space = std::nullopt,
+             .open_files = std::nullopt,
+             .wall_time = 1h,
+             .max_output_bytes = 64 * 1024 * 1024}}};
+}
+
+Result<ToolLimits>
+parse_tool_limits(std::string_view spec, ToolLimits base)
+{
+    while (not spec.empty()) {
+        auto const end = spec.find(';');
+        auto const entry = trim(spec.substr(0, end));
+        spec = end == npos ? std::string_view{} : spec.substr(end + 1);
+        if (entry.empty()) {
+            continue;
+        }
+
+        auto const colon = entry.find(':');
+        auto const tool = trim(entry.substr(0, colon));
+        if (colon == npos or tool.empty()) {
+            return make_error(
+                "expected '<tool>: key=value ...' in '{}'",
+                entry);
+        }
+
+        auto it = base.find(tool);
+        if (it == base.end()) {
+            it = base.emplace(std::string(tool), ResourceLimits{}).first;
+        }
+
+        auto settings = trim(entry.substr(colon + 1));
+        while (not settings.empty()) {
+            auto const space = settings.find_first_of(" \t");
+            auto const setting = settings.substr(0, space);
+            settings = space == npos
+                ? std::string_view{}
+                : trim(settings.substr(space));
+
+            auto const eq = setting.find('=');
+            if (eq == npos
+                or not apply_setting(
+                    it->second,
+                    setting.substr(0, eq),
+                    setting.substr(eq + 1)))
+            {
+                return make_error(
+                    "invalid setting '{}' for {} "
+                    "(expected cpu, wall, mem, files, or output)",
+                    setting,
+                    tool);
+            }
+        }
+    }
+
+    return base;
+}
+
+ResourceLimits
+limits_for(ToolLimits const & limits, std::string_view tool)
+{
+    auto const it = limits.find(tool);
+    return it == limits.end() ? ResourceLimits{} : it->second;
+}
+
+} // namespace wjh::chat::tools
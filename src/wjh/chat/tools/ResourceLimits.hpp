@@ -0,0 +1,104 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_7C3A95E12B6D4F08A1E4D92B5C0F7A36
+#define WJH_CHAT_7C3A95E12B6D4F08A1E4D92B5C0F7A36
+
+#include "wjh/chat/Result.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::tools {
+
+/**
+ * Limits applied to one child process and everything it spawns.
+ *
+ * CPU time, address space, and open files are set with setrlimit in
+ * the child, so they bind each process of the group individually.
+ * Wall time and output are enforced by the runner, which kills the
+ * whole process group when either is exceeded.  Unset limits are not
+ * applied.
+ */
+struct ResourceLimits
+{
+    std::optional<std::chrono::seconds> cpu_time{}; ///< RLIMIT_CPU.
+    std::optional<std::size_t> address_space{}; ///< RLIMIT_AS, bytes.
+    std::optional<std::size_t> open_files{}; ///< RLIMIT_NOFILE.
+    std::optional<std::chrono::milliseconds> wall_time{};
+    std::size_t max_output_bytes = std::numeric_limits<std::size_t>::max();
+};
+
+/**
+ * The limit that ended a process early, if any.
+ */
+enum class LimitHit
+{
+    none,
+    cpu_time,
+    address_space,
+    open_files,
+    wall_time,
+    output
+};
+
+/**
+ * One-line explanation of a fired limit for the tool result, e.g.
+ * "[limit: wall time of 10m exceeded; process group killed]".
+ *
+ * @return Empty for LimitHit::none.
+ */
+[[nodiscard]]
+std::string describe_limit(LimitHit hit, ResourceLimits const & limits);
+
+/**
+ * Like describe_limit, but for a limit that may have been reached,
+ * e.g. "[limit: the memory limit of 512MB may have been reached]".
+ */
+[[nodiscard]]
+std::string describe_possible_limit(
+    LimitHit hit,
+    ResourceLimits const & limits);
+
+/**
+ * Limits keyed by tool name.
+ */
+using ToolLimits = std::map<std::string, ResourceLimits, std::less<>>;
+
+/**
+ * Built-in limits: bash gets 10 minutes and 16MB of output (large
+ * results are spilled to the blob store), build gets an hour and 64MB
+ * (the full log is kept on disk).
+ */
+[[nodiscard]]
+ToolLimits default_tool_limits();
+
+/**
+ * Parse per-tool overrides and apply them on top of base.
+ *
+ * The format is `<tool>: <key>=<value> ...` with entries separated by
+ * semicolons, e.g. `bash: wall=2m cpu=60 mem=2G files=256 output=1M`.
+ * Times take an s, m, or h suffix (default seconds), sizes a K, M, or
+ * G suffix (default bytes), and "none" removes a limit.
+ */
+[[nodiscard]]
+Result<ToolLimits> parse_tool_limits(std::string_view spec, ToolLimits base);
+
+/**
+ * Limits for a tool, or no limits if the tool has no entry.
+ */
+[[nodiscard]]
+ResourceLimits limits_for(ToolLimits const & limits, std::string_view tool);
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_7C3A95E12B6D4F08A1E4D92B5C0F7A36
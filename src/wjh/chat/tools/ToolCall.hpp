@@ -0,0 +1,27 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_5B0E7C2D91F34A6C8E1D4B7A9F2C6E03
+#define WJH_CHAT_5B0E7C2D91F34A6C8E1D4B7A9F2C6E03
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+
+namespace wjh::chat::tools {
+
+/**
+ * One tool invocation requested by the model.
+ */
+struct ToolCall
+{
+    std::string name;
+    nlohmann::json arguments; ///< Parsed "arguments" JSON object.
+};
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_5B0E7C2D91F34A6C8E1D4B7A9F2C6E03
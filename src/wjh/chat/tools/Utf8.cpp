@@ -0,0 +1,217 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/Utf8.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace wjh::chat::tools {
+
+namespace {
+
+constexpr std::string_view replacement = "\xEF\xBF\xBD";
+
+std::uint8_t
+byte_at(std::string_view text, std::size_t i)
+{
+    return static_cast<std::uint8_t>(text[i]);
+}
+
+// Returns the offset of the first byte at or after pos that the
+// scalar code must look at: any non-ASCII byte, plus (when
+// stop_at_control) any byte below 0x20 or DEL.
+std::size_t
+skip_ascii(std::string_view text, std::size_t pos, bool stop_at_control)
+{
+    auto const * data = text.data();
+    auto const size = text.size();
+
+#if defined(__SSE2__)
+    auto const space = _mm_set1_epi8(0x20);
+    auto const del = _mm_set1_epi8(0x7F);
+    for (; pos + 16 <= size; pos += 16) {
+        auto const chunk =
+            _mm_loadu_si128(static_cast<__m128i const *>(
+                static_cast<void const *>(data + pos)));
+        // Signed compare: bytes >= 0x80 are negative, so one test
+        // catches both non-ASCII and control characters.
+        auto const special = stop_at_control
+            ? _mm_or_si128(
+                  _mm_cmplt_epi8(chunk, space),
+                  _mm_cmpeq_epi8(chunk, del))
+            : chunk;
+        if (_mm_movemask_epi8(special) != 0) {
+            break;
+        }
+    }
+#else
+    constexpr auto high = std::uint64_t{0x8080808080808080};
+    constexpr auto ones = std::uint64_t{0x0101010101010101};
+    for (; pos + 8 <= size; pos += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data + pos, sizeof word);
+        auto special = word & high;
+        if (stop_at_control) {
+            // Bytes below 0x20, and bytes equal to 0x7F.
+            special |= (word - ones * 0x20) & ~word & high;
+            auto const x = word ^ (ones * 0x7F);
+            special |= (x - ones) & ~x & high;
+        }
+        if (special != 0) {
+            break;
+        }
+    }
+#endif
+
+    while (pos < size) {
+        auto const b = byte_at(text, pos);
+        if (b >= 0x80 or (stop_at_control and (b < 0x20 or b == 0x7F))) {
+            break;
+        }
+        ++pos;
+    }
+    return pos;
+}
+
+struct Sequence
+{
+    std::size_t length; ///< Bytes consumed.
+    bool valid; ///< Well-formed; otherwise a maximal ill-formed part.
+};
+
+// Decode the multi-byte sequence starting at text[i] (a byte >= 0x80)
+// using the well-formed ranges of Unicode Table 3-7.
+Sequence
+decode(std::string_view text, std::size_t i)
+{
+    auto const lead = byte_at(text, i);
+
+    std::size_t need = 0;
+    std::uint8_t lo = 0x80;
+    std::uint8_t hi = 0xBF;
+    if (lead >= 0xC2 and lead <= 0xDF) {
+        need = 1;
+    } else if (lead >= 0xE0 and lead <= 0xEF) {
+        need = 2;
+        if (lead == 0xE0) {
+            lo = 0xA0;
+        } else if (lead == 0xED) {
+            hi = 0x9F;
+        }
+    } else if (lead >= 0xF0 and lead <= 0xF4) {
+        need = 3;
+        if (lead == 0xF0) {
+            lo = 0x90;
+        } else if (lead == 0xF4) {
+            hi = 0x8F;
+        }
+    } else {
+        return Sequence{.length = 1, .valid = false};
+    }
+
+    for (std::size_t k = 1; k <= need; ++k) {
+        if (i + k >= text.size()) {
+            return Sequence{.length = k, .valid = false};
+        }
+        auto const b = byte_at(text, i + k);
+        if (b < lo or b > hi) {
+            return Sequence{.length = k, .valid = false};
+        }
+        lo = 0x80;
+        hi = 0xBF;
+    }
+    return Sequence{.length = need + 1, .valid = true};
+}
+
+bool
+is_control(std::string_view text, std::size_t i, Sequence seq)
+{
+    auto const b = byte_at(text, i);
+    if (b < 0x80) {
+        return (b < 0x20 and b != '\t' and b != '\n' and b != '\r')
+            or b == 0x7F;
+    }
+    // U+0080..U+009F are encoded as C2 80..C2 9F.
+    return seq.valid and seq.length == 2 and b == 0xC2
+        and byte_at(text, i + 1) <= 0x9F;
+}
+
+} // anonymous namespace
+
+bool
+is_valid_utf8(std::string_view text)
+{
+    std::size_t i = 0;
+    while ((i = skip_ascii(text, i, false)) < text.size()) {
+        auto const seq = decode(text, i);
+        if (not seq.valid) {
+            return false;
+        }
+        i += seq.length;
+    }
+    return true;
+}
+
+Utf8Repair
+sanitize_utf8(std::string & text, Utf8Options options)
+{
+    Utf8Repair repair;
+    std::string_view const in = text;
+
+    // Find the first byte that has to change; most output has none.
+    std::size_t i = 0;
+    for (;;) {
+        i = skip_ascii(in, i, options.strip_control);
+        if (i == in.size()) {
+            return repair;
+        }
+        auto const seq = byte_at(in, i) < 0x80
+            ? Sequence{.length = 1, .valid = true}
+            : decode(in, i);
+        if (not seq.valid
+            or (options.strip_control and is_control(in, i, seq)))
+        {
+            break;
+        }
+        i += seq.length;
+    }
+
+    std::string out;
+    out.reserve(in.size() + in.size() / 8);
+    out.append(in.substr(0, i));
+
+    while (i < in.size()) {
+        auto const next = skip_ascii(in, i, options.strip_control);
+        out.append(in.substr(i, next - i));
+        i = next;
+        if (i == in.size()) {
+            break;
+        }
+
+        auto const seq = byte_at(in, i) < 0x80
+            ? Sequence{.length = 1, .valid = true}
+            : decode(in, i);
+        if (not seq.valid) {
+            out.append(replacement);
+            ++repair.replaced;
+        } else if (options.strip_control and is_control(in, i, seq)) {
+            ++repair.stripped;
+        } else {
+            out.append(in.substr(i, seq.length));
+        }
+        i += seq.length;
+    }
+
+    text = std::move(out);
+    return repair;
+}
+
+} // namespace wjh::chat::tools
@@ -0,0 +1,54 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_E19B4C7A02D54F3E8B6A1D0C95F2E4B8
+#define WJH_CHAT_E19B4C7A02D54F3E8B6A1D0C95F2E4B8
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::tools {
+
+/**
+ * Options for sanitize_utf8.
+ */
+struct Utf8Options
+{
+    /// Also drop C0/C1 control characters and DEL, keeping tab,
+    /// newline, and carriage return.
+    bool strip_control = false;
+};
+
+/**
+ * What sanitize_utf8 changed.
+ */
+struct Utf8Repair
+{
+    std::size_t replaced = 0; ///< Ill-formed sequences replaced.
+    std::size_t stripped = 0; ///< Control characters removed.
+};
+
+/**
+ * Whether text is well-formed UTF-8 (no overlongs, surrogates, or
+ * code points above U+10FFFF).
+ */
+[[nodiscard]]
+bool is_valid_utf8(std::string_view text);
+
+/**
+ * Make text safe to embed in a JSON request.
+ *
+ * Each maximal ill-formed subsequence is replaced by U+FFFD, as the
+ * Unicode standard recommends, so the result always serializes.  Runs
+ * of ASCII are skipped 16 bytes at a time, and text that needs no
+ * change is left untouched without copying.
+ */
+Utf8Repair sanitize_utf8(std::string & text, Utf8Options options = {});
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_E19B4C7A02D54F3E8B6A1D0C95F2E4B8
@@ -0,0 +1,12 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_4D5A555119BC41398563600A9DD0D993
+#define WJH_CHAT_4D5A555119BC41398563600A9DD0D993
+
+#include "types_gen.hpp"
+
+#endif // WJH_CHAT_4D5A555119BC41398563600A9DD0D993
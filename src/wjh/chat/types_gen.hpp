@@ -1,5 +1,5 @@
-#ifndef WJH_CHAT_E081316532FC94BF490341FD08BC0474961D2AF6
-#define WJH_CHAT_E081316532FC94BF490341FD08BC0474961D2AF6
+#ifndef WJH_CHAT_08DE412E7297DE66B9F88A0299D6A32FDD1DD8DC
+#define WJH_CHAT_08DE412E7297DE66B9F88A0299D6A32FDD1DD8DC
 
 // ======================================================================
 // NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE
@@ -3135,4 +3135,505 @@ public:
 } // namespace chat
 } // namespace wjh
 
-#endif // WJH_CHAT_E081316532FC94BF490341FD08BC0474961D2AF6
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: CachedTokens
+ * - description: std::uint32_t; +, <=>
+ * - default_value: "0u"
+ */
+class CachedTokens
+: private atlas::strong_type_tag<CachedTokens>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit CachedTokens() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit CachedTokens(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(CachedTokens const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(CachedTokens & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(CachedTokens && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+    /**
+     * Apply + assignment to the wrapped objects.
+     */
+    friend constexpr CachedTokens & operator += (
+        CachedTokens & lhs,
+        CachedTokens const & rhs)
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunevaluated-expression"
+#endif
+    noexcept(noexcept(std::declval<std::uint32_t &>() += std::declval<std::uint32_t const &>()))
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+    {
+        lhs.value += rhs.value;
+        return lhs;
+    }
+    /**
+     * Apply the binary operator + to the wrapped object.
+     */
+    friend constexpr CachedTokens operator + (
+        CachedTokens lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(lhs += rhs))
+    {
+        lhs += rhs;
+        return lhs;
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        CachedTokens const &,
+        CachedTokens const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        CachedTokens const &,
+        CachedTokens const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: CacheWriteTokens
+ * - description: std::uint32_t; +, <=>
+ * - default_value: "0u"
+ */
+class CacheWriteTokens
+: private atlas::strong_type_tag<CacheWriteTokens>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit CacheWriteTokens() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit CacheWriteTokens(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(CacheWriteTokens const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(CacheWriteTokens & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(CacheWriteTokens && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+    /**
+     * Apply + assignment to the wrapped objects.
+     */
+    friend constexpr CacheWriteTokens & operator += (
+        CacheWriteTokens & lhs,
+        CacheWriteTokens const & rhs)
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunevaluated-expression"
+#endif
+    noexcept(noexcept(std::declval<std::uint32_t &>() += std::declval<std::uint32_t const &>()))
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+    {
+        lhs.value += rhs.value;
+        return lhs;
+    }
+    /**
+     * Apply the binary operator + to the wrapped object.
+     */
+    friend constexpr CacheWriteTokens operator + (
+        CacheWriteTokens lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(lhs += rhs))
+    {
+        lhs += rhs;
+        return lhs;
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        CacheWriteTokens const &,
+        CacheWriteTokens const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        CacheWriteTokens const &,
+        CacheWriteTokens const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ReplayedRequests
+ * - description: std::uint32_t; +, <=>
+ * - default_value: "0u"
+ */
+class ReplayedRequests
+: private atlas::strong_type_tag<ReplayedRequests>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit ReplayedRequests() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ReplayedRequests(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(ReplayedRequests const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(ReplayedRequests & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ReplayedRequests && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+    /**
+     * Apply + assignment to the wrapped objects.
+     */
+    friend constexpr ReplayedRequests & operator += (
+        ReplayedRequests & lhs,
+        ReplayedRequests const & rhs)
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunevaluated-expression"
+#endif
+    noexcept(noexcept(std::declval<std::uint32_t &>() += std::declval<std::uint32_t const &>()))
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+    {
+        lhs.value += rhs.value;
+        return lhs;
+    }
+    /**
+     * Apply the binary operator + to the wrapped object.
+     */
+    friend constexpr ReplayedRequests operator + (
+        ReplayedRequests lhs,
+        ReplayedRequests const & rhs)
+    noexcept(noexcept(lhs += rhs))
+    {
+        lhs += rhs;
+        return lhs;
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ReplayedRequests const &,
+        ReplayedRequests const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ReplayedRequests const & lhs,
+        ReplayedRequests const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ReplayedRequests const & lhs,
+        ReplayedRequests const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ReplayedRequests const & lhs,
+        ReplayedRequests const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ReplayedRequests const & lhs,
+        ReplayedRequests const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ReplayedRequests const &,
+        ReplayedRequests const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ReplayedRequests const & lhs,
+        ReplayedRequests const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ReplayedRequests const & lhs,
+        ReplayedRequests const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+#endif // WJH_CHAT_08DE412E7297DE66B9F88A0299D6A32FDD1DD8DC
@@ -0,0 +1,181 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "AllocationTracker.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Plain data, so it is usable from the first allocation of a thread to
+// the last.
+constinit thread_local testing::AllocationCounts thread_counts{};
+
+void *
+allocate(std::size_t size)
+{
+    ++thread_counts.allocations;
+    thread_counts.bytes += size;
+    for (;;) {
+        if (auto * p = std::malloc(size == 0 ? 1 : size)) {
+            return p;
+        }
+        auto const handler = std::get_new_handler();
+        if (not handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void *
+allocate(std::size_t size, std::align_val_t alignment)
+{
+    ++thread_counts.allocations;
+    thread_counts.bytes += size;
+    auto const align = static_cast<std::size_t>(alignment);
+    // aligned_alloc wants a whole number of alignments.
+    auto const rounded =
+        std::max((size + align - 1) / align, std::size_t{1}) * align;
+    for (;;) {
+        if (auto * p = std::aligned_alloc(align, rounded)) {
+            return p;
+        }
+        auto const handler = std::get_new_handler();
+        if (not handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void
+deallocate(void * p) noexcept
+{
+    if (p) {
+        ++thread_counts.deallocations;
+        std::free(p);
+    }
+}
+
+} // anonymous namespace
+
+void *
+operator new (std::size_t size)
+{
+    return allocate(size);
+}
+
+void *
+operator new[] (std::size_t size)
+{
+    return allocate(size);
+}
+
+void *
+operator new (std::size_t size, std::nothrow_t const &) noexcept
+{
+    try {
+        return allocate(size);
+    } catch (std::bad_alloc const &) {
+        return nullptr;
+    }
+}
+
+void *
+operator new[] (std::size_t size, std::nothrow_t const &) noexcept
+{
+    try {
+        return allocate(size);
+    } catch (std::bad_alloc const &) {
+        return nullptr;
+    }
+}
+
+void *
+operator new (std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, alignment);
+}
+
+void *
+operator new[] (std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, alignment);
+}
+
+void
+operator delete (void * p) noexcept
+{
+    deallocate(p);
+}
+
+void
+operator delete[] (void * p) noexcept
+{
+    deallocate(p);
+}
+
+void
+operator delete (void * p, std::size_t) noexcept
+{
+    deallocate(p);
+}
+
+void
+operator delete[] (void * p, std::size_t) noexcept
+{
+    deallocate(p);
+}
+
+void
+operator delete (void * p, std::align_val_t) noexcept
+{
+    deallocate(p);
+}
+
+void
+operator delete[] (void * p, std::align_val_t) noexcept
+{
+    deallocate(p);
+}
+
+void
+operator delete (void * p, std::size_t, std::align_val_t) noexcept
+{
+    deallocate(p);
+}
+
+void
+operator delete[] (void * p, std::size_t, std::align_val_t) noexcept
+{
+    deallocate(p);
+}
+
+namespace testing {
+
+AllocationCounts
+thread_allocations()
+{
+    return thread_counts;
+}
+
+AllocationScope::
+AllocationScope()
+: start_(thread_counts)
+{ }
+
+AllocationCounts
+AllocationScope::
+counts() const
+{
+    return thread_counts - start_;
+}
+
+} // namespace testing
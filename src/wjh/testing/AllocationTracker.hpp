@@ -0,0 +1,71 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_701926D62A7E4D1E80AE4D3F6B9EBA5E
+#define WJH_CHAT_701926D62A7E4D1E80AE4D3F6B9EBA5E
+
+#include <cstdint>
+
+namespace testing {
+
+/**
+ * Heap allocations made by one thread.
+ *
+ * Counted by replacements for the global operator new and delete that
+ * are defined alongside AllocationScope, in their own library
+ * (wjh::chat::testing::allocations).  Only the test runner and the
+ * benchmarks link it; every other program, including those that use
+ * the rest of the testing library, keeps the standard ones.
+ */
+struct AllocationCounts
+{
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0; ///< Requested, not including overhead.
+    std::uint64_t deallocations = 0;
+
+    friend AllocationCounts operator - (
+        AllocationCounts const & a,
+        AllocationCounts const & b)
+    {
+        return AllocationCounts{
+            .allocations = a.allocations - b.allocations,
+            .bytes = a.bytes - b.bytes,
+            .deallocations = a.deallocations - b.deallocations};
+    }
+};
+
+/**
+ * Everything the calling thread has allocated since it started.
+ */
+[[nodiscard]]
+AllocationCounts thread_allocations();
+
+/**
+ * Counts the calling thread's allocations from construction on.
+ *
+ * Scopes nest freely; each one reports everything since it started,
+ * including what inner scopes saw.  Allocations made by other threads
+ * (e.g., a background summary) are not counted.
+ *
+ *   AllocationScope scope;
+ *   auto body = prefix.build(prompt, false, messages);
+ *   CHECK(scope.counts().allocations <= 40);
+ */
+class AllocationScope
+{
+public:
+    AllocationScope();
+
+    [[nodiscard]]
+    AllocationCounts counts() const;
+
+private:
+    AllocationCounts start_;
+};
+
+} // namespace testing
+
+#endif // WJH_CHAT_701926D62A7E4D1E80AE4D3F6B9EBA5E
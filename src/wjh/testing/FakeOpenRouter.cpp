@@ -0,0 +1,378 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "FakeOpenRouter.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <optional>
+#include <span>
+
+using wjh::chat::make_error;
+using wjh::chat::Result;
+
+namespace testing {
+
+namespace {
+
+using nlohmann::json;
+
+std::vector<std::string_view>
+split(std::string_view text, char sep)
+{
+    std::vector<std::string_view> parts;
+    while (true) {
+        auto const at = text.find(sep);
+        parts.push_back(text.substr(0, at));
+        if (at == std::string_view::npos) {
+            return parts;
+        }
+        text.remove_prefix(at + 1);
+    }
+}
+
+std::optional<std::chrono::microseconds>
+parse_duration(std::string_view text)
+{
+    std::int64_t value = 0;
+    auto [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} or value < 0) {
+        return std::nullopt;
+    }
+    auto const unit = text.substr(
+        static_cast<std::size_t>(ptr - text.data()));
+    if (unit == "us") {
+        return std::chrono::microseconds{value};
+    }
+    if (unit == "ms") {
+        return std::chrono::milliseconds{value};
+    }
+    if (unit == "s") {
+        return std::chrono::seconds{value};
+    }
+    return std::nullopt;
+}
+
+std::size_t
+tokens_for(std::size_t bytes)
+{
+    return (bytes + 3) / 4;
+}
+
+// Text of the last user message, or an empty string.
+std::string
+last_user_text(json const & request)
+{
+    auto const messages = request.value("messages", json::array());
+    for (auto it = messages.rbegin(); it != messages.rend(); ++it) {
+        if (not it->is_object() or it->value("role", "") != "user") {
+            continue;
+        }
+        auto const content = it->value("content", json{});
+        if (content.is_string()) {
+            return content.get<std::string>();
+        }
+        std::string text;
+        for (auto const & part : content) {
+            if (part.is_object()) {
+                text += part.value("text", "");
+            }
+        }
+        return text;
+    }
+    return {};
+}
+
+// Words with their trailing space, as a stream delivers them.
+std::vector<std::string_view>
+words(std::string_view text)
+{
+    std::vector<std::string_view> out;
+    while (not text.empty()) {
+        auto const space = text.find(' ');
+        auto const n = space == std::string_view::npos
+            ? text.size()
+            : space + 1;
+        out.push_back(text.substr(0, n));
+        text.remove_prefix(n);
+    }
+    return out;
+}
+
+std::string
+event(json const & data)
+{
+    return "data: " + data.dump() + "\n\n";
+}
+
+FakeReply
+error_reply(FakeReply reply, int status, std::string_view message)
+{
+    reply.status = status;
+    if (status == 429) {
+        reply.headers.emplace_back("Retry-After", "1");
+    }
+    reply.chunks = {
+        json{{"error", {{"code", status}, {"message", message}}}}.dump()};
+    return reply;
+}
+
+} // anonymous namespace
+
+std::chrono::microseconds
+Latency::
+sample(std::mt19937_64 & rng) const
+{
+    switch (kind) {
+    case Kind::fixed:
+        break;
+    case Kind::uniform:
+        return std::chrono::microseconds{
+            std::uniform_int_distribution<std::int64_t>(
+                first.count(), second.count())(rng)};
+    case Kind::normal: {
+        auto const value = std::normal_distribution<double>(
+            static_cast<double>(first.count()),
+            static_cast<double>(second.count()))(rng);
+        return std::chrono::microseconds{
+            static_cast<std::int64_t>(std::max(value, 0.0))};
+    }
+    }
+    return first;
+}
+
+Result<Latency>
+parse_latency(std::string_view spec)
+{
+    auto const parts = split(spec, ':');
+    auto durations = std::vector<std::chrono::microseconds>{};
+    for (auto const part : std::span(parts).subspan(parts.size() == 1 ? 0 : 1))
+    {
+        auto const duration = parse_duration(part);
+        if (not duration) {
+            return make_error("'{}' is not a duration (e.g. 200ms)", part);
+        }
+        durations.push_back(*duration);
+    }
+
+    if (parts.size() == 1 or (parts[0] == "fixed" and parts.size() == 2)) {
+        return Latency{.kind = Latency::Kind::fixed, .first = durations[0]};
+    }
+    if (parts.size() == 3 and parts[0] == "uniform"
+        and durations[0] <= durations[1])
+    {
+        return Latency{
+            .kind = Latency::Kind::uniform,
+            .first = durations[0],
+            .second = durations[1]};
+    }
+    if (parts.size() == 3 and parts[0] == "normal") {
+        return Latency{
+            .kind = Latency::Kind::normal,
+            .first = durations[0],
+            .second = durations[1]};
+    }
+    return make_error(
+        "'{}' (expected <d>, uniform:<min>:<max>, or normal:<mean>:<sd>)",
+        spec);
+}
+
+Result<std::vector<Fault>>
+parse_faults(std::string_view spec)
+{
+    std::vector<Fault> faults;
+    double total = 0.0;
+    for (auto const item : split(spec, ',')) {
+        auto const colon = item.find(':');
+        auto fault = Fault{};
+        auto const status = item.substr(0, colon);
+        auto const probability = colon == std::string_view::npos
+            ? std::string_view{}
+            : item.substr(colon + 1);
+        auto [sp, sec] = std::from_chars(
+            status.data(), status.data() + status.size(), fault.status);
+        auto [pp, pec] = std::from_chars(
+            probability.data(),
+            probability.data() + probability.size(),
+            fault.probability);
+        if (sec != std::errc{} or sp != status.data() + status.size()
+            or pec != std::errc{}
+            or pp != probability.data() + probability.size()
+            or fault.status < 400 or fault.status > 599
+            or fault.probability < 0.0 or fault.probability > 1.0)
+        {
+            return make_error("'{}' (expected <status>:<probability>)", item);
+        }
+        total += fault.probability;
+        faults.push_back(fault);
+    }
+    if (total > 1.0) {
+        return make_error("fault probabilities add up to {}", total);
+    }
+    return faults;
+}
+
+Result<std::vector<json>>
+parse_script(std::string_view text)
+{
+    std::vector<json> script;
+    std::size_t line_number = 0;
+    for (auto const line : split(text, '\n')) {
+        ++line_number;
+        if (line.find_first_not_of(" \t\r") == std::string_view::npos) {
+            continue;
+        }
+        auto entry = json::parse(line, nullptr, false);
+        auto const valid = [&entry] {
+            if (not entry.is_object()) {
+                return false;
+            }
+            if (entry.contains("status")) {
+                auto const & status = entry["status"];
+                return status.is_number_integer()
+                    and status.get<int>() >= 400
+                    and status.get<int>() <= 599;
+            }
+            if (entry.contains("tool_calls")) {
+                auto const & calls = entry["tool_calls"];
+                return calls.is_array() and not calls.empty()
+                    and std::ranges::all_of(calls, [](json const & call) {
+                            return call.is_object()
+                                and call.value("name", json{}).is_string();
+                        });
+            }
+            return entry.value("content", json{}).is_string();
+        };
+        if (not valid()) {
+            return make_error(
+                "line {}: expected content, tool_calls, or status",
+                line_number);
+        }
+        script.push_back(std::move(entry));
+    }
+    return script;
+}
+
+FakeOpenRouter::
+FakeOpenRouter(FakeOptions options)
+: options_(std::move(options))
+, rng_(options_.seed)
+{ }
+
+std::size_t
+FakeOpenRouter::
+requests() const
+{
+    std::lock_guard lock(mutex_);
+    return requests_;
+}
+
+FakeReply
+FakeOpenRouter::
+respond(std::string_view request_body)
+{
+    std::lock_guard lock(mutex_);
+    auto const n = requests_++;
+    auto reply = FakeReply{
+        .delay = options_.latency.sample(rng_),
+        .chunk_delay = options_.chunk_delay};
+
+    auto const request = json::parse(request_body, nullptr, false);
+    if (not request.is_object()) {
+        return error_reply(std::move(reply), 400, "Invalid JSON body");
+    }
+
+    auto roll = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+    for (auto const & fault : options_.faults) {
+        if (roll < fault.probability) {
+            return error_reply(std::move(reply), fault.status, "Injected");
+        }
+        roll -= fault.probability;
+    }
+
+    auto const entry = options_.script.empty()
+        ? json{{"content", "You said: " + last_user_text(request)}}
+        : options_.script[n % options_.script.size()];
+    if (entry.contains("status")) {
+        return error_reply(
+            std::move(reply),
+            entry["status"].get<int>(),
+            entry.value("error", "Scripted error"));
+    }
+
+    auto const content = entry.value("content", "");
+    auto tool_calls = json::array();
+    std::size_t completion_bytes = content.size();
+    for (auto const & call : entry.value("tool_calls", json::array())) {
+        auto const arguments =
+            call.value("arguments", json::object()).dump();
+        completion_bytes += arguments.size();
+        tool_calls.push_back(
+            {{"index", tool_calls.size()},
+             {"id", std::format("call_{}_{}", n, tool_calls.size())},
+             {"type", "function"},
+             {"function",
+              {{"name", call["name"]}, {"arguments", arguments}}}});
+    }
+
+    auto const prompt_tokens = tokens_for(request_body.size());
+    auto const completion_tokens = tokens_for(completion_bytes);
+    auto completion = json{
+        {"id", std::format("gen-fake-{}", n)},
+        {"model", request.value("model", "fake")},
+        {"created", 0},
+        {"usage",
+         {{"prompt_tokens", prompt_tokens},
+          {"completion_tokens", completion_tokens},
+          {"total_tokens", prompt_tokens + completion_tokens}}}};
+    auto const finish_reason = tool_calls.empty() ? "stop" : "tool_calls";
+
+    if (not request.value("stream", false)) {
+        auto message = json{
+            {"role", "assistant"},
+            {"content", content.empty() ? json(nullptr) : json(content)}};
+        if (not tool_calls.empty()) {
+            message["tool_calls"] = tool_calls;
+        }
+        completion["object"] = "chat.completion";
+        completion["choices"] = json::array(
+            {{{"index", 0},
+              {"message", std::move(message)},
+              {"finish_reason", finish_reason}}});
+        reply.chunks = {completion.dump()};
+        return reply;
+    }
+
+    reply.content_type = "text/event-stream";
+    auto const chunk = [&completion](json delta, json finish) {
+        auto data = completion;
+        data.erase("usage");
+        data["object"] = "chat.completion.chunk";
+        data["choices"] = json::array(
+            {{{"index", 0},
+              {"delta", std::move(delta)},
+              {"finish_reason", std::move(finish)}}});
+        return data;
+    };
+    reply.chunks.push_back(
+        event(chunk({{"role", "assistant"}, {"content", ""}}, nullptr)));
+    for (auto const word : words(content)) {
+        reply.chunks.push_back(event(chunk({{"content", word}}, nullptr)));
+    }
+    if (not tool_calls.empty()) {
+        reply.chunks.push_back(
+            event(chunk({{"tool_calls", tool_calls}}, nullptr)));
+    }
+    auto last = chunk(json::object(), finish_reason);
+    last["usage"] = completion["usage"];
+    reply.chunks.push_back(event(last));
+    reply.chunks.push_back("data: [DONE]\n\n");
+    return reply;
+}
+
+} // namespace testing
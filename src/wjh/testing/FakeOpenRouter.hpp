@@ -0,0 +1,140 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_7A3F91C04E2B4D6F8B05C9E1D7A2F364
+#define WJH_CHAT_7A3F91C04E2B4D6F8B05C9E1D7A2F364
+
+#include "wjh/chat/Result.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace testing {
+
+/**
+ * Delay before a fake reply, drawn per request.
+ */
+struct Latency
+{
+    enum class Kind
+    {
+        fixed, ///< Always first.
+        uniform, ///< Between first and second.
+        normal ///< Mean first, standard deviation second; never negative.
+    };
+
+    Kind kind = Kind::fixed;
+    std::chrono::microseconds first{};
+    std::chrono::microseconds second{};
+
+    [[nodiscard]]
+    std::chrono::microseconds sample(std::mt19937_64 & rng) const;
+};
+
+/**
+ * Parse a latency: `200ms`, `uniform:50ms:300ms`, or
+ * `normal:200ms:50ms`.  Durations take `us`, `ms`, or `s`.
+ */
+[[nodiscard]]
+wjh::chat::Result<Latency> parse_latency(std::string_view spec);
+
+/**
+ * An error status returned instead of a reply with some probability.
+ */
+struct Fault
+{
+    int status = 500;
+    double probability = 0.0;
+};
+
+/**
+ * Parse faults: `429:0.05,503:0.01`.  Statuses are 400-599 and the
+ * probabilities add up to at most 1.
+ */
+[[nodiscard]]
+wjh::chat::Result<std::vector<Fault>> parse_faults(std::string_view spec);
+
+/**
+ * Parse a reply script: one JSON object per line, each one of
+ *
+ *   {"content": "text"}
+ *   {"tool_calls": [{"name": "read_file", "arguments": {...}}]}
+ *   {"status": 503, "error": "message"}
+ *
+ * Replies are served in order and the script repeats.
+ */
+[[nodiscard]]
+wjh::chat::Result<std::vector<nlohmann::json>> parse_script(
+    std::string_view text);
+
+struct FakeOptions
+{
+    std::vector<nlohmann::json> script{}; ///< Empty: echo the user.
+    Latency latency{};
+    std::chrono::microseconds chunk_delay{}; ///< Between stream events.
+    std::vector<Fault> faults{};
+    std::uint64_t seed = 1;
+};
+
+/**
+ * What the server sends for one request.
+ *
+ * A streamed reply is a series of server-sent events, one per chunk;
+ * otherwise there is a single chunk holding the whole body.
+ */
+struct FakeReply
+{
+    int status = 200;
+    std::string content_type = "application/json";
+    std::vector<std::pair<std::string, std::string>> headers{};
+    std::vector<std::string> chunks{};
+    std::chrono::microseconds delay{}; ///< Before the first chunk.
+    std::chrono::microseconds chunk_delay{}; ///< Before each later one.
+};
+
+/**
+ * Replies to `/api/v1/chat/completions` requests the way OpenRouter
+ * does, without a model behind them.
+ *
+ * Replies come from the script, or echo the last user message when
+ * there is none.  Usage counts four request bytes per prompt token and
+ * four reply bytes per completion token.  Requests with `"stream":
+ * true` get server-sent events that split the reply into words.
+ * Thread safe, so one instance can serve a multi-threaded server.
+ */
+class FakeOpenRouter
+{
+public:
+    explicit FakeOpenRouter(FakeOptions options);
+
+    [[nodiscard]]
+    FakeReply respond(std::string_view request_body);
+
+    /**
+     * Requests answered so far.
+     */
+    [[nodiscard]]
+    std::size_t requests() const;
+
+private:
+    FakeOptions options_;
+    mutable std::mutex mutex_;
+    std::mt19937_64 rng_;
+    std::size_t requests_ = 0;
+};
+
+} // namespace testing
+
+#endif // WJH_CHAT_7A3F91C04E2B4D6F8B05C9E1D7A2F364
@@ -16,6 +16,7 @@ MockClient::
 do_send_message(wjh::chat::conversation::Conversation const & conversation)
 {
     ++call_count_;
+    failed_timing_ = {};
 
     // Store a copy for inspection
     last_conversation_ =
@@ -28,6 +29,36 @@ do_send_message(wjh::chat::conversation::Conversation const & conversation)
 
     auto result = std::move(results_.front());
     results_.pop();
+    if (not result) {
+        failed_timing_ = std::move(error_timings_.front());
+        error_timings_.pop();
+    }
+    return result;
+}
+
+wjh::chat::TurnTiming
+MockClient::
+do_failed_timing() const
+{
+    return failed_timing_;
+}
+
+wjh::chat::Result<wjh::chat::AssistantResponse>
+MockClient::
+do_complete(
+    wjh::chat::conversation::Conversation const & conversation,
+    wjh::chat::ModelId const & model)
+{
+    last_completion_model_ = model;
+    last_completion_conversation_ =
+        std::make_unique<wjh::chat::conversation::Conversation>(conversation);
+
+    if (completions_.empty()) {
+        return wjh::chat::make_error("MockClient: No completion queued");
+    }
+
+    auto result = std::move(completions_.front());
+    completions_.pop();
     return result;
 }
 
@@ -9,6 +9,8 @@
 
 #include "wjh/chat/client/IClient.hpp"
 
+#include <memory>
+#include <optional>
 #include <queue>
 
 namespace testing {
@@ -50,8 +52,41 @@ public:
      * Queue an error result.
      */
     void queue_error(std::string error)
+    {
+        queue_error(std::move(error), wjh::chat::TurnTiming{});
+    }
+
+    /**
+     * Queue an error result, reporting what the failed turn spent.
+     */
+    void queue_error(std::string error, wjh::chat::TurnTiming timing)
     {
         results_.push(tl::make_unexpected(std::move(error)));
+        error_timings_.push(std::move(timing));
+    }
+
+    /**
+     * Queue the reply to a complete() call.
+     */
+    void queue_completion(wjh::chat::Result<wjh::chat::AssistantResponse> r)
+    {
+        completions_.push(std::move(r));
+    }
+
+    /**
+     * Get the model and conversation of the last complete() call.
+     */
+    [[nodiscard]]
+    std::optional<wjh::chat::ModelId> const & last_completion_model() const
+    {
+        return last_completion_model_;
+    }
+
+    [[nodiscard]]
+    wjh::chat::conversation::Conversation const *
+    last_completion_conversation() const
+    {
+        return last_completion_conversation_.get();
     }
 
     /**
@@ -76,9 +111,21 @@ private:
     wjh::chat::Result<wjh::chat::ChatResponse> do_send_message(
         wjh::chat::conversation::Conversation const & conversation) override;
 
+    wjh::chat::Result<wjh::chat::AssistantResponse> do_complete(
+        wjh::chat::conversation::Conversation const & conversation,
+        wjh::chat::ModelId const & model) override;
+
+    wjh::chat::TurnTiming do_failed_timing() const override;
+
     std::queue<wjh::chat::Result<wjh::chat::ChatResponse>> results_;
+    std::queue<wjh::chat::TurnTiming> error_timings_;
+    wjh::chat::TurnTiming failed_timing_{};
     std::unique_ptr<wjh::chat::conversation::Conversation> last_conversation_;
     std::size_t call_count_ = 0;
+    std::queue<wjh::chat::Result<wjh::chat::AssistantResponse>> completions_;
+    std::optional<wjh::chat::ModelId> last_completion_model_;
+    std::unique_ptr<wjh::chat::conversation::Conversation>
+        last_completion_conversation_;
 };
 
 } // namespace testing